@@ -1,3 +1,4 @@
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <optional>
@@ -9,6 +10,7 @@
 #include "binder/bound_table_ref.h"
 #include "binder/expressions/bound_column_ref.h"
 #include "binder/expressions/bound_constant.h"
+#include "binder/statement/copy_statement.h"
 #include "binder/statement/delete_statement.h"
 #include "binder/statement/insert_statement.h"
 #include "binder/statement/select_statement.h"
@@ -84,4 +86,66 @@ auto Binder::BindUpdate(duckdb_libpgquery::PGUpdateStmt *stmt) -> std::unique_pt
   return std::make_unique<UpdateStatement>(std::move(table), std::move(filter_expr), std::move(target_expr));
 }
 
+auto Binder::BindCopy(duckdb_libpgquery::PGCopyStmt *stmt) -> std::unique_ptr<CopyStatement> {
+  if (stmt->relation == nullptr || !stmt->is_from) {
+    throw NotImplementedException("copy only supports loading a table from a file");
+  }
+  if (stmt->is_program || stmt->filename == nullptr) {
+    throw NotImplementedException("copy only supports loading from a file");
+  }
+  if (stmt->attlist != nullptr) {
+    throw NotImplementedException("copy only supports all columns, don't specify columns");
+  }
+
+  auto table = BindBaseTableRef(stmt->relation->relname, std::nullopt);
+
+  if (StringUtil::StartsWith(table->table_, "__")) {
+    throw bustub::Exception(fmt::format("invalid table for copy: {}", table->table_));
+  }
+
+  char delimiter = ',';
+  bool header = false;
+  std::string null_string;
+  if (stmt->options != nullptr) {
+    for (auto node = stmt->options->head; node != nullptr; node = node->next) {
+      auto option = reinterpret_cast<duckdb_libpgquery::PGDefElem *>(node->data.ptr_value);
+      auto arg = reinterpret_cast<duckdb_libpgquery::PGValue *>(option->arg);
+      auto name = StringUtil::Lower(option->defname);
+      auto is_string = arg != nullptr && arg->type == duckdb_libpgquery::T_PGString;
+      if (name == "format") {
+        if (!is_string || StringUtil::Lower(arg->val.str) != "csv") {
+          throw NotImplementedException("copy only supports the csv format");
+        }
+      } else if (name == "delimiter") {
+        if (!is_string || strlen(arg->val.str) != 1 || arg->val.str[0] == '"' || arg->val.str[0] == '\n' ||
+            arg->val.str[0] == '\r') {
+          throw bustub::Exception("copy delimiter must be a single character other than a quote or a newline");
+        }
+        delimiter = arg->val.str[0];
+      } else if (name == "header") {
+        if (arg == nullptr) {
+          header = true;
+        } else if (arg->type == duckdb_libpgquery::T_PGInteger) {
+          header = arg->val.ival != 0;
+        } else if (is_string) {
+          auto value = StringUtil::Lower(arg->val.str);
+          if (value != "true" && value != "false") {
+            throw bustub::Exception(fmt::format("invalid value for copy header: {}", value));
+          }
+          header = value == "true";
+        }
+      } else if (name == "null") {
+        if (!is_string) {
+          throw bustub::Exception("copy null must be a string");
+        }
+        null_string = arg->val.str;
+      } else {
+        throw NotImplementedException(fmt::format("copy option {} is not supported", name));
+      }
+    }
+  }
+
+  return std::make_unique<CopyStatement>(std::move(table), stmt->filename, delimiter, header, std::move(null_string));
+}
+
 }  // namespace bustub
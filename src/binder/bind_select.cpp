@@ -2,6 +2,7 @@
 #include <iterator>
 #include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 #include "binder/binder.h"
 #include "binder/bound_expression.h"
@@ -517,13 +518,24 @@ auto Binder::BindFuncCall(duckdb_libpgquery::PGFuncCall *root) -> std::unique_pt
   std::vector<std::unique_ptr<BoundExpression>> children;
   if (root->args != nullptr) {
     for (auto node = root->args->head; node != nullptr; node = node->next) {
-      auto child_expr = BindExpression(static_cast<duckdb_libpgquery::PGNode *>(node->data.ptr_value));
+      auto *arg = static_cast<duckdb_libpgquery::PGNode *>(node->data.ptr_value);
+      // Float constants are not supported in general, as no type holds them exactly. The quantile of approx_quantile
+      // is the one place that takes a fraction, and it is bound as a DECIMAL.
+      if (function_name == "approx_quantile" && children.size() == 1 && arg->type == duckdb_libpgquery::T_PGAConst) {
+        const auto &val = reinterpret_cast<duckdb_libpgquery::PGAConst *>(arg)->val;
+        if (val.type == duckdb_libpgquery::T_PGFloat) {
+          children.push_back(std::make_unique<BoundConstant>(ValueFactory::GetDecimalValue(std::stod(val.val.str))));
+          continue;
+        }
+      }
+      auto child_expr = BindExpression(arg);
       children.push_back(std::move(child_expr));
     }
   }
 
   if (function_name == "min" || function_name == "max" || function_name == "first" || function_name == "last" ||
-      function_name == "sum" || function_name == "count") {
+      function_name == "sum" || function_name == "count" || function_name == "avg" ||
+      function_name == "approx_count_distinct" || function_name == "approx_quantile") {
     // Rewrite count(*) to count_star().
     if (function_name == "count" && children.empty()) {
       function_name = "count_star";
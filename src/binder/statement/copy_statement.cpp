@@ -0,0 +1,20 @@
+#include "binder/statement/copy_statement.h"
+#include "fmt/core.h"
+
+namespace bustub {
+
+CopyStatement::CopyStatement(std::unique_ptr<BoundBaseTableRef> table, std::string file_path, char delimiter,
+                             bool header, std::string null_string)
+    : BoundStatement(StatementType::COPY_STATEMENT),
+      table_(std::move(table)),
+      file_path_(std::move(file_path)),
+      delimiter_(delimiter),
+      header_(header),
+      null_string_(std::move(null_string)) {}
+
+auto CopyStatement::ToString() const -> std::string {
+  return fmt::format("BoundCopy {{ table={}, file_path={}, delimiter={}, header={}, null_string={} }}", *table_,
+                     file_path_, delimiter_, header_, null_string_);
+}
+
+}  // namespace bustub
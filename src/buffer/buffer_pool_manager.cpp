@@ -21,11 +21,6 @@ namespace bustub {
 BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager, size_t replacer_k,
                                      LogManager *log_manager)
     : pool_size_(pool_size), disk_manager_(disk_manager), log_manager_(log_manager) {
-  // TODO(students): remove this line after you have implemented the buffer pool manager
-  throw NotImplementedException(
-      "BufferPoolManager is not implemented yet. If you have finished implementing BPM, please remove the throw "
-      "exception line in `buffer_pool_manager.cpp`.");
-
   // we allocate a consecutive memory space for the buffer pool
   pages_ = new Page[pool_size_];
   replacer_ = std::make_unique<LRUKReplacer>(pool_size, replacer_k);
@@ -38,30 +33,138 @@ BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager
 
 BufferPoolManager::~BufferPoolManager() { delete[] pages_; }
 
-auto BufferPoolManager::NewPage(page_id_t *page_id) -> Page * { return nullptr; }
+auto BufferPoolManager::AcquireFrame(frame_id_t *frame_id) -> bool {
+  if (!free_list_.empty()) {
+    *frame_id = free_list_.front();
+    free_list_.pop_front();
+    return true;
+  }
+  if (!replacer_->Evict(frame_id)) {
+    return false;
+  }
+  auto &page = pages_[*frame_id];
+  if (page.is_dirty_) {
+    disk_manager_->WritePage(page.page_id_, page.GetData());
+  }
+  page_table_.erase(page.page_id_);
+  return true;
+}
+
+auto BufferPoolManager::NewPage(page_id_t *page_id) -> Page * {
+  std::scoped_lock lock(latch_);
+  frame_id_t frame_id;
+  if (!AcquireFrame(&frame_id)) {
+    return nullptr;
+  }
+  *page_id = AllocatePage();
+  auto &page = pages_[frame_id];
+  page.ResetMemory();
+  page.page_id_ = *page_id;
+  page.pin_count_ = 1;
+  page.is_dirty_ = false;
+  page_table_[*page_id] = frame_id;
+  replacer_->RecordAccess(frame_id);
+  replacer_->SetEvictable(frame_id, false);
+  return &page;
+}
 
 auto BufferPoolManager::FetchPage(page_id_t page_id, [[maybe_unused]] AccessType access_type) -> Page * {
-  return nullptr;
+  std::scoped_lock lock(latch_);
+  frame_id_t frame_id;
+  if (auto it = page_table_.find(page_id); it != page_table_.end()) {
+    frame_id = it->second;
+    pages_[frame_id].pin_count_++;
+  } else {
+    if (!AcquireFrame(&frame_id)) {
+      return nullptr;
+    }
+    auto &page = pages_[frame_id];
+    page.page_id_ = page_id;
+    page.pin_count_ = 1;
+    page.is_dirty_ = false;
+    disk_manager_->ReadPage(page_id, page.GetData());
+    page_table_[page_id] = frame_id;
+  }
+  replacer_->RecordAccess(frame_id, access_type);
+  replacer_->SetEvictable(frame_id, false);
+  return &pages_[frame_id];
 }
 
 auto BufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty, [[maybe_unused]] AccessType access_type) -> bool {
-  return false;
+  std::scoped_lock lock(latch_);
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end() || pages_[it->second].pin_count_ <= 0) {
+    return false;
+  }
+  auto &page = pages_[it->second];
+  page.is_dirty_ = page.is_dirty_ || is_dirty;
+  if (--page.pin_count_ == 0) {
+    replacer_->SetEvictable(it->second, true);
+  }
+  return true;
 }
 
-auto BufferPoolManager::FlushPage(page_id_t page_id) -> bool { return false; }
+auto BufferPoolManager::FlushPage(page_id_t page_id) -> bool {
+  std::scoped_lock lock(latch_);
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end()) {
+    return false;
+  }
+  auto &page = pages_[it->second];
+  disk_manager_->WritePage(page_id, page.GetData());
+  page.is_dirty_ = false;
+  return true;
+}
 
-void BufferPoolManager::FlushAllPages() {}
+void BufferPoolManager::FlushAllPages() {
+  std::scoped_lock lock(latch_);
+  for (const auto &[page_id, frame_id] : page_table_) {
+    disk_manager_->WritePage(page_id, pages_[frame_id].GetData());
+    pages_[frame_id].is_dirty_ = false;
+  }
+}
 
-auto BufferPoolManager::DeletePage(page_id_t page_id) -> bool { return false; }
+auto BufferPoolManager::DeletePage(page_id_t page_id) -> bool {
+  std::scoped_lock lock(latch_);
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end()) {
+    return true;
+  }
+  auto frame_id = it->second;
+  auto &page = pages_[frame_id];
+  if (page.pin_count_ > 0) {
+    return false;
+  }
+  page_table_.erase(it);
+  replacer_->Remove(frame_id);
+  free_list_.push_back(frame_id);
+  page.ResetMemory();
+  page.page_id_ = INVALID_PAGE_ID;
+  page.is_dirty_ = false;
+  DeallocatePage(page_id);
+  return true;
+}
 
 auto BufferPoolManager::AllocatePage() -> page_id_t { return next_page_id_++; }
 
-auto BufferPoolManager::FetchPageBasic(page_id_t page_id) -> BasicPageGuard { return {this, nullptr}; }
+auto BufferPoolManager::FetchPageBasic(page_id_t page_id) -> BasicPageGuard { return {this, FetchPage(page_id)}; }
 
-auto BufferPoolManager::FetchPageRead(page_id_t page_id) -> ReadPageGuard { return {this, nullptr}; }
+auto BufferPoolManager::FetchPageRead(page_id_t page_id) -> ReadPageGuard {
+  auto *page = FetchPage(page_id);
+  if (page != nullptr) {
+    page->RLatch();
+  }
+  return {this, page};
+}
 
-auto BufferPoolManager::FetchPageWrite(page_id_t page_id) -> WritePageGuard { return {this, nullptr}; }
+auto BufferPoolManager::FetchPageWrite(page_id_t page_id) -> WritePageGuard {
+  auto *page = FetchPage(page_id);
+  if (page != nullptr) {
+    page->WLatch();
+  }
+  return {this, page};
+}
 
-auto BufferPoolManager::NewPageGuarded(page_id_t *page_id) -> BasicPageGuard { return {this, nullptr}; }
+auto BufferPoolManager::NewPageGuarded(page_id_t *page_id) -> BasicPageGuard { return {this, NewPage(page_id)}; }
 
 }  // namespace bustub
@@ -17,14 +17,75 @@ namespace bustub {
 
 LRUKReplacer::LRUKReplacer(size_t num_frames, size_t k) : replacer_size_(num_frames), k_(k) {}
 
-auto LRUKReplacer::Evict(frame_id_t *frame_id) -> bool { return false; }
+auto LRUKReplacer::Evict(frame_id_t *frame_id) -> bool {
+  std::scoped_lock lock(latch_);
+  // The victim has the largest backward k-distance: a frame with fewer than k accesses (+inf) before any other, and
+  // otherwise the one whose k-th most recent access is the oldest. Ties between +inf frames go to the least recently
+  // first-accessed frame, which is also the front of its history.
+  LRUKNode *victim = nullptr;
+  for (auto &[fid, node] : node_store_) {
+    if (!node.is_evictable_) {
+      continue;
+    }
+    if (victim == nullptr) {
+      victim = &node;
+      continue;
+    }
+    bool node_inf = node.history_.size() < k_;
+    bool victim_inf = victim->history_.size() < k_;
+    if (node_inf != victim_inf ? node_inf : node.history_.front() < victim->history_.front()) {
+      victim = &node;
+    }
+  }
+  if (victim == nullptr) {
+    return false;
+  }
+  *frame_id = victim->fid_;
+  node_store_.erase(victim->fid_);
+  curr_size_--;
+  return true;
+}
 
-void LRUKReplacer::RecordAccess(frame_id_t frame_id, [[maybe_unused]] AccessType access_type) {}
+void LRUKReplacer::RecordAccess(frame_id_t frame_id, [[maybe_unused]] AccessType access_type) {
+  BUSTUB_ASSERT(frame_id >= 0 && static_cast<size_t>(frame_id) < replacer_size_, "invalid frame id");
+  std::scoped_lock lock(latch_);
+  auto &node = node_store_[frame_id];
+  node.fid_ = frame_id;
+  node.history_.push_back(current_timestamp_++);
+  if (node.history_.size() > k_) {
+    node.history_.pop_front();
+  }
+}
 
-void LRUKReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {}
+void LRUKReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {
+  BUSTUB_ASSERT(frame_id >= 0 && static_cast<size_t>(frame_id) < replacer_size_, "invalid frame id");
+  std::scoped_lock lock(latch_);
+  auto it = node_store_.find(frame_id);
+  if (it == node_store_.end() || it->second.is_evictable_ == set_evictable) {
+    return;
+  }
+  it->second.is_evictable_ = set_evictable;
+  if (set_evictable) {
+    curr_size_++;
+  } else {
+    curr_size_--;
+  }
+}
 
-void LRUKReplacer::Remove(frame_id_t frame_id) {}
+void LRUKReplacer::Remove(frame_id_t frame_id) {
+  std::scoped_lock lock(latch_);
+  auto it = node_store_.find(frame_id);
+  if (it == node_store_.end()) {
+    return;
+  }
+  BUSTUB_ASSERT(it->second.is_evictable_, "cannot remove a non-evictable frame");
+  node_store_.erase(it);
+  curr_size_--;
+}
 
-auto LRUKReplacer::Size() -> size_t { return 0; }
+auto LRUKReplacer::Size() -> size_t {
+  std::scoped_lock lock(latch_);
+  return curr_size_;
+}
 
 }  // namespace bustub
@@ -9,6 +9,7 @@
 #include "binder/binder.h"
 #include "binder/bound_expression.h"
 #include "binder/bound_statement.h"
+#include "binder/statement/copy_statement.h"
 #include "binder/statement/create_statement.h"
 #include "binder/statement/explain_statement.h"
 #include "binder/statement/index_statement.h"
@@ -23,6 +24,7 @@
 #include "common/util/string_util.h"
 #include "concurrency/lock_manager.h"
 #include "concurrency/transaction.h"
+#include "execution/bulk_loader.h"
 #include "execution/execution_engine.h"
 #include "execution/executor_context.h"
 #include "execution/executors/mock_scan_executor.h"
@@ -110,7 +112,7 @@ void BustubInstance::HandleExplainStatement(Transaction *txn, const ExplainState
   }
 
   // Print optimizer result.
-  bustub::Optimizer optimizer(*catalog_, IsForceStarterRule());
+  bustub::Optimizer optimizer(*catalog_, IsForceStarterRule(), GetQueryMemoryBudget());
   auto optimized_plan = optimizer.Optimize(planner.plan_);
 
   l.unlock();
@@ -136,4 +138,16 @@ void BustubInstance::HandleVariableSetStatement(Transaction *txn, const Variable
   session_variables_[stmt.variable_] = stmt.value_;
 }
 
+void BustubInstance::HandleCopyStatement(Transaction *txn, const CopyStatement &stmt, ResultWriter &writer) {
+  std::shared_lock<std::shared_mutex> l(catalog_lock_);
+  auto table_info = catalog_->GetTable(stmt.table_->table_);
+  auto indexes = catalog_->GetTableIndexes(stmt.table_->table_);
+  l.unlock();
+
+  BulkLoader loader{table_info, std::move(indexes), task_scheduler_,
+                    CsvFormat{stmt.delimiter_, stmt.header_, stmt.null_string_}};
+  auto num_rows = loader.Load(stmt.file_path_, txn);
+  WriteOneCell(fmt::format("{} rows copied", num_rows), writer);
+}
+
 }  // namespace bustub
@@ -0,0 +1,365 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregate_state.cpp
+//
+// Identification: src/execution/aggregate_state.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/aggregate_state.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <utility>
+
+#include "common/util/hash_util.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** @return the value as a double, for the aggregates that compute over numbers */
+auto ToDouble(const Value &value) -> double { return value.CastAs(TypeId::DECIMAL).GetAs<double>(); }
+
+/** @return the value serialized, -0.0 as 0.0, so that two values serialize to the same bytes iff they are equal */
+auto SerializeDistinctValue(const Value &value) -> std::string {
+  if (value.GetTypeId() == TypeId::DECIMAL && value.GetAs<double>() == 0) {
+    return SerializeDistinctValue(ValueFactory::GetDecimalValue(0));
+  }
+  size_t size = value.GetTypeId() == TypeId::VARCHAR ? sizeof(uint32_t) + value.GetLength()
+                                                     : Type::GetTypeSize(value.GetTypeId());
+  std::string bytes(size, '\0');
+  value.SerializeTo(bytes.data());
+  return bytes;
+}
+
+/**
+ * @return a hash of the value, the same for equal values. HashUtil::HashValue() collides too often to be used by a
+ * sketch, e.g. on small integers, so fixed-size values are mixed as a whole.
+ */
+auto HashDistinctValue(const Value &value) -> hash_t {
+  uint64_t raw;
+  switch (value.GetTypeId()) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      raw = static_cast<uint64_t>(value.GetAs<int8_t>());
+      break;
+    case TypeId::SMALLINT:
+      raw = static_cast<uint64_t>(value.GetAs<int16_t>());
+      break;
+    case TypeId::INTEGER:
+      raw = static_cast<uint64_t>(value.GetAs<int32_t>());
+      break;
+    case TypeId::DECIMAL: {
+      // -0.0 and 0.0 are the same value.
+      double decimal = value.GetAs<double>() == 0 ? 0 : value.GetAs<double>();
+      memcpy(&raw, &decimal, sizeof(double));
+      break;
+    }
+    case TypeId::VARCHAR:
+      raw = std::hash<std::string_view>{}(std::string_view{value.GetData(), value.GetLength()});
+      break;
+    default:
+      raw = value.GetAs<uint64_t>();
+      break;
+  }
+  return HashUtil::Mix(raw);
+}
+
+/** @return the arcsine scale function of the t-digest: a centroid spans at most one unit of it */
+auto TDigestScale(double quantile) -> double {
+  return TDigestState::COMPRESSION / (2 * M_PI) * std::asin(2 * quantile - 1);
+}
+
+/** @return the quantile of a value of the scale function */
+auto TDigestInverseScale(double k) -> double {
+  return (std::sin(std::min(k * 2 * M_PI / TDigestState::COMPRESSION, M_PI / 2)) + 1) / 2;
+}
+
+}  // namespace
+
+void AvgState::Combine(const Value &input) {
+  if (input.IsNull()) {
+    return;
+  }
+  sum_ += ToDouble(input);
+  count_++;
+}
+
+void AvgState::Merge(const AggregateState &other) {
+  const auto &avg = dynamic_cast<const AvgState &>(other);
+  sum_ += avg.sum_;
+  count_ += avg.count_;
+}
+
+void AvgState::MergeSerialized(const char *bytes, size_t length) {
+  BUSTUB_ASSERT(length == sizeof(double) + sizeof(int64_t), "corrupt AVG state");
+  double sum;
+  int64_t count;
+  memcpy(&sum, bytes, sizeof(double));
+  memcpy(&count, bytes + sizeof(double), sizeof(int64_t));
+  sum_ += sum;
+  count_ += count;
+}
+
+void AvgState::SerializeTo(size_t max_size, std::vector<std::string> *parts) const {
+  auto &bytes = parts->emplace_back(sizeof(double) + sizeof(int64_t), '\0');
+  memcpy(bytes.data(), &sum_, sizeof(double));
+  memcpy(bytes.data() + sizeof(double), &count_, sizeof(int64_t));
+}
+
+auto AvgState::Finalize() const -> Value {
+  if (count_ == 0) {
+    return ValueFactory::GetNullValueByType(TypeId::DECIMAL);
+  }
+  return ValueFactory::GetDecimalValue(sum_ / static_cast<double>(count_));
+}
+
+void CountDistinctState::Combine(const Value &input) {
+  if (input.IsNull()) {
+    return;
+  }
+  Insert(SerializeDistinctValue(input));
+}
+
+void CountDistinctState::Merge(const AggregateState &other) {
+  for (const auto &value : dynamic_cast<const CountDistinctState &>(other).values_) {
+    Insert(std::string{value});
+  }
+}
+
+void CountDistinctState::MergeSerialized(const char *bytes, size_t length) {
+  // A part is a sequence of values, each prefixed with its length.
+  size_t offset = 0;
+  while (offset < length) {
+    uint32_t size;
+    memcpy(&size, bytes + offset, sizeof(uint32_t));
+    offset += sizeof(uint32_t);
+    Insert(std::string{bytes + offset, size});
+    offset += size;
+  }
+}
+
+void CountDistinctState::SerializeTo(size_t max_size, std::vector<std::string> *parts) const {
+  // There is always a part, even if the set is empty, so that a spilled group has at least one record.
+  auto *part = &parts->emplace_back();
+  for (const auto &value : values_) {
+    auto size = static_cast<uint32_t>(value.size());
+    if (!part->empty() && part->size() + sizeof(uint32_t) + size > max_size) {
+      part = &parts->emplace_back();
+    }
+    part->append(reinterpret_cast<const char *>(&size), sizeof(uint32_t));
+    part->append(value);
+  }
+}
+
+auto CountDistinctState::Finalize() const -> Value {
+  return ValueFactory::GetIntegerValue(static_cast<int32_t>(values_.size()));
+}
+
+void CountDistinctState::Insert(std::string &&value) {
+  auto size = sizeof(std::string) + value.capacity() + 3 * sizeof(void *);
+  if (values_.insert(std::move(value)).second) {
+    memory_usage_ += size;
+  }
+}
+
+void HyperLogLogState::Combine(const Value &input) {
+  if (input.IsNull()) {
+    return;
+  }
+  auto hash = HashDistinctValue(input);
+  // The register is picked by the high bits of the hash, and the rank counted in the remaining ones.
+  auto idx = hash >> (64 - PRECISION);
+  auto rest = hash << PRECISION;
+  auto rank = static_cast<uint8_t>(rest == 0 ? 64 - PRECISION + 1 : __builtin_clzll(rest) + 1);
+  registers_[idx] = std::max(registers_[idx], rank);
+}
+
+void HyperLogLogState::Merge(const AggregateState &other) {
+  const auto &hll = dynamic_cast<const HyperLogLogState &>(other);
+  for (size_t i = 0; i < NUM_REGISTERS; i++) {
+    registers_[i] = std::max(registers_[i], hll.registers_[i]);
+  }
+}
+
+void HyperLogLogState::MergeSerialized(const char *bytes, size_t length) {
+  BUSTUB_ASSERT(length == NUM_REGISTERS, "corrupt HyperLogLog state");
+  for (size_t i = 0; i < NUM_REGISTERS; i++) {
+    registers_[i] = std::max(registers_[i], static_cast<uint8_t>(bytes[i]));
+  }
+}
+
+void HyperLogLogState::SerializeTo(size_t max_size, std::vector<std::string> *parts) const {
+  parts->emplace_back(reinterpret_cast<const char *>(registers_.data()), NUM_REGISTERS);
+}
+
+auto HyperLogLogState::Finalize() const -> Value {
+  auto num_registers = static_cast<double>(NUM_REGISTERS);
+  double inverse_sum = 0;
+  size_t empty_registers = 0;
+  for (auto rank : registers_) {
+    inverse_sum += std::ldexp(1.0, -rank);
+    empty_registers += rank == 0 ? 1 : 0;
+  }
+  double alpha = 0.7213 / (1 + 1.079 / num_registers);
+  double estimate = alpha * num_registers * num_registers / inverse_sum;
+  if (estimate <= 2.5 * num_registers && empty_registers != 0) {
+    // The raw estimate is biased for small cardinalities, which linear counting handles well.
+    estimate = num_registers * std::log(num_registers / static_cast<double>(empty_registers));
+  }
+  return ValueFactory::GetIntegerValue(static_cast<int32_t>(std::llround(estimate)));
+}
+
+void TDigestState::Combine(const Value &input) {
+  if (input.IsNull()) {
+    return;
+  }
+  auto value = ToDouble(input);
+  if (centroids_.empty() && buffer_.empty()) {
+    min_ = max_ = value;
+  } else {
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+  Add(Centroid{value, 1});
+}
+
+void TDigestState::Merge(const AggregateState &other) {
+  const auto &digest = dynamic_cast<const TDigestState &>(other);
+  if (digest.centroids_.empty() && digest.buffer_.empty()) {
+    return;
+  }
+  if (centroids_.empty() && buffer_.empty()) {
+    min_ = digest.min_;
+    max_ = digest.max_;
+  } else {
+    min_ = std::min(min_, digest.min_);
+    max_ = std::max(max_, digest.max_);
+  }
+  for (const auto &centroid : digest.centroids_) {
+    Add(centroid);
+  }
+  for (const auto &centroid : digest.buffer_) {
+    Add(centroid);
+  }
+}
+
+void TDigestState::MergeSerialized(const char *bytes, size_t length) {
+  // A part is the minimum and the maximum, followed by centroids. An empty digest is serialized as an empty part.
+  if (length == 0) {
+    return;
+  }
+  TDigestState part{quantile_};
+  memcpy(&part.min_, bytes, sizeof(double));
+  memcpy(&part.max_, bytes + sizeof(double), sizeof(double));
+  part.centroids_.resize((length - 2 * sizeof(double)) / sizeof(Centroid));
+  memcpy(part.centroids_.data(), bytes + 2 * sizeof(double), part.centroids_.size() * sizeof(Centroid));
+  Merge(part);
+}
+
+void TDigestState::SerializeTo(size_t max_size, std::vector<std::string> *parts) const {
+  auto centroids = MergeCentroids();
+  if (centroids.empty()) {
+    parts->emplace_back();
+    return;
+  }
+  const size_t header_size = 2 * sizeof(double);
+  size_t centroids_per_part = std::max<size_t>(1, (std::max(max_size, header_size) - header_size) / sizeof(Centroid));
+  for (size_t begin = 0; begin < centroids.size(); begin += centroids_per_part) {
+    auto count = std::min(centroids_per_part, centroids.size() - begin);
+    auto &part = parts->emplace_back(header_size + count * sizeof(Centroid), '\0');
+    memcpy(part.data(), &min_, sizeof(double));
+    memcpy(part.data() + sizeof(double), &max_, sizeof(double));
+    memcpy(part.data() + header_size, centroids.data() + begin, count * sizeof(Centroid));
+  }
+}
+
+auto TDigestState::Finalize() const -> Value {
+  auto centroids = MergeCentroids();
+  if (centroids.empty()) {
+    return ValueFactory::GetNullValueByType(TypeId::DECIMAL);
+  }
+  double total_weight = 0;
+  for (const auto &centroid : centroids) {
+    total_weight += centroid.weight_;
+  }
+  // Every centroid stands for values around its mean, which is reached half-way through its weight. Below the first
+  // mean and above the last one, values are interpolated from the minimum and to the maximum.
+  auto target = quantile_ * total_weight;
+  const auto &first = centroids.front();
+  const auto &last = centroids.back();
+  if (target <= first.weight_ / 2) {
+    return ValueFactory::GetDecimalValue(min_ + (first.mean_ - min_) * target / (first.weight_ / 2));
+  }
+  if (target >= total_weight - last.weight_ / 2) {
+    auto last_center = total_weight - last.weight_ / 2;
+    return ValueFactory::GetDecimalValue(last.mean_ + (max_ - last.mean_) * (target - last_center) / (last.weight_ / 2));
+  }
+  double weight_before = 0;
+  for (size_t i = 0; i + 1 < centroids.size(); i++) {
+    auto left_center = weight_before + centroids[i].weight_ / 2;
+    auto right_center = weight_before + centroids[i].weight_ + centroids[i + 1].weight_ / 2;
+    if (target < right_center) {
+      return ValueFactory::GetDecimalValue(centroids[i].mean_ + (centroids[i + 1].mean_ - centroids[i].mean_) *
+                                                                    (target - left_center) /
+                                                                    (right_center - left_center));
+    }
+    weight_before += centroids[i].weight_;
+  }
+  return ValueFactory::GetDecimalValue(last.mean_);
+}
+
+void TDigestState::Add(Centroid centroid) {
+  buffer_.push_back(centroid);
+  if (buffer_.size() >= BUFFER_SIZE) {
+    Compress();
+  }
+}
+
+void TDigestState::Compress() {
+  centroids_ = MergeCentroids();
+  buffer_.clear();
+}
+
+auto TDigestState::MergeCentroids() const -> std::vector<Centroid> {
+  std::vector<Centroid> all;
+  all.reserve(centroids_.size() + buffer_.size());
+  all.insert(all.end(), centroids_.begin(), centroids_.end());
+  all.insert(all.end(), buffer_.begin(), buffer_.end());
+  if (all.empty()) {
+    return all;
+  }
+  std::sort(all.begin(), all.end(), [](const Centroid &a, const Centroid &b) { return a.mean_ < b.mean_; });
+  double total_weight = 0;
+  for (const auto &centroid : all) {
+    total_weight += centroid.weight_;
+  }
+
+  // Merge neighbouring centroids as long as the merged centroid spans at most one unit of the scale function.
+  std::vector<Centroid> merged{all[0]};
+  double weight_before = 0;
+  double weight_limit = total_weight * TDigestInverseScale(TDigestScale(0) + 1);
+  for (size_t i = 1; i < all.size(); i++) {
+    auto &current = merged.back();
+    if (weight_before + current.weight_ + all[i].weight_ <= weight_limit) {
+      current.weight_ += all[i].weight_;
+      current.mean_ += (all[i].mean_ - current.mean_) * all[i].weight_ / current.weight_;
+    } else {
+      weight_before += current.weight_;
+      weight_limit = total_weight * TDigestInverseScale(TDigestScale(weight_before / total_weight) + 1);
+      merged.push_back(all[i]);
+    }
+  }
+  return merged;
+}
+
+}  // namespace bustub
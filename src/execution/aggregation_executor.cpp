@@ -1,29 +1,548 @@
-//===----------------------------------------------------------------------===//
-//
-//                         BusTub
-//
-// aggregation_executor.cpp
-//
-// Identification: src/execution/aggregation_executor.cpp
-//
-// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
-//
-//===----------------------------------------------------------------------===//
-#include <memory>
-#include <vector>
-
-#include "execution/executors/aggregation_executor.h"
-
-namespace bustub {
-
-AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
-                                         std::unique_ptr<AbstractExecutor> &&child)
-    : AbstractExecutor(exec_ctx) {}
-
-void AggregationExecutor::Init() {}
-
-auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
-
-auto AggregationExecutor::GetChildExecutor() const -> const AbstractExecutor * { return child_.get(); }
-
-}  // namespace bustub
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_executor.cpp
+//
+// Identification: src/execution/aggregation_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "execution/executors/aggregation_executor.h"
+#include "execution/task_scheduler.h"
+#include "storage/page/tmp_tuple_page.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+void SerializeAggregateKey(const std::vector<Value> &values, std::string *bytes) {
+  for (const auto &value : values) {
+    auto type = value.GetTypeId();
+    size_t size = Type::GetTypeSize(type);
+    if (type == TypeId::VARCHAR) {
+      size = sizeof(uint32_t) + (value.IsNull() ? 0 : value.GetLength());
+    }
+    auto offset = bytes->size();
+    bytes->resize(offset + 1 + size);
+    (*bytes)[offset] = static_cast<char>(type);
+    if (type == TypeId::DECIMAL && !value.IsNull() && value.GetAs<double>() == 0) {
+      // -0.0 and 0.0 compare equal, so they must be the same group.
+      ValueFactory::GetDecimalValue(0).SerializeTo(bytes->data() + offset + 1);
+      continue;
+    }
+    value.SerializeTo(bytes->data() + offset + 1);
+  }
+}
+
+auto DeserializeAggregateKey(const char *bytes, size_t length) -> std::vector<Value> {
+  std::vector<Value> values;
+  size_t offset = 0;
+  while (offset < length) {
+    auto type = static_cast<TypeId>(bytes[offset++]);
+    auto &value = values.emplace_back(Value::DeserializeFrom(bytes + offset, type));
+    if (type == TypeId::VARCHAR) {
+      offset += sizeof(uint32_t) + (value.IsNull() ? 0 : value.GetLength());
+    } else {
+      offset += Type::GetTypeSize(type);
+    }
+  }
+  return values;
+}
+
+auto SimpleAggregationHashTable::GenerateInitialAggregateValue() const -> AggregateValue {
+  AggregateValue value;
+  for (size_t i = 0; i < agg_types_.size(); i++) {
+    switch (agg_types_[i]) {
+      case AggregationType::CountStarAggregate:
+        // Count start starts at zero.
+        value.aggregates_.emplace_back(ValueFactory::GetIntegerValue(0));
+        break;
+      default:
+        // Others starts at null. The aggregates with a state keep a null value alongside it.
+        value.aggregates_.emplace_back(ValueFactory::GetNullValueByType(TypeId::INTEGER));
+        break;
+    }
+    if (has_states_) {
+      value.states_.emplace_back(MakeAggregateState(i));
+    }
+  }
+  return value;
+}
+
+auto SimpleAggregationHashTable::MakeAggregateState(size_t idx) const -> std::unique_ptr<AggregateState> {
+  switch (agg_types_[idx]) {
+    case AggregationType::AvgAggregate:
+      return std::make_unique<AvgState>();
+    case AggregationType::CountDistinctAggregate:
+      return std::make_unique<CountDistinctState>();
+    case AggregationType::ApproxCountDistinctAggregate:
+      return std::make_unique<HyperLogLogState>();
+    case AggregationType::ApproxQuantileAggregate:
+      return std::make_unique<TDigestState>(agg_args_[idx].CastAs(TypeId::DECIMAL).GetAs<double>());
+    default:
+      return nullptr;
+  }
+}
+
+auto SimpleAggregationHashTable::FinalizeAggregateValue(const AggregateValue &value) const -> std::vector<Value> {
+  if (!has_states_) {
+    return value.aggregates_;
+  }
+  std::vector<Value> results;
+  results.reserve(agg_types_.size());
+  for (size_t i = 0; i < agg_types_.size(); i++) {
+    results.push_back(value.states_[i] == nullptr ? value.aggregates_[i] : value.states_[i]->Finalize());
+  }
+  return results;
+}
+
+void SimpleAggregationHashTable::SerializeAggregateValue(const AggregateValue &value, size_t max_size,
+                                                         std::vector<std::string> *parts) const {
+  if (!has_states_) {
+    SerializeAggregateKey(value.aggregates_, &parts->emplace_back());
+    return;
+  }
+  // The values go to the first part. The space they leave is shared by the states: from the smallest one up, a state
+  // is kept whole if it fits in an even share of the space left, and the others are split evenly. Every part gets the
+  // initial value of the aggregates it does not hold a part of.
+  std::vector<Value> values;
+  std::vector<size_t> states;
+  for (size_t i = 0; i < agg_types_.size(); i++) {
+    if (value.states_[i] == nullptr) {
+      values.push_back(value.aggregates_[i]);
+    } else {
+      values.push_back(ValueFactory::GetVarcharValue("", 0, false));
+      states.push_back(i);
+    }
+  }
+  std::string values_bytes;
+  SerializeAggregateKey(values, &values_bytes);
+  auto space_left = max_size > values_bytes.size() ? max_size - values_bytes.size() : 0;
+
+  std::vector<std::vector<std::string>> state_parts(agg_types_.size());
+  for (auto i : states) {
+    value.states_[i]->SerializeTo(SIZE_MAX, &state_parts[i]);
+  }
+  std::sort(states.begin(), states.end(),
+            [&](size_t a, size_t b) { return state_parts[a][0].size() < state_parts[b][0].size(); });
+  size_t num_whole_states = 0;
+  for (; num_whole_states < states.size(); num_whole_states++) {
+    auto size = state_parts[states[num_whole_states]][0].size();
+    if (size > space_left / (states.size() - num_whole_states)) {
+      break;
+    }
+    space_left -= size;
+  }
+
+  auto initial_value = GenerateInitialAggregateValue();
+  std::vector<std::vector<std::string>> initial_state_parts(agg_types_.size());
+  size_t num_parts = 1;
+  for (size_t idx = 0; idx < states.size(); idx++) {
+    auto i = states[idx];
+    auto state_max_size = idx < num_whole_states ? SIZE_MAX : space_left / (states.size() - num_whole_states);
+    if (idx >= num_whole_states) {
+      state_parts[i].clear();
+      value.states_[i]->SerializeTo(state_max_size, &state_parts[i]);
+    }
+    initial_value.states_[i]->SerializeTo(state_max_size, &initial_state_parts[i]);
+    num_parts = std::max(num_parts, state_parts[i].size());
+  }
+  for (size_t part = 0; part < num_parts; part++) {
+    for (size_t i = 0; i < agg_types_.size(); i++) {
+      if (value.states_[i] == nullptr) {
+        values[i] = part == 0 ? value.aggregates_[i] : initial_value.aggregates_[i];
+        continue;
+      }
+      const auto &bytes = part < state_parts[i].size() ? state_parts[i][part] : initial_state_parts[i][0];
+      values[i] = ValueFactory::GetVarcharValue(bytes.data(), static_cast<uint32_t>(bytes.size()), false);
+    }
+    SerializeAggregateKey(values, &parts->emplace_back());
+  }
+}
+
+auto SimpleAggregationHashTable::DeserializeAggregateValue(const char *bytes, size_t length) const -> AggregateValue {
+  AggregateValue value{DeserializeAggregateKey(bytes, length)};
+  if (!has_states_) {
+    return value;
+  }
+  for (size_t i = 0; i < agg_types_.size(); i++) {
+    auto &state = value.states_.emplace_back(MakeAggregateState(i));
+    if (state != nullptr) {
+      state->MergeSerialized(value.aggregates_[i].GetData(), value.aggregates_[i].GetLength());
+      value.aggregates_[i] = ValueFactory::GetNullValueByType(TypeId::INTEGER);
+    }
+  }
+  return value;
+}
+
+void SimpleAggregationHashTable::CombineAggregateValues(AggregateValue *result, const AggregateValue &input) {
+  for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
+    auto &result_value = result->aggregates_[i];
+    const auto &input_value = input.aggregates_[i];
+    switch (agg_types_[i]) {
+      case AggregationType::CountStarAggregate:
+        result_value = result_value.Add(ValueFactory::GetIntegerValue(1));
+        break;
+      case AggregationType::CountAggregate:
+        if (!input_value.IsNull()) {
+          result_value = result_value.IsNull() ? ValueFactory::GetIntegerValue(1)
+                                               : result_value.Add(ValueFactory::GetIntegerValue(1));
+        }
+        break;
+      case AggregationType::SumAggregate:
+        if (!input_value.IsNull()) {
+          result_value = result_value.IsNull() ? input_value : result_value.Add(input_value);
+        }
+        break;
+      case AggregationType::MinAggregate:
+        if (!input_value.IsNull() &&
+            (result_value.IsNull() || input_value.CompareLessThan(result_value) == CmpBool::CmpTrue)) {
+          result_value = input_value;
+        }
+        break;
+      case AggregationType::MaxAggregate:
+        if (!input_value.IsNull() &&
+            (result_value.IsNull() || input_value.CompareGreaterThan(result_value) == CmpBool::CmpTrue)) {
+          result_value = input_value;
+        }
+        break;
+      case AggregationType::AvgAggregate:
+      case AggregationType::CountDistinctAggregate:
+      case AggregationType::ApproxCountDistinctAggregate:
+      case AggregationType::ApproxQuantileAggregate:
+        result->states_[i]->Combine(input_value);
+        break;
+    }
+  }
+}
+
+void SimpleAggregationHashTable::MergeAggregateValues(AggregateValue *result, const AggregateValue &partial) {
+  for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
+    auto &result_value = result->aggregates_[i];
+    const auto &partial_value = partial.aggregates_[i];
+    switch (agg_types_[i]) {
+      case AggregationType::CountStarAggregate:
+      case AggregationType::CountAggregate:
+      case AggregationType::SumAggregate:
+        // Counts and sums add up. A null partial count or sum did not see any non-null input.
+        if (!partial_value.IsNull()) {
+          result_value = result_value.IsNull() ? partial_value : result_value.Add(partial_value);
+        }
+        break;
+      case AggregationType::MinAggregate:
+      case AggregationType::MaxAggregate:
+        // The extremum of partial extrema.
+        if (!partial_value.IsNull() &&
+            (result_value.IsNull() ||
+             (agg_types_[i] == AggregationType::MinAggregate ? partial_value.CompareLessThan(result_value)
+                                                             : partial_value.CompareGreaterThan(result_value)) ==
+                 CmpBool::CmpTrue)) {
+          result_value = partial_value;
+        }
+        break;
+      case AggregationType::AvgAggregate:
+      case AggregationType::CountDistinctAggregate:
+      case AggregationType::ApproxCountDistinctAggregate:
+      case AggregationType::ApproxQuantileAggregate:
+        result->states_[i]->Merge(*partial.states_[i]);
+        break;
+    }
+  }
+}
+
+auto SimpleAggregationHashTable::FindOrInsert(std::string &&key, hash_t hash) -> AggregateValue * {
+  if ((groups_.size() + 1) * 2 > slots_.size()) {
+    Grow();
+  }
+  auto hash_tag = static_cast<uint32_t>(hash >> 32);
+  size_t mask = slots_.size() - 1;
+  for (size_t idx = hash & mask;; idx = (idx + 1) & mask) {
+    auto &slot = slots_[idx];
+    if (slot.group_ == 0) {
+      auto &group = groups_.emplace_back(Group{hash, std::move(key), GenerateInitialAggregateValue()});
+      memory_usage_ += sizeof(Group) + group.key_.capacity() + agg_types_.size() * sizeof(Value) +
+                       GetStateMemoryUsage(group.value_);
+      slot = Slot{hash_tag, static_cast<uint32_t>(groups_.size())};
+      return &group.value_;
+    }
+    if (slot.hash_tag_ == hash_tag) {
+      auto &group = groups_[slot.group_ - 1];
+      if (group.hash_ == hash && group.key_ == key) {
+        return &group.value_;
+      }
+    }
+  }
+}
+
+void SimpleAggregationHashTable::Grow() {
+  BUSTUB_ENSURE(groups_.size() < UINT32_MAX / 2, "too many groups in an aggregation hash table");
+  memory_usage_ -= slots_.size() * sizeof(Slot);
+  slots_.assign(std::max<size_t>(16, slots_.size() * 2), Slot{0, 0});
+  memory_usage_ += slots_.size() * sizeof(Slot);
+  size_t mask = slots_.size() - 1;
+  for (size_t i = 0; i < groups_.size(); i++) {
+    auto hash = groups_[i].hash_;
+    auto idx = hash & mask;
+    while (slots_[idx].group_ != 0) {
+      idx = (idx + 1) & mask;
+    }
+    slots_[idx] = Slot{static_cast<uint32_t>(hash >> 32), static_cast<uint32_t>(i + 1)};
+  }
+}
+
+AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
+                                         std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_(std::move(child)) {}
+
+void AggregationExecutor::Init() {
+  child_->Init();
+  partitions_.clear();
+  for (size_t i = 0; i < NUM_PARTITIONS; i++) {
+    partitions_.push_back(MakeTable());
+  }
+  local_tables_.clear();
+  spill_files_.clear();
+  pending_partitions_.clear();
+  output_partition_ = 0;
+  output_idx_ = 0;
+
+  std::vector<Tuple> chunk;
+  chunk.reserve(INPUT_CHUNK_SIZE);
+  TupleBatch batch;
+  bool empty_input = true;
+  while (child_->NextBatch(&batch)) {
+    empty_input = false;
+    for (size_t i = 0; i < batch.Size(); i++) {
+      chunk.push_back(std::move(batch.GetTuple(i)));
+    }
+    if (chunk.size() >= INPUT_CHUNK_SIZE) {
+      AggregateChunk(chunk);
+      chunk.clear();
+    }
+  }
+  AggregateChunk(chunk);
+  local_tables_.clear();
+  emit_empty_row_ = empty_input && plan_->GetGroupBys().empty();
+
+  if (!spill_files_.empty()) {
+    // Whatever is still in memory is spilled as well, and every partition is then merged from its spill file.
+    SpillTables();
+    for (auto &file : spill_files_) {
+      file->Finish();
+      pending_partitions_.push_back(SpilledPartition{std::move(file), 0});
+    }
+    spill_files_.clear();
+    output_partition_ = partitions_.size();
+  }
+}
+
+void AggregationExecutor::AggregateChunk(const std::vector<Tuple> &chunk) {
+  if (chunk.empty()) {
+    return;
+  }
+  auto *scheduler = exec_ctx_->GetTaskScheduler();
+  if (scheduler == nullptr || chunk.size() <= PREAGGREGATION_TASK_SIZE) {
+    AggregateTuples(chunk, 0, chunk.size(), &partitions_);
+  } else {
+    if (local_tables_.empty()) {
+      for (size_t slot = 0; slot < scheduler->GetSlotCount(); slot++) {
+        auto &tables = local_tables_.emplace_back();
+        for (size_t i = 0; i < NUM_PARTITIONS; i++) {
+          tables.push_back(MakeTable());
+        }
+      }
+    }
+    // Phase 1: every thread pre-aggregates its tasks into its own tables.
+    auto num_tasks = (chunk.size() + PREAGGREGATION_TASK_SIZE - 1) / PREAGGREGATION_TASK_SIZE;
+    scheduler->ParallelFor(num_tasks, [&](size_t task_idx, size_t slot) {
+      auto begin = task_idx * PREAGGREGATION_TASK_SIZE;
+      AggregateTuples(chunk, begin, std::min(chunk.size(), begin + PREAGGREGATION_TASK_SIZE), &local_tables_[slot]);
+    });
+    // Phase 2: every task merges the thread-local tables of one partition into the shared one.
+    scheduler->ParallelFor(NUM_PARTITIONS, [&](size_t partition_idx, size_t) {
+      auto &partition = partitions_[partition_idx];
+      for (auto &tables : local_tables_) {
+        auto &local = tables[partition_idx];
+        for (const auto &group : local.GetGroups()) {
+          partition.InsertMerge(std::string{group.key_}, group.hash_, group.value_);
+        }
+        local.Clear();
+      }
+    });
+  }
+
+  size_t memory_usage = 0;
+  for (const auto &partition : partitions_) {
+    memory_usage += partition.GetMemoryUsage();
+  }
+  if (memory_usage > exec_ctx_->GetMemoryBudget() && exec_ctx_->GetBufferPoolManager() != nullptr) {
+    SpillTables();
+  }
+}
+
+void AggregationExecutor::AggregateTuples(const std::vector<Tuple> &chunk, size_t begin, size_t end,
+                                          std::vector<SimpleAggregationHashTable> *tables) {
+  for (size_t i = begin; i < end; i++) {
+    std::string key;
+    SerializeAggregateKey(MakeAggregateKey(&chunk[i]).group_bys_, &key);
+    auto hash = HashAggregateKey(key);
+    (*tables)[PartitionOf(hash, 0)].InsertCombine(std::move(key), hash, MakeAggregateValue(&chunk[i]));
+  }
+}
+
+void AggregationExecutor::SpillTables() {
+  if (spill_files_.empty()) {
+    for (size_t i = 0; i < NUM_PARTITIONS; i++) {
+      spill_files_.push_back(std::make_unique<SpillFile>(exec_ctx_->GetBufferPoolManager()));
+    }
+  }
+  for (size_t i = 0; i < NUM_PARTITIONS; i++) {
+    for (const auto &group : partitions_[i].GetGroups()) {
+      SpillGroup(partitions_[i], group, spill_files_[i].get());
+    }
+    partitions_[i].Clear();
+  }
+}
+
+void AggregationExecutor::SpillGroup(const SimpleAggregationHashTable &table,
+                                     const SimpleAggregationHashTable::Group &group, SpillFile *file) const {
+  // A record is the hash, the length of the serialized key, the key and the serialized aggregates. It is stored in a
+  // tuple, whose serialized form is its length followed by its data. The aggregates are split so that a record fits in
+  // a temporary page when they allow it; a record that does not fit anyway, e.g. for a large key, goes to overflow
+  // pages of the spill file.
+  const size_t header_size = sizeof(uint32_t) + sizeof(hash_t) + sizeof(uint32_t);
+  const size_t max_aggregates_size = BUSTUB_PAGE_SIZE - TmpTuplePage::SIZE_TMP_TUPLE_PAGE_HEADER - header_size;
+  std::vector<std::string> parts;
+  table.SerializeAggregateValue(
+      group.value_, max_aggregates_size > group.key_.size() ? max_aggregates_size - group.key_.size() : 0, &parts);
+  for (const auto &part : parts) {
+    std::string bytes(header_size, '\0');
+    bytes += group.key_;
+    bytes += part;
+    auto record_size = static_cast<uint32_t>(bytes.size() - sizeof(uint32_t));
+    auto key_size = static_cast<uint32_t>(group.key_.size());
+    memcpy(bytes.data(), &record_size, sizeof(uint32_t));
+    memcpy(bytes.data() + sizeof(uint32_t), &group.hash_, sizeof(hash_t));
+    memcpy(bytes.data() + sizeof(uint32_t) + sizeof(hash_t), &key_size, sizeof(uint32_t));
+    Tuple record;
+    record.DeserializeFrom(bytes.data());
+    file->Append(record);
+  }
+}
+
+auto AggregationExecutor::LoadNextPartition() -> bool {
+  auto &table = partitions_[0];
+  while (!pending_partitions_.empty()) {
+    auto partition = std::move(pending_partitions_.back());
+    pending_partitions_.pop_back();
+    table.Clear();
+
+    auto reader = partition.file_->MakeReader();
+    std::vector<SpilledPartition> children;
+    Tuple record;
+    while (reader.Next(&record)) {
+      const char *data = record.GetData();
+      hash_t hash;
+      uint32_t key_size;
+      memcpy(&hash, data, sizeof(hash_t));
+      memcpy(&key_size, data + sizeof(hash_t), sizeof(uint32_t));
+
+      if (!children.empty()) {
+        children[PartitionOf(hash, children[0].level_)].file_->Append(record);
+        continue;
+      }
+      const char *key = data + sizeof(hash_t) + sizeof(uint32_t);
+      size_t aggregates_size = record.GetLength() - sizeof(hash_t) - sizeof(uint32_t) - key_size;
+      table.InsertMerge(std::string{key, key_size}, hash, table.DeserializeAggregateValue(key + key_size, aggregates_size));
+
+      if (table.GetMemoryUsage() > exec_ctx_->GetMemoryBudget() && partition.level_ < MAX_SPILL_LEVEL) {
+        // Still too large: split the partition on the next bits of the hash, and merge the parts later.
+        auto level = partition.level_ + 1;
+        for (size_t i = 0; i < NUM_PARTITIONS; i++) {
+          children.push_back(
+              SpilledPartition{std::make_unique<SpillFile>(exec_ctx_->GetBufferPoolManager()), level});
+        }
+        for (const auto &group : table.GetGroups()) {
+          SpillGroup(table, group, children[PartitionOf(group.hash_, level)].file_.get());
+        }
+        table.Clear();
+      }
+    }
+    if (children.empty()) {
+      return true;
+    }
+    for (auto &child : children) {
+      child.file_->Finish();
+      pending_partitions_.push_back(std::move(child));
+    }
+  }
+  return false;
+}
+
+auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (emit_empty_row_) {
+    emit_empty_row_ = false;
+    auto table = MakeTable();
+    *tuple = Tuple{table.FinalizeAggregateValue(table.GenerateInitialAggregateValue()), &GetOutputSchema()};
+    return true;
+  }
+  if (!SeekNextGroup()) {
+    return false;
+  }
+  *tuple = MakeOutputTuple(partitions_[output_partition_].GetGroups()[output_idx_++]);
+  *rid = RID{};
+  return true;
+}
+
+auto AggregationExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Clear();
+  if (emit_empty_row_) {
+    emit_empty_row_ = false;
+    auto table = MakeTable();
+    batch->Append(Tuple{table.FinalizeAggregateValue(table.GenerateInitialAggregateValue()), &GetOutputSchema()},
+                  RID{});
+    return true;
+  }
+  // Emit the groups of the partitions in order, straight from their tables.
+  while (!batch->IsFull() && SeekNextGroup()) {
+    const auto &groups = partitions_[output_partition_].GetGroups();
+    for (; !batch->IsFull() && output_idx_ < groups.size(); output_idx_++) {
+      auto [tuple, rid] = batch->AppendSlot();
+      *tuple = MakeOutputTuple(groups[output_idx_]);
+      *rid = RID{};
+    }
+  }
+  return !batch->IsEmpty();
+}
+
+auto AggregationExecutor::SeekNextGroup() -> bool {
+  while (output_partition_ == partitions_.size() || output_idx_ == partitions_[output_partition_].Size()) {
+    if (output_partition_ + 1 < partitions_.size()) {
+      output_partition_++;
+    } else if (LoadNextPartition()) {
+      output_partition_ = 0;
+    } else {
+      return false;
+    }
+    output_idx_ = 0;
+  }
+  return true;
+}
+
+auto AggregationExecutor::MakeOutputTuple(const SimpleAggregationHashTable::Group &group) const -> Tuple {
+  auto values = DeserializeAggregateKey(group.key_.data(), group.key_.size());
+  // Every table aggregates the same way, any of them finalizes the group.
+  auto aggregates = partitions_[0].FinalizeAggregateValue(group.value_);
+  values.insert(values.end(), aggregates.begin(), aggregates.end());
+  return Tuple{std::move(values), &GetOutputSchema()};
+}
+
+auto AggregationExecutor::GetChildExecutor() const -> const AbstractExecutor * { return child_.get(); }
+
+}  // namespace bustub
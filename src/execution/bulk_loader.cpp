@@ -0,0 +1,382 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bulk_loader.cpp
+//
+// Identification: src/execution/bulk_loader.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/bulk_loader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+#include "common/exception.h"
+#include "fmt/format.h"
+#include "storage/page/table_page.h"
+#include "type/limits.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** Parse an integer field, the whole field being the number. */
+template <class T>
+auto ParseInteger(std::string_view field, T min_value, T *out) -> bool {
+  int64_t value = 0;
+  auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+  if (error != std::errc{} || end != field.data() + field.size()) {
+    return false;
+  }
+  // The smallest value of a type stands for NULL.
+  if (value < min_value || value > std::numeric_limits<T>::max()) {
+    return false;
+  }
+  *out = static_cast<T>(value);
+  return true;
+}
+
+/** @return the line break ending the row that starts at begin, or nullptr if the row goes on past end */
+auto FindRowEnd(const char *begin, const char *end) -> const char * {
+  bool in_quotes = false;
+  for (const char *p = begin; p < end; p++) {
+    if (*p == '"') {
+      in_quotes = !in_quotes;
+    } else if (*p == '\n' && !in_quotes) {
+      return p;
+    }
+  }
+  return nullptr;
+}
+
+auto NewTablePage() -> std::unique_ptr<char[]> {
+  auto page = std::make_unique<char[]>(BUSTUB_PAGE_SIZE);
+  reinterpret_cast<TablePage *>(page.get())->Init();
+  return page;
+}
+
+/** An entry to insert into an index */
+struct IndexEntry {
+  Tuple key_;
+  RID rid_;
+};
+
+auto KeyLess(const Schema &key_schema, const Tuple &lhs, const Tuple &rhs) -> bool {
+  for (uint32_t i = 0; i < key_schema.GetColumnCount(); i++) {
+    auto lhs_value = lhs.GetValue(&key_schema, i);
+    auto rhs_value = rhs.GetValue(&key_schema, i);
+    if (lhs_value.CompareLessThan(rhs_value) == CmpBool::CmpTrue) {
+      return true;
+    }
+    if (lhs_value.CompareGreaterThan(rhs_value) == CmpBool::CmpTrue) {
+      return false;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+BulkLoader::BulkLoader(TableInfo *table_info, std::vector<IndexInfo *> indexes, TaskScheduler *scheduler,
+                       CsvFormat format, size_t chunk_size)
+    : table_info_(table_info),
+      indexes_(std::move(indexes)),
+      scheduler_(scheduler),
+      format_(std::move(format)),
+      chunk_size_(chunk_size) {
+  BUSTUB_ASSERT(chunk_size_ > 0, "empty chunks");
+}
+
+auto BulkLoader::Load(const std::string &file_path, Transaction *txn) -> size_t {
+  std::ifstream file(file_path, std::ios::binary);
+  if (!file.is_open()) {
+    throw Exception(fmt::format("cannot open file {}", file_path));
+  }
+
+  // A round gives a few chunks to every thread, so that a long chunk does not leave the others idle.
+  auto num_slots = scheduler_ == nullptr ? 1 : scheduler_->GetSlotCount();
+  auto round_size = chunk_size_ * num_slots * 4;
+  std::vector<char> buffer;
+  size_t carry = 0;
+  size_t num_rows = 0;
+  bool skip_header = format_.header_;
+  bool at_eof = false;
+  while (!at_eof) {
+    // Read the next round after the incomplete row left over by the previous one.
+    buffer.resize(carry + round_size);
+    file.read(buffer.data() + carry, static_cast<std::streamsize>(round_size));
+    auto size = carry + static_cast<size_t>(file.gcount());
+    at_eof = file.eof();
+    if (!at_eof && file.fail()) {
+      throw Exception(fmt::format("cannot read file {}", file_path));
+    }
+
+    const char *begin = buffer.data();
+    const char *end = buffer.data() + size;
+    if (skip_header) {
+      auto header_end = FindRowEnd(begin, end);
+      if (header_end == nullptr && !at_eof) {
+        carry = size;
+        continue;
+      }
+      begin = header_end == nullptr ? end : header_end + 1;
+      skip_header = false;
+    }
+    const char *rest = end;
+    auto chunks = SplitChunks(begin, end, at_eof, &rest);
+
+    RunTasks(chunks.size(), [&](size_t idx) { ParseChunk(&chunks[idx]); });
+
+    std::vector<std::vector<page_id_t>> page_ids;
+    page_ids.reserve(chunks.size());
+    for (const auto &chunk : chunks) {
+      page_ids.push_back(table_info_->table_->AppendPages(chunk.pages_));
+      num_rows += chunk.num_rows_;
+    }
+    UpdateIndexes(chunks, page_ids, txn);
+
+    carry = end - rest;
+    memmove(buffer.data(), rest, carry);
+  }
+  return num_rows;
+}
+
+auto BulkLoader::SplitChunks(const char *begin, const char *end, bool at_eof, const char **rest) const
+    -> std::vector<Chunk> {
+  std::vector<Chunk> chunks;
+  // Without quotes, every line break ends a row. Otherwise the quotes are counted from the start of the round, which
+  // is the start of a row, to tell the line breaks within quoted fields apart.
+  bool has_quotes = memchr(begin, '"', end - begin) != nullptr;
+  bool in_quotes = false;
+  const char *pos = begin;
+  while (pos < end) {
+    // A chunk ends with the first line break that ends a row after its first chunk_size_ bytes.
+    const char *target = pos + std::min<size_t>(chunk_size_, end - pos) - 1;
+    const char *row_end = nullptr;
+    if (!has_quotes) {
+      row_end = static_cast<const char *>(memchr(target, '\n', end - target));
+    } else {
+      for (const char *p = pos; p < end; p++) {
+        if (*p == '"') {
+          in_quotes = !in_quotes;
+        } else if (*p == '\n' && !in_quotes && p >= target) {
+          row_end = p;
+          break;
+        }
+      }
+    }
+    if (row_end == nullptr) {
+      if (!at_eof) {
+        break;
+      }
+      chunks.push_back({pos, end, {}});
+      pos = end;
+      break;
+    }
+    chunks.push_back({pos, row_end + 1, {}});
+    pos = row_end + 1;
+  }
+  *rest = pos;
+  return chunks;
+}
+
+void BulkLoader::ParseChunk(Chunk *chunk) const {
+  const auto &schema = table_info_->schema_;
+  auto num_columns = schema.GetColumnCount();
+  const TupleMeta meta{INVALID_TXN_ID, INVALID_TXN_ID, false};
+  auto delimiter = format_.delimiter_;
+
+  auto page = NewTablePage();
+  std::vector<Value> values;
+  std::string unquoted;
+  const char *pos = chunk->begin_;
+  const char *end = chunk->end_;
+  while (pos < end) {
+    if (*pos == '\n' || (*pos == '\r' && pos + 1 < end && pos[1] == '\n')) {
+      pos += *pos == '\n' ? 1 : 2;
+      continue;
+    }
+
+    values.reserve(num_columns);
+    while (true) {
+      std::string_view field;
+      bool quoted = pos < end && *pos == '"';
+      if (quoted) {
+        // A quoted field ends with a quote that is not followed by another one.
+        unquoted.clear();
+        pos++;
+        while (true) {
+          auto quote = static_cast<const char *>(memchr(pos, '"', end - pos));
+          if (quote == nullptr) {
+            throw Exception("unterminated quoted field");
+          }
+          unquoted.append(pos, quote);
+          pos = quote + 1;
+          if (pos == end || *pos != '"') {
+            break;
+          }
+          unquoted.push_back('"');
+          pos++;
+        }
+        field = unquoted;
+      } else {
+        const char *field_begin = pos;
+        while (pos < end && *pos != delimiter && *pos != '\n') {
+          pos++;
+        }
+        field = std::string_view(field_begin, pos - field_begin);
+        if (!field.empty() && field.back() == '\r' && (pos == end || *pos == '\n')) {
+          field.remove_suffix(1);
+        }
+      }
+      if (values.size() == num_columns) {
+        throw Exception(fmt::format("row has more than {} fields", num_columns));
+      }
+      values.push_back(ParseValue(field, quoted, schema.GetColumn(values.size())));
+
+      if (pos < end && *pos == delimiter) {
+        pos++;
+        continue;
+      }
+      if (pos < end && *pos == '\r') {
+        pos++;
+      }
+      if (pos < end && *pos != '\n') {
+        throw Exception("unexpected character after a quoted field");
+      }
+      pos = pos < end ? pos + 1 : pos;
+      break;
+    }
+    if (values.size() != num_columns) {
+      throw Exception(fmt::format("row has {} fields, expected {}", values.size(), num_columns));
+    }
+
+    Tuple tuple{std::move(values), &schema};
+    values = {};
+    if (!reinterpret_cast<TablePage *>(page.get())->InsertTuple(meta, tuple).has_value()) {
+      chunk->pages_.push_back(std::move(page));
+      page = NewTablePage();
+      if (!reinterpret_cast<TablePage *>(page.get())->InsertTuple(meta, tuple).has_value()) {
+        throw Exception("tuple is too large for a page");
+      }
+    }
+    chunk->num_rows_++;
+  }
+  if (reinterpret_cast<TablePage *>(page.get())->GetNumTuples() > 0) {
+    chunk->pages_.push_back(std::move(page));
+  }
+}
+
+auto BulkLoader::ParseValue(std::string_view field, bool quoted, const Column &column) const -> Value {
+  auto type = column.GetType();
+  if (!quoted && field == format_.null_string_) {
+    return ValueFactory::GetNullValueByType(type);
+  }
+  auto invalid = [&]() {
+    return Exception(fmt::format("invalid value for column {} of type {}: {}", column.GetName(),
+                                 Type::TypeIdToString(type), field));
+  };
+  switch (type) {
+    case TypeId::TINYINT: {
+      int8_t value = 0;
+      if (!ParseInteger<int8_t>(field, BUSTUB_INT8_MIN, &value)) {
+        throw invalid();
+      }
+      return ValueFactory::GetTinyIntValue(value);
+    }
+    case TypeId::SMALLINT: {
+      int16_t value = 0;
+      if (!ParseInteger<int16_t>(field, BUSTUB_INT16_MIN, &value)) {
+        throw invalid();
+      }
+      return ValueFactory::GetSmallIntValue(value);
+    }
+    case TypeId::INTEGER: {
+      int32_t value = 0;
+      if (!ParseInteger<int32_t>(field, BUSTUB_INT32_MIN, &value)) {
+        throw invalid();
+      }
+      return ValueFactory::GetIntegerValue(value);
+    }
+    case TypeId::BIGINT: {
+      int64_t value = 0;
+      if (!ParseInteger<int64_t>(field, BUSTUB_INT64_MIN, &value)) {
+        throw invalid();
+      }
+      return ValueFactory::GetBigIntValue(value);
+    }
+    case TypeId::DECIMAL: {
+      double value = 0;
+      auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+      if (error != std::errc{} || end != field.data() + field.size()) {
+        throw invalid();
+      }
+      return ValueFactory::GetDecimalValue(value);
+    }
+    case TypeId::VARCHAR:
+      return ValueFactory::GetVarcharValue(std::string(field));
+    default:
+      // The other types are rare in files: go through the casts of strings.
+      try {
+        return ValueFactory::GetVarcharValue(std::string(field)).CastAs(type);
+      } catch (Exception &e) {
+        throw invalid();
+      }
+  }
+}
+
+void BulkLoader::UpdateIndexes(const std::vector<Chunk> &chunks, const std::vector<std::vector<page_id_t>> &page_ids,
+                               Transaction *txn) {
+  const auto &schema = table_info_->schema_;
+  for (auto *index_info : indexes_) {
+    const auto &key_schema = index_info->key_schema_;
+    const auto &key_attrs = index_info->index_->GetKeyAttrs();
+
+    // Extract the keys from the pages kept in memory, without going through the buffer pool.
+    std::vector<std::vector<IndexEntry>> chunk_entries(chunks.size());
+    RunTasks(chunks.size(), [&](size_t idx) {
+      auto &entries = chunk_entries[idx];
+      entries.reserve(chunks[idx].num_rows_);
+      for (size_t i = 0; i < chunks[idx].pages_.size(); i++) {
+        auto page = reinterpret_cast<const TablePage *>(chunks[idx].pages_[i].get());
+        for (uint32_t slot = 0; slot < page->GetNumTuples(); slot++) {
+          RID rid{page_ids[idx][i], slot};
+          auto [meta, tuple] = page->GetTuple(rid);
+          entries.push_back({tuple.KeyFromTuple(schema, key_schema, key_attrs), rid});
+        }
+      }
+    });
+
+    std::vector<IndexEntry> entries;
+    for (auto &chunk : chunk_entries) {
+      std::move(chunk.begin(), chunk.end(), std::back_inserter(entries));
+    }
+    std::sort(entries.begin(), entries.end(),
+              [&](const IndexEntry &lhs, const IndexEntry &rhs) { return KeyLess(key_schema, lhs.key_, rhs.key_); });
+    for (const auto &entry : entries) {
+      index_info->index_->InsertEntry(entry.key_, entry.rid_, txn);
+    }
+  }
+}
+
+void BulkLoader::RunTasks(size_t num_tasks, const std::function<void(size_t)> &task) {
+  if (scheduler_ == nullptr) {
+    for (size_t idx = 0; idx < num_tasks; idx++) {
+      task(idx);
+    }
+    return;
+  }
+  scheduler_->ParallelFor(num_tasks, [&](size_t idx, size_t /* slot */) { task(idx); });
+}
+
+}  // namespace bustub
@@ -0,0 +1,577 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// expression_program.cpp
+//
+// Identification: src/execution/expression_program.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/expression_program.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+#include "common/exception.h"
+#include "common/macros.h"
+#include "execution/expressions/arithmetic_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/vector_kernels.h"
+#include "type/limits.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** @return the null value of the C++ type a column of a fixed-size type is stored as */
+template <class T>
+constexpr auto NullOf() -> T {
+  if constexpr (std::is_same_v<T, int8_t>) {
+    return BUSTUB_INT8_NULL;
+  } else if constexpr (std::is_same_v<T, int16_t>) {
+    return BUSTUB_INT16_NULL;
+  } else if constexpr (std::is_same_v<T, int32_t>) {
+    return BUSTUB_INT32_NULL;
+  } else if constexpr (std::is_same_v<T, int64_t>) {
+    return BUSTUB_INT64_NULL;
+  } else if constexpr (std::is_same_v<T, double>) {
+    return BUSTUB_DECIMAL_NULL;
+  } else {
+    static_assert(std::is_same_v<T, uint64_t>);
+    return BUSTUB_TIMESTAMP_NULL;
+  }
+}
+
+/**
+ * Call `fn` with a value of the C++ type a register of the given type holds, std::string_view for VARCHAR.
+ * BOOLEAN registers hold a bitmap, and are left to the caller.
+ * @return what `fn` returns, or a null kernel for an unsupported type
+ */
+template <class Kernel, class Fn>
+auto VisitType(TypeId type, Fn &&fn) -> Kernel {
+  switch (type) {
+    case TypeId::TINYINT:
+      return fn(int8_t{});
+    case TypeId::SMALLINT:
+      return fn(int16_t{});
+    case TypeId::INTEGER:
+      return fn(int32_t{});
+    case TypeId::BIGINT:
+      return fn(int64_t{});
+    case TypeId::DECIMAL:
+      return fn(double{});
+    case TypeId::TIMESTAMP:
+      return fn(uint64_t{});
+    case TypeId::VARCHAR:
+      return fn(std::string_view{});
+    default:
+      return nullptr;
+  }
+}
+
+/** Call `fn` with std::true_type or std::false_type for each operand, for kernels templated on scalar operands. */
+template <class Fn>
+void WithScalarOperands(bool lhs_scalar, bool rhs_scalar, Fn &&fn) {
+  if (lhs_scalar) {
+    if (rhs_scalar) {
+      fn(std::true_type{}, std::true_type{});
+    } else {
+      fn(std::true_type{}, std::false_type{});
+    }
+  } else if (rhs_scalar) {
+    fn(std::false_type{}, std::true_type{});
+  } else {
+    fn(std::false_type{}, std::false_type{});
+  }
+}
+
+/** @return a word of a bitmap, a scalar's single bit repeated over the word */
+auto BitmapWord(const uint64_t *bitmap, bool is_scalar, size_t word) -> uint64_t {
+  if (is_scalar) {
+    return (bitmap[0] & 1) != 0 ? ~static_cast<uint64_t>(0) : 0;
+  }
+  return bitmap[word];
+}
+
+auto IsNumeric(TypeId type) -> bool {
+  return type == TypeId::TINYINT || type == TypeId::SMALLINT || type == TypeId::INTEGER || type == TypeId::BIGINT ||
+         type == TypeId::DECIMAL;
+}
+
+/** @return the type two operands are compared as, or std::nullopt if the compiler does not handle the comparison */
+auto ComparisonTypeOf(TypeId lhs, TypeId rhs) -> std::optional<TypeId> {
+  if (lhs == rhs) {
+    return lhs;
+  }
+  if (IsNumeric(lhs) && IsNumeric(rhs)) {
+    // The numeric type ids are ordered by width, DECIMAL last.
+    return std::max(lhs, rhs);
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+template <class T>
+void ExpressionProgram::LoadColumn(const TupleRef *tuples, size_t num_tuples, uint32_t offset, bool is_inlined,
+                                   Register *dst) {
+  if constexpr (std::is_same_v<T, std::string_view>) {
+    for (size_t i = 0; i < num_tuples; i++) {
+      const char *data = tuples[i].GetData();
+      const char *storage = data + offset;
+      if (!is_inlined) {
+        // Non-inlined columns store the offset of their payload within the tuple.
+        storage = data + *reinterpret_cast<const uint32_t *>(storage);
+      }
+      dst->vector_.SetFromStorage(i, storage);
+    }
+  } else {
+    auto *out = dst->vector_.GetData<T>();
+    for (size_t i = 0; i < num_tuples; i++) {
+      std::memcpy(&out[i], tuples[i].GetData() + offset, sizeof(T));
+    }
+    uint64_t nulls[BATCH_WORDS];
+    EqualsBitmap(out, NullOf<T>(), num_tuples, nulls);
+    dst->vector_.MarkNulls(nulls, num_tuples);
+  }
+}
+
+void ExpressionProgram::LoadBooleanColumn(const TupleRef *tuples, size_t num_tuples, uint32_t offset,
+                                          bool /*is_inlined*/, Register *dst) {
+  auto value_at = [&](size_t i) { return static_cast<int8_t>(tuples[i].GetData()[offset]); };
+  uint64_t nulls[BATCH_WORDS];
+  FillBitmap(num_tuples, nulls, [&](size_t i) { return value_at(i) == BUSTUB_BOOLEAN_NULL; });
+  FillBitmap(num_tuples, dst->bits_.data(),
+             [&](size_t i) { return value_at(i) != 0 && value_at(i) != BUSTUB_BOOLEAN_NULL; });
+  dst->vector_.MarkNulls(nulls, num_tuples);
+}
+
+void ExpressionProgram::PropagateNulls(const Register &lhs, const Register &rhs, Register *dst, size_t num_rows) {
+  if (!lhs.vector_.HasNull() && !rhs.vector_.HasNull()) {
+    return;
+  }
+  uint64_t nulls[BATCH_WORDS];
+  auto num_words = BitmapWordCount(num_rows);
+  for (size_t word = 0; word < num_words; word++) {
+    nulls[word] = BitmapWord(lhs.vector_.GetNullMask(), lhs.is_scalar_, word) |
+                  BitmapWord(rhs.vector_.GetNullMask(), rhs.is_scalar_, word);
+  }
+  nulls[num_words - 1] &= BitmapLastWordMask(num_rows);
+  dst->vector_.MarkNulls(nulls, num_rows);
+  if (!dst->bits_.empty()) {
+    for (size_t word = 0; word < num_words; word++) {
+      dst->bits_[word] &= ~nulls[word];
+    }
+  }
+}
+
+template <class From, class To>
+void ExpressionProgram::Cast(const Register &src, const Register & /*unused*/, Register *dst, size_t num_rows) {
+  // A cast register is scalar exactly when its source is.
+  const auto *in = src.vector_.GetData<From>();
+  auto *out = dst->vector_.GetData<To>();
+  for (size_t i = 0; i < num_rows; i++) {
+    out[i] = static_cast<To>(in[i]);
+  }
+  if (src.vector_.HasNull()) {
+    dst->vector_.MarkNulls(src.vector_.GetNullMask(), num_rows);
+  }
+}
+
+template <class T, class Op>
+void ExpressionProgram::Compare(const Register &lhs, const Register &rhs, Register *dst, size_t num_rows) {
+  auto *out = dst->bits_.data();
+  if constexpr (std::is_same_v<T, std::string_view>) {
+    Op op;
+    FillBitmap(num_rows, out, [&](size_t i) {
+      // As TypeUtil::CompareStrings(): bytes compared as unsigned chars, then the shorter string first.
+      auto l = lhs.vector_.GetString(lhs.is_scalar_ ? 0 : i);
+      auto r = rhs.vector_.GetString(rhs.is_scalar_ ? 0 : i);
+      return op(l.compare(r), 0);
+    });
+  } else {
+    const auto *l = lhs.vector_.GetData<T>();
+    const auto *r = rhs.vector_.GetData<T>();
+    WithScalarOperands(lhs.is_scalar_, rhs.is_scalar_, [&](auto lhs_scalar, auto rhs_scalar) {
+      CompareKernel<T, Op, decltype(lhs_scalar)::value, decltype(rhs_scalar)::value>(l, r, num_rows, out);
+    });
+  }
+  PropagateNulls(lhs, rhs, dst, num_rows);
+}
+
+template <class Op>
+void ExpressionProgram::CompareBooleans(const Register &lhs, const Register &rhs, Register *dst, size_t num_rows) {
+  Op op;
+  auto bit_at = [](const Register &reg, size_t i) {
+    auto row = reg.is_scalar_ ? 0 : i;
+    return ((reg.bits_[row / 64] >> (row % 64)) & 1) != 0;
+  };
+  FillBitmap(num_rows, dst->bits_.data(), [&](size_t i) { return op(bit_at(lhs, i), bit_at(rhs, i)); });
+  PropagateNulls(lhs, rhs, dst, num_rows);
+}
+
+template <class T, class Op>
+void ExpressionProgram::Arithmetic(const Register &lhs, const Register &rhs, Register *dst, size_t num_rows) {
+  const auto *l = lhs.vector_.GetData<T>();
+  const auto *r = rhs.vector_.GetData<T>();
+  auto *out = dst->vector_.GetData<T>();
+  WithScalarOperands(lhs.is_scalar_, rhs.is_scalar_, [&](auto lhs_scalar, auto rhs_scalar) {
+    ArithmeticKernel<T, Op, decltype(lhs_scalar)::value, decltype(rhs_scalar)::value>(l, r, num_rows, out);
+  });
+  PropagateNulls(lhs, rhs, dst, num_rows);
+  auto num_words = BitmapWordCount(num_rows);
+  if constexpr (std::is_same_v<T, int64_t>) {
+    // BIGINT arithmetic fails on overflow, as with Values. INTEGER arithmetic wraps around.
+    uint64_t overflows[BATCH_WORDS];
+    WithScalarOperands(lhs.is_scalar_, rhs.is_scalar_, [&](auto lhs_scalar, auto rhs_scalar) {
+      OverflowKernel<T, Op, decltype(lhs_scalar)::value, decltype(rhs_scalar)::value>(l, r, out, num_rows, overflows);
+    });
+    for (size_t word = 0; word < num_words; word++) {
+      if ((overflows[word] & ~dst->vector_.GetNullMask()[word]) != 0) {
+        throw Exception(ExceptionType::OUT_OF_RANGE, "Numeric value out of range.");
+      }
+    }
+  }
+  // A result equal to the null value is null, as with Values.
+  uint64_t nulls[BATCH_WORDS];
+  EqualsBitmap(out, NullOf<T>(), num_rows, nulls);
+  dst->vector_.MarkNulls(nulls, num_rows);
+}
+
+/** AND and OR, where a null operand is unknown: false AND null is false, and true OR null is true. */
+template <bool IS_AND>
+void ExpressionProgram::Logic(const Register &lhs, const Register &rhs, Register *dst, size_t num_rows) {
+  uint64_t nulls[BATCH_WORDS];
+  auto num_words = BitmapWordCount(num_rows);
+  for (size_t word = 0; word < num_words; word++) {
+    auto l = BitmapWord(lhs.bits_.data(), lhs.is_scalar_, word);
+    auto r = BitmapWord(rhs.bits_.data(), rhs.is_scalar_, word);
+    auto l_null = BitmapWord(lhs.vector_.GetNullMask(), lhs.is_scalar_, word);
+    auto r_null = BitmapWord(rhs.vector_.GetNullMask(), rhs.is_scalar_, word);
+    if constexpr (IS_AND) {
+      // The result is decided by a false operand, and unknown otherwise.
+      auto any_false = (~l & ~l_null) | (~r & ~r_null);
+      dst->bits_[word] = l & r;
+      nulls[word] = (l_null | r_null) & ~any_false;
+    } else {
+      dst->bits_[word] = l | r;
+      nulls[word] = (l_null | r_null) & ~(l | r);
+    }
+  }
+  dst->bits_[num_words - 1] &= BitmapLastWordMask(num_rows);
+  nulls[num_words - 1] &= BitmapLastWordMask(num_rows);
+  dst->vector_.MarkNulls(nulls, num_rows);
+}
+
+template <class T>
+auto ExpressionProgram::PickCompare(ComparisonType comp_type) -> ComputeKernel {
+  auto pick = [](auto op) -> ComputeKernel {
+    if constexpr (std::is_same_v<T, bool>) {
+      return &CompareBooleans<decltype(op)>;
+    } else {
+      return &Compare<T, decltype(op)>;
+    }
+  };
+  switch (comp_type) {
+    case ComparisonType::Equal:
+      return pick(std::equal_to<>{});
+    case ComparisonType::NotEqual:
+      return pick(std::not_equal_to<>{});
+    case ComparisonType::LessThan:
+      return pick(std::less<>{});
+    case ComparisonType::LessThanOrEqual:
+      return pick(std::less_equal<>{});
+    case ComparisonType::GreaterThan:
+      return pick(std::greater<>{});
+    case ComparisonType::GreaterThanOrEqual:
+      return pick(std::greater_equal<>{});
+    default:
+      return nullptr;
+  }
+}
+
+auto ExpressionProgram::Compile(const std::vector<AbstractExpressionRef> &exprs, const Schema &schema)
+    -> std::optional<ExpressionProgram> {
+  ExpressionProgram program;
+  program.left_schema_ = &schema;
+  for (const auto &expr : exprs) {
+    auto reg = program.CompileExpression(expr);
+    if (!reg.has_value()) {
+      return std::nullopt;
+    }
+    program.outputs_.push_back(*reg);
+  }
+  return program;
+}
+
+auto ExpressionProgram::CompilePredicate(const AbstractExpressionRef &predicate, const Schema &schema)
+    -> std::optional<ExpressionProgram> {
+  auto program = Compile({predicate}, schema);
+  if (!program.has_value() || program->registers_[program->outputs_[0]].vector_.GetType() != TypeId::BOOLEAN) {
+    return std::nullopt;
+  }
+  return program;
+}
+
+auto ExpressionProgram::CompileJoin(const AbstractExpressionRef &predicate, const Schema &left_schema,
+                                    const Schema &right_schema) -> std::optional<ExpressionProgram> {
+  ExpressionProgram program;
+  program.left_schema_ = &left_schema;
+  program.right_schema_ = &right_schema;
+  auto reg = program.CompileExpression(predicate);
+  if (!reg.has_value() || program.registers_[*reg].vector_.GetType() != TypeId::BOOLEAN) {
+    return std::nullopt;
+  }
+  program.outputs_.push_back(*reg);
+  return program;
+}
+
+auto ExpressionProgram::AddRegister(TypeId type, bool is_scalar, bool is_constant) -> uint32_t {
+  size_t capacity = is_scalar ? 1 : BATCH_SIZE;
+  std::vector<uint64_t> bits(type == TypeId::BOOLEAN ? BitmapWordCount(capacity) : 0);
+  registers_.push_back(Register{ColumnVector{type, capacity}, std::move(bits), is_scalar, is_constant});
+  return registers_.size() - 1;
+}
+
+auto ExpressionProgram::CompileColumn(uint32_t tuple_idx, uint32_t col_idx) -> uint32_t {
+  // Outside of a join, the tuple index of a column is meaningless, as in AbstractExpression::Evaluate().
+  bool from_right = right_schema_ != nullptr && tuple_idx == 1;
+  auto key = std::make_pair(static_cast<uint32_t>(from_right), col_idx);
+  for (const auto &[column, reg] : column_registers_) {
+    if (column == key) {
+      return reg;
+    }
+  }
+  const auto &column = (from_right ? right_schema_ : left_schema_)->GetColumn(col_idx);
+  auto dst = AddRegister(column.GetType(), from_right, false);
+  Instruction instruction{};
+  instruction.dst_ = dst;
+  instruction.load_ = column.GetType() == TypeId::BOOLEAN
+                          ? &LoadBooleanColumn
+                          : VisitType<LoadKernel>(column.GetType(), [](auto tag) -> LoadKernel {
+                              return &LoadColumn<decltype(tag)>;
+                            });
+  BUSTUB_ASSERT(instruction.load_ != nullptr, "column of an unsupported type");
+  instruction.column_offset_ = column.GetOffset();
+  instruction.column_inlined_ = column.IsInlined();
+  instruction.from_right_ = from_right;
+  instructions_.push_back(instruction);
+  column_registers_.emplace_back(key, dst);
+  return dst;
+}
+
+auto ExpressionProgram::CompileCast(uint32_t src, TypeId type) -> std::optional<uint32_t> {
+  auto src_type = registers_[src].vector_.GetType();
+  if (src_type == type) {
+    return src;
+  }
+  auto kernel = VisitType<ComputeKernel>(src_type, [type](auto from_tag) {
+    return VisitType<ComputeKernel>(type, [](auto to_tag) -> ComputeKernel {
+      using From = decltype(from_tag);
+      using To = decltype(to_tag);
+      if constexpr (std::is_arithmetic_v<From> && std::is_arithmetic_v<To>) {
+        return &Cast<From, To>;
+      } else {
+        return nullptr;
+      }
+    });
+  });
+  if (kernel == nullptr) {
+    return std::nullopt;
+  }
+  const auto &src_reg = registers_[src];
+  auto dst = AddRegister(type, src_reg.is_scalar_, false);
+  Instruction instruction{};
+  instruction.dst_ = dst;
+  instruction.compute_ = kernel;
+  instruction.lhs_ = src;
+  instruction.rhs_ = src;
+  instructions_.push_back(instruction);
+  return dst;
+}
+
+auto ExpressionProgram::CompileExpression(const AbstractExpressionRef &expr) -> std::optional<uint32_t> {
+  if (const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      column_value_expr != nullptr) {
+    return CompileColumn(column_value_expr->GetTupleIdx(), column_value_expr->GetColIdx());
+  }
+  if (const auto *constant_expr = dynamic_cast<const ConstantValueExpression *>(expr.get());
+      constant_expr != nullptr) {
+    const auto &value = constant_expr->val_;
+    auto type = value.GetTypeId();
+    if (type != TypeId::BOOLEAN && !IsNumeric(type) && type != TypeId::TIMESTAMP && type != TypeId::VARCHAR) {
+      return std::nullopt;
+    }
+    auto dst = AddRegister(value.GetTypeId(), true, true);
+    registers_[dst].vector_.SetValue(0, value);
+    if (type == TypeId::BOOLEAN) {
+      registers_[dst].bits_[0] = static_cast<uint64_t>(!value.IsNull() && value.GetAs<int8_t>() != 0);
+    }
+    return dst;
+  }
+
+  // The remaining expressions compute a register from two operands.
+  if (expr->GetChildren().size() != 2) {
+    return std::nullopt;
+  }
+  auto lhs = CompileExpression(expr->GetChildAt(0));
+  auto rhs = lhs.has_value() ? CompileExpression(expr->GetChildAt(1)) : std::nullopt;
+  if (!rhs.has_value()) {
+    return std::nullopt;
+  }
+  auto lhs_type = registers_[*lhs].vector_.GetType();
+  auto rhs_type = registers_[*rhs].vector_.GetType();
+  ComputeKernel kernel = nullptr;
+  TypeId dst_type = TypeId::BOOLEAN;
+  if (const auto *comparison_expr = dynamic_cast<const ComparisonExpression *>(expr.get());
+      comparison_expr != nullptr) {
+    auto type = ComparisonTypeOf(lhs_type, rhs_type);
+    if (!type.has_value()) {
+      return std::nullopt;
+    }
+    lhs = CompileCast(*lhs, *type);
+    rhs = CompileCast(*rhs, *type);
+    if (!lhs.has_value() || !rhs.has_value()) {
+      return std::nullopt;
+    }
+    auto comp_type = comparison_expr->comp_type_;
+    kernel = *type == TypeId::BOOLEAN ? PickCompare<bool>(comp_type)
+                                      : VisitType<ComputeKernel>(*type, [comp_type](auto tag) {
+                                          return PickCompare<decltype(tag)>(comp_type);
+                                        });
+  } else if (const auto *arithmetic_expr = dynamic_cast<const ArithmeticExpression *>(expr.get());
+             arithmetic_expr != nullptr) {
+    // ArithmeticExpression takes two operands of the same type.
+    if (lhs_type != rhs_type || (lhs_type != TypeId::INTEGER && lhs_type != TypeId::BIGINT &&
+                                 lhs_type != TypeId::DECIMAL)) {
+      return std::nullopt;
+    }
+    dst_type = lhs_type;
+    auto compute_type = arithmetic_expr->compute_type_;
+    kernel = VisitType<ComputeKernel>(dst_type, [compute_type](auto tag) -> ComputeKernel {
+      using T = decltype(tag);
+      if constexpr (std::is_arithmetic_v<T>) {
+        return compute_type == ArithmeticType::Plus ? &Arithmetic<T, PlusOp> : &Arithmetic<T, MinusOp>;
+      } else {
+        return nullptr;
+      }
+    });
+  } else if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(expr.get()); logic_expr != nullptr) {
+    if (lhs_type != TypeId::BOOLEAN || rhs_type != TypeId::BOOLEAN) {
+      return std::nullopt;
+    }
+    kernel = logic_expr->logic_type_ == LogicType::And ? &Logic<true> : &Logic<false>;
+  }
+  if (kernel == nullptr) {
+    return std::nullopt;
+  }
+
+  auto dst = AddRegister(dst_type, registers_[*lhs].is_scalar_ && registers_[*rhs].is_scalar_, false);
+  Instruction instruction{};
+  instruction.dst_ = dst;
+  instruction.compute_ = kernel;
+  instruction.lhs_ = *lhs;
+  instruction.rhs_ = *rhs;
+  instructions_.push_back(instruction);
+  return dst;
+}
+
+void ExpressionProgram::Evaluate(const Tuple *tuples, size_t num_tuples, const Tuple *right_tuple) {
+  BUSTUB_ASSERT(num_tuples <= BATCH_SIZE, "too many tuples for one evaluation");
+  TupleRef refs[BATCH_SIZE];
+  for (size_t i = 0; i < num_tuples; i++) {
+    refs[i] = tuples[i].AsRef();
+  }
+  TupleRef right_ref = right_tuple != nullptr ? right_tuple->AsRef() : TupleRef{};
+  Evaluate(refs, num_tuples, right_tuple != nullptr ? &right_ref : nullptr);
+}
+
+void ExpressionProgram::Evaluate(const TupleRef *tuples, size_t num_tuples, const TupleRef *right_tuple) {
+  BUSTUB_ASSERT(num_tuples <= BATCH_SIZE, "too many tuples for one evaluation");
+  BUSTUB_ASSERT((right_tuple != nullptr) == (right_schema_ != nullptr), "a join predicate needs a right tuple");
+  for (auto &reg : registers_) {
+    if (!reg.is_constant_) {
+      reg.vector_.Reset();
+    }
+  }
+  for (const auto &instruction : instructions_) {
+    auto &dst = registers_[instruction.dst_];
+    if (instruction.load_ != nullptr) {
+      if (instruction.from_right_) {
+        instruction.load_(right_tuple, 1, instruction.column_offset_, instruction.column_inlined_, &dst);
+      } else {
+        instruction.load_(tuples, num_tuples, instruction.column_offset_, instruction.column_inlined_, &dst);
+      }
+      continue;
+    }
+    const auto &lhs = registers_[instruction.lhs_];
+    const auto &rhs = registers_[instruction.rhs_];
+    instruction.compute_(lhs, rhs, &dst, dst.is_scalar_ ? 1 : num_tuples);
+  }
+}
+
+auto ExpressionProgram::GetValue(size_t expr_idx, size_t tuple_idx) const -> Value {
+  const auto &reg = registers_[outputs_[expr_idx]];
+  auto row = reg.is_scalar_ ? 0 : tuple_idx;
+  if (reg.vector_.GetType() != TypeId::BOOLEAN) {
+    return reg.vector_.GetValue(row);
+  }
+  if (reg.vector_.IsNull(row)) {
+    return ValueFactory::GetNullValueByType(TypeId::BOOLEAN);
+  }
+  return ValueFactory::GetBooleanValue(((reg.bits_[row / 64] >> (row % 64)) & 1) != 0);
+}
+
+void ExpressionProgram::Select(const Tuple *tuples, size_t num_tuples, const Tuple *right_tuple,
+                               std::vector<uint32_t> *selection) {
+  selection->clear();
+  TupleRef refs[BATCH_SIZE];
+  TupleRef right_ref = right_tuple != nullptr ? right_tuple->AsRef() : TupleRef{};
+  for (size_t start = 0; start < num_tuples; start += BATCH_SIZE) {
+    auto count = std::min(BATCH_SIZE, num_tuples - start);
+    for (size_t i = 0; i < count; i++) {
+      refs[i] = tuples[start + i].AsRef();
+    }
+    SelectBatch(refs, count, right_tuple != nullptr ? &right_ref : nullptr, start, selection);
+  }
+}
+
+void ExpressionProgram::Select(const TupleRef *tuples, size_t num_tuples, const TupleRef *right_tuple,
+                               std::vector<uint32_t> *selection) {
+  selection->clear();
+  for (size_t start = 0; start < num_tuples; start += BATCH_SIZE) {
+    SelectBatch(tuples + start, std::min(BATCH_SIZE, num_tuples - start), right_tuple, start, selection);
+  }
+}
+
+void ExpressionProgram::SelectBatch(const TupleRef *tuples, size_t num_tuples, const TupleRef *right_tuple,
+                                    size_t start, std::vector<uint32_t> *selection) {
+  Evaluate(tuples, num_tuples, right_tuple);
+  // The bits of a boolean register are cleared on null rows, the set bits are the tuples to keep.
+  const auto &result = registers_[outputs_[0]];
+  if (result.is_scalar_) {
+    if ((result.bits_[0] & 1) != 0) {
+      for (size_t i = 0; i < num_tuples; i++) {
+        selection->push_back(start + i);
+      }
+    }
+    return;
+  }
+  for (size_t word = 0; word < BitmapWordCount(num_tuples); word++) {
+    for (auto bits = result.bits_[word]; bits != 0; bits &= bits - 1) {
+      selection->push_back(start + word * BITMAP_WORD_BITS + __builtin_ctzll(bits));
+    }
+  }
+}
+
+}  // namespace bustub
@@ -6,7 +6,10 @@ namespace bustub {
 
 FilterExecutor::FilterExecutor(ExecutorContext *exec_ctx, const FilterPlanNode *plan,
                                std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_executor_(std::move(child_executor)),
+      program_(ExpressionProgram::CompilePredicate(plan->GetPredicate(), child_executor_->GetOutputSchema())) {}
 
 void FilterExecutor::Init() {
   // Initialize the child executor
@@ -31,4 +34,36 @@ auto FilterExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   }
 }
 
+auto FilterExecutor::NextBatch(TupleBatch *batch) -> bool {
+  const auto &filter_expr = plan_->GetPredicate();
+  const auto &child_schema = child_executor_->GetOutputSchema();
+
+  // Keep pulling until a child batch has at least one surviving tuple, so that an empty batch means end of stream.
+  while (child_executor_->NextBatch(batch)) {
+    if (program_.has_value()) {
+      program_->Select(&batch->GetTuple(0), batch->Size(), nullptr, &selection_);
+      for (size_t i = 0; i < selection_.size(); i++) {
+        batch->MoveTo(selection_[i], i);
+      }
+      batch->Truncate(selection_.size());
+      if (!batch->IsEmpty()) {
+        return true;
+      }
+      continue;
+    }
+    size_t num_selected = 0;
+    for (size_t i = 0; i < batch->Size(); i++) {
+      auto value = filter_expr->Evaluate(&batch->GetTuple(i), child_schema);
+      if (!value.IsNull() && value.GetAs<bool>()) {
+        batch->MoveTo(i, num_selected++);
+      }
+    }
+    batch->Truncate(num_selected);
+    if (!batch->IsEmpty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace bustub
@@ -9,8 +9,10 @@
 #include "execution/plans/aggregation_plan.h"
 #include "execution/plans/hash_join_plan.h"
 #include "execution/plans/limit_plan.h"
+#include "execution/plans/merge_join_plan.h"
 #include "execution/plans/projection_plan.h"
 #include "execution/plans/sort_plan.h"
+#include "execution/plans/streaming_aggregation_plan.h"
 #include "execution/plans/topn_plan.h"
 
 namespace bustub {
@@ -33,14 +35,31 @@ auto AbstractPlanNode::ChildrenToString(int indent, bool with_schema) const -> s
 }
 
 auto AggregationPlanNode::PlanNodeToString() const -> std::string {
+  if (!agg_args_.empty()) {
+    return fmt::format("Agg {{ types={}, aggregates={}, args={}, group_by={} }}", agg_types_, aggregates_, agg_args_,
+                       group_bys_);
+  }
   return fmt::format("Agg {{ types={}, aggregates={}, group_by={} }}", agg_types_, aggregates_, group_bys_);
 }
 
+auto StreamingAggregationPlanNode::PlanNodeToString() const -> std::string {
+  if (!agg_args_.empty()) {
+    return fmt::format("StreamingAgg {{ types={}, aggregates={}, args={}, group_by={} }}", agg_types_, aggregates_,
+                       agg_args_, group_bys_);
+  }
+  return fmt::format("StreamingAgg {{ types={}, aggregates={}, group_by={} }}", agg_types_, aggregates_, group_bys_);
+}
+
 auto HashJoinPlanNode::PlanNodeToString() const -> std::string {
   return fmt::format("HashJoin {{ type={}, left_key={}, right_key={} }}", join_type_, left_key_expressions_,
                      right_key_expressions_);
 }
 
+auto MergeJoinPlanNode::PlanNodeToString() const -> std::string {
+  return fmt::format("MergeJoin {{ type={}, left_key={}, right_key={} }}", join_type_, left_key_expressions_,
+                     right_key_expressions_);
+}
+
 auto ProjectionPlanNode::PlanNodeToString() const -> std::string {
   return fmt::format("Projection {{ exprs={} }}", expressions_);
 }
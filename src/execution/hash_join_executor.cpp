@@ -12,20 +12,358 @@
 
 #include "execution/executors/hash_join_executor.h"
 
+#include <algorithm>
+
+#include "type/value_factory.h"
+
 namespace bustub {
 
+auto JoinKeyFilter::Check(const Tuple &tuple, const Schema &schema) const -> bool {
+  if (key_min_.empty()) {
+    // The build side is empty.
+    return false;
+  }
+  std::vector<Value> key;
+  key.reserve(key_exprs_.size());
+  for (size_t i = 0; i < key_exprs_.size(); i++) {
+    auto value = key_exprs_[i]->Evaluate(&tuple, schema);
+    if (value.IsNull() || value.CompareLessThan(key_min_[i]) == CmpBool::CmpTrue ||
+        value.CompareGreaterThan(key_max_[i]) == CmpBool::CmpTrue) {
+      return false;
+    }
+    key.emplace_back(std::move(value));
+  }
+  return bloom_filter_ == nullptr || bloom_filter_->MayContain(*PartitionedJoinHashTable::HashKey(key));
+}
+
+auto JoinKeyFilter::ReadsOnlyLeadingColumns(uint32_t num_columns) const -> bool {
+  return std::all_of(key_exprs_.begin(), key_exprs_.end(),
+                     [&](const auto &expr) { return ExpressionReadsOnlyLeadingColumns(expr, num_columns); });
+}
+
 HashJoinExecutor::HashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlanNode *plan,
                                    std::unique_ptr<AbstractExecutor> &&left_child,
                                    std::unique_ptr<AbstractExecutor> &&right_child)
-    : AbstractExecutor(exec_ctx) {
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_child)),
+      right_executor_(std::move(right_child)),
+      hash_table_(plan->RightJoinKeyExpressions(), &right_executor_->GetOutputSchema()) {
   if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
     // Note for 2023 Spring: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
-void HashJoinExecutor::Init() { throw NotImplementedException("HashJoinExecutor is not implemented"); }
+void HashJoinExecutor::Init() {
+  left_executor_->Init();
+  right_executor_->Init();
+
+  resident_tuples_.clear();
+  resident_memory_ = 0;
+  spill_partitions_.clear();
+  partition0_resident_ = true;
+  pending_partitions_.clear();
+  probe_reader_.reset();
+  current_partition_.reset();
+  collect_filter_keys_ = plan_->GetJoinType() == JoinType::INNER;
+  filter_key_min_.clear();
+  filter_key_max_.clear();
+  filter_hashes_.clear();
+  filter_hashes_overflow_ = false;
+
+  TupleBatch batch{};
+  while (right_executor_->NextBatch(&batch)) {
+    for (size_t i = 0; i < batch.Size(); i++) {
+      AddBuildTuple(std::move(batch.GetTuple(i)));
+    }
+  }
+  for (auto &partition : spill_partitions_) {
+    partition.build_->Finish();
+  }
+  hash_table_.Build(std::move(resident_tuples_), exec_ctx_->GetTaskScheduler());
+  resident_tuples_.clear();
+  if (collect_filter_keys_) {
+    PushDownJoinKeyFilter();
+  }
+
+  left_batch_.Clear();
+  left_idx_ = 0;
+  left_done_ = false;
+  matches_.clear();
+  match_idx_ = 0;
+}
+
+auto HashJoinExecutor::EvaluateKey(const Tuple &tuple, bool is_left) const -> std::vector<Value> {
+  const auto &exprs = is_left ? plan_->LeftJoinKeyExpressions() : plan_->RightJoinKeyExpressions();
+  const auto &schema = is_left ? left_executor_->GetOutputSchema() : right_executor_->GetOutputSchema();
+  std::vector<Value> key;
+  key.reserve(exprs.size());
+  for (const auto &expr : exprs) {
+    key.emplace_back(expr->Evaluate(&tuple, schema));
+  }
+  return key;
+}
+
+auto HashJoinExecutor::EstimateBuildMemory(size_t data_size, size_t num_tuples) const -> size_t {
+  // The tuple itself, its evaluated key, and the hash table entry and bucket.
+  auto per_tuple = sizeof(Tuple) + sizeof(std::vector<Value>) +
+                   plan_->RightJoinKeyExpressions().size() * sizeof(Value) + 4 * sizeof(hash_t);
+  return data_size + num_tuples * per_tuple;
+}
+
+void HashJoinExecutor::AddBuildTuple(Tuple &&tuple) {
+  auto key = EvaluateKey(tuple, false);
+  auto hash = PartitionedJoinHashTable::HashKey(key);
+  if (!hash.has_value()) {
+    // A null key never matches.
+    return;
+  }
+  if (collect_filter_keys_) {
+    CollectFilterKey(key, *hash);
+  }
+  if (!spill_partitions_.empty()) {
+    RouteBuildTuple(std::move(tuple), *hash);
+    return;
+  }
+  resident_memory_ += EstimateBuildMemory(tuple.GetLength(), 1);
+  resident_tuples_.emplace_back(std::move(tuple));
+  // Without a buffer pool there is nowhere to spill to, the whole build side stays in memory.
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+  if (resident_memory_ <= exec_ctx_->GetMemoryBudget() || bpm == nullptr) {
+    return;
+  }
+
+  // Over budget: switch to partitioning and redistribute what was read so far.
+  for (size_t i = 0; i < SPILL_FANOUT; i++) {
+    spill_partitions_.push_back(
+        SpilledPartition{std::make_unique<SpillFile>(bpm), std::make_unique<SpillFile>(bpm), 0});
+  }
+  auto tuples = std::move(resident_tuples_);
+  resident_tuples_.clear();
+  resident_memory_ = 0;
+  for (auto &resident_tuple : tuples) {
+    auto resident_hash = PartitionedJoinHashTable::HashKey(EvaluateKey(resident_tuple, false));
+    RouteBuildTuple(std::move(resident_tuple), *resident_hash);
+  }
+}
+
+void HashJoinExecutor::RouteBuildTuple(Tuple &&tuple, hash_t hash) {
+  auto partition_idx = SpillPartitionOf(hash, 0);
+  if (partition_idx != 0 || !partition0_resident_) {
+    spill_partitions_[partition_idx].build_->Append(tuple);
+    return;
+  }
+
+  resident_memory_ += EstimateBuildMemory(tuple.GetLength(), 1);
+  resident_tuples_.emplace_back(std::move(tuple));
+  if (resident_memory_ > exec_ctx_->GetMemoryBudget()) {
+    // Partition 0 does not fit either, spill it as well.
+    for (const auto &resident_tuple : resident_tuples_) {
+      spill_partitions_[0].build_->Append(resident_tuple);
+    }
+    resident_tuples_.clear();
+    resident_memory_ = 0;
+    partition0_resident_ = false;
+  }
+}
+
+void HashJoinExecutor::CollectFilterKey(const std::vector<Value> &key, hash_t hash) {
+  if (filter_key_min_.empty()) {
+    filter_key_min_ = key;
+    filter_key_max_ = key;
+  } else {
+    for (size_t i = 0; i < key.size(); i++) {
+      if (key[i].CompareLessThan(filter_key_min_[i]) == CmpBool::CmpTrue) {
+        filter_key_min_[i] = key[i];
+      } else if (key[i].CompareGreaterThan(filter_key_max_[i]) == CmpBool::CmpTrue) {
+        filter_key_max_[i] = key[i];
+      }
+    }
+  }
+  if (filter_hashes_overflow_) {
+    return;
+  }
+  if (filter_hashes_.size() == MAX_BLOOM_FILTER_KEYS) {
+    filter_hashes_overflow_ = true;
+    filter_hashes_ = std::vector<hash_t>{};
+    return;
+  }
+  filter_hashes_.push_back(hash);
+}
+
+void HashJoinExecutor::PushDownJoinKeyFilter() {
+  std::unique_ptr<BlockedBloomFilter> bloom_filter;
+  if (!filter_hashes_overflow_) {
+    bloom_filter = std::make_unique<BlockedBloomFilter>(filter_hashes_.size());
+    for (auto hash : filter_hashes_) {
+      bloom_filter->Insert(hash);
+    }
+  }
+  filter_hashes_ = std::vector<hash_t>{};
+  left_executor_->PushDownRuntimeFilter(std::make_shared<JoinKeyFilter>(
+      plan_->LeftJoinKeyExpressions(), std::move(filter_key_min_), std::move(filter_key_max_), std::move(bloom_filter)));
+  filter_key_min_.clear();
+  filter_key_max_.clear();
+}
+
+auto HashJoinExecutor::NextProbeTuple() -> bool {
+  while (true) {
+    if (probe_reader_.has_value()) {
+      if (probe_reader_->Next(&probe_tuple_)) {
+        return true;
+      }
+      probe_reader_.reset();
+      current_partition_.reset();
+      if (!LoadNextPartition()) {
+        return false;
+      }
+      continue;
+    }
+    if (left_done_) {
+      return false;
+    }
+    if (left_idx_ < left_batch_.Size()) {
+      probe_tuple_ = std::move(left_batch_.GetTuple(left_idx_++));
+      return true;
+    }
+    if (left_executor_->NextBatch(&left_batch_)) {
+      left_idx_ = 0;
+      continue;
+    }
+
+    // The left child is exhausted, join the spilled partitions.
+    left_done_ = true;
+    for (auto &partition : spill_partitions_) {
+      partition.probe_->Finish();
+      pending_partitions_.emplace_back(std::move(partition));
+    }
+    spill_partitions_.clear();
+    if (!LoadNextPartition()) {
+      return false;
+    }
+  }
+}
+
+auto HashJoinExecutor::LoadNextPartition() -> bool {
+  while (!pending_partitions_.empty()) {
+    auto partition = std::move(pending_partitions_.back());
+    pending_partitions_.pop_back();
+    if (partition.probe_->Size() == 0 ||
+        (partition.build_->Size() == 0 && plan_->GetJoinType() == JoinType::INNER)) {
+      // Nothing can come out of this partition.
+      continue;
+    }
+
+    auto build_memory = EstimateBuildMemory(partition.build_->GetDataSize(), partition.build_->Size());
+    if (build_memory > exec_ctx_->GetMemoryBudget() && partition.level_ < MAX_SPILL_LEVEL) {
+      // Still too large, split both sides on the next bits of the hash.
+      auto *bpm = exec_ctx_->GetBufferPoolManager();
+      auto level = partition.level_ + 1;
+      std::vector<SpilledPartition> children;
+      for (size_t i = 0; i < SPILL_FANOUT; i++) {
+        children.push_back(
+            SpilledPartition{std::make_unique<SpillFile>(bpm), std::make_unique<SpillFile>(bpm), level});
+      }
+      Tuple tuple;
+      for (auto [file, is_left] : {std::make_pair(partition.build_.get(), false),
+                                   std::make_pair(partition.probe_.get(), true)}) {
+        auto reader = file->MakeReader();
+        while (reader.Next(&tuple)) {
+          auto hash = PartitionedJoinHashTable::HashKey(EvaluateKey(tuple, is_left));
+          BUSTUB_ASSERT(hash.has_value(), "null keys are never spilled");
+          auto &child = children[SpillPartitionOf(*hash, level)];
+          (is_left ? child.probe_ : child.build_)->Append(tuple);
+        }
+      }
+      for (auto &child : children) {
+        child.build_->Finish();
+        child.probe_->Finish();
+        pending_partitions_.emplace_back(std::move(child));
+      }
+      continue;
+    }
+
+    std::vector<Tuple> build_tuples;
+    build_tuples.reserve(partition.build_->Size());
+    auto reader = partition.build_->MakeReader();
+    Tuple tuple;
+    while (reader.Next(&tuple)) {
+      build_tuples.emplace_back(std::move(tuple));
+    }
+    hash_table_.Build(std::move(build_tuples), exec_ctx_->GetTaskScheduler());
+    current_partition_ = std::move(partition);
+    probe_reader_.emplace(current_partition_->probe_->MakeReader());
+    return true;
+  }
+  return false;
+}
+
+void HashJoinExecutor::ProbeTuple() {
+  auto key = EvaluateKey(probe_tuple_, true);
+  matches_.clear();
+  match_idx_ = 0;
+  if (auto hash = PartitionedJoinHashTable::HashKey(key); hash.has_value()) {
+    if (!current_partition_.has_value() && !spill_partitions_.empty()) {
+      auto partition_idx = SpillPartitionOf(*hash, 0);
+      if (partition_idx != 0 || !partition0_resident_) {
+        // The matches are in a spilled partition, join this tuple later.
+        spill_partitions_[partition_idx].probe_->Append(probe_tuple_);
+        return;
+      }
+    }
+    hash_table_.Probe(key, *hash, &matches_);
+  }
+  if (matches_.empty() && plan_->GetJoinType() == JoinType::LEFT) {
+    matches_.push_back(nullptr);
+  }
+}
+
+auto HashJoinExecutor::MakeOutputTuple(const Tuple &left_tuple, const Tuple *right_tuple) const -> Tuple {
+  const auto &left_schema = left_executor_->GetOutputSchema();
+  const auto &right_schema = right_executor_->GetOutputSchema();
+  std::vector<Value> values;
+  values.reserve(GetOutputSchema().GetColumnCount());
+  for (uint32_t i = 0; i < left_schema.GetColumnCount(); i++) {
+    values.emplace_back(left_tuple.GetValue(&left_schema, i));
+  }
+  for (uint32_t i = 0; i < right_schema.GetColumnCount(); i++) {
+    values.emplace_back(right_tuple == nullptr ? ValueFactory::GetNullValueByType(right_schema.GetColumn(i).GetType())
+                                               : right_tuple->GetValue(&right_schema, i));
+  }
+  return Tuple{values, &GetOutputSchema()};
+}
+
+auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (true) {
+    if (match_idx_ < matches_.size()) {
+      *tuple = MakeOutputTuple(probe_tuple_, matches_[match_idx_++]);
+      return true;
+    }
+    if (!NextProbeTuple()) {
+      return false;
+    }
+    ProbeTuple();
+  }
+}
 
-auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto HashJoinExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Clear();
+  while (!batch->IsFull()) {
+    if (match_idx_ < matches_.size()) {
+      for (; !batch->IsFull() && match_idx_ < matches_.size(); match_idx_++) {
+        auto [tuple, rid] = batch->AppendSlot();
+        *tuple = MakeOutputTuple(probe_tuple_, matches_[match_idx_]);
+        *rid = RID{};
+      }
+      continue;
+    }
+    if (!NextProbeTuple()) {
+      break;
+    }
+    ProbeTuple();
+  }
+  return !batch->IsEmpty();
+}
 
 }  // namespace bustub
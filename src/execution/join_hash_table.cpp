@@ -0,0 +1,155 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// join_hash_table.cpp
+//
+// Identification: src/execution/join_hash_table.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/join_hash_table.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+PartitionedJoinHashTable::PartitionedJoinHashTable(std::vector<AbstractExpressionRef> key_exprs, const Schema *schema)
+    : key_exprs_(std::move(key_exprs)), schema_(schema) {}
+
+auto PartitionedJoinHashTable::EvaluateKey(const Tuple &tuple) const -> std::vector<Value> {
+  std::vector<Value> key;
+  key.reserve(key_exprs_.size());
+  for (const auto &expr : key_exprs_) {
+    key.emplace_back(expr->Evaluate(&tuple, *schema_));
+  }
+  return key;
+}
+
+auto PartitionedJoinHashTable::HashKey(const std::vector<Value> &key) -> std::optional<hash_t> {
+  hash_t hash = 0;
+  for (const auto &value : key) {
+    if (value.IsNull()) {
+      return std::nullopt;
+    }
+    hash = HashUtil::CombineHashes(hash, HashUtil::HashValue(&value));
+  }
+  // The high bits pick the partition.
+  return HashUtil::Mix(hash);
+}
+
+void PartitionedJoinHashTable::Build(std::vector<Tuple> tuples, TaskScheduler *scheduler) {
+  BUSTUB_ENSURE(tuples.size() < UINT32_MAX, "too many tuples on the build side of a hash join");
+  tuples_ = std::move(tuples);
+  keys_.clear();
+  keys_.resize(tuples_.size());
+  hashes_.clear();
+  hashes_.resize(tuples_.size());
+
+  // Aim for TARGET_PARTITION_SIZE tuples per partition.
+  radix_bits_ = 0;
+  while (radix_bits_ < MAX_RADIX_BITS && (tuples_.size() >> radix_bits_) > TARGET_PARTITION_SIZE) {
+    radix_bits_++;
+  }
+  size_t num_partitions = static_cast<size_t>(1) << radix_bits_;
+  size_t num_slots = scheduler == nullptr ? 1 : scheduler->GetSlotCount();
+  size_t num_chunks = (tuples_.size() + SCATTER_CHUNK_SIZE - 1) / SCATTER_CHUNK_SIZE;
+
+  // Phase 1: hash every build tuple and scatter its position into the partition lists of the executing thread.
+  std::vector<std::vector<std::vector<uint32_t>>> scattered(num_slots,
+                                                            std::vector<std::vector<uint32_t>>(num_partitions));
+  auto scatter = [&](size_t chunk_idx, size_t slot) {
+    auto &local = scattered[slot];
+    size_t end = std::min(tuples_.size(), (chunk_idx + 1) * SCATTER_CHUNK_SIZE);
+    for (size_t i = chunk_idx * SCATTER_CHUNK_SIZE; i < end; i++) {
+      keys_[i] = EvaluateKey(tuples_[i]);
+      auto hash = HashKey(keys_[i]);
+      if (!hash.has_value()) {
+        continue;
+      }
+      hashes_[i] = *hash;
+      local[PartitionOf(*hash)].push_back(i);
+    }
+  };
+
+  // Phase 2: build every partition from the lists gathered by all threads.
+  partitions_.clear();
+  partitions_.resize(num_partitions);
+  auto build = [&](size_t partition_idx, size_t) {
+    std::vector<uint32_t> tuple_idxs;
+    for (auto &local : scattered) {
+      auto &list = local[partition_idx];
+      tuple_idxs.insert(tuple_idxs.end(), list.begin(), list.end());
+      std::vector<uint32_t>{}.swap(list);
+    }
+    BuildPartition(&partitions_[partition_idx], std::move(tuple_idxs));
+  };
+
+  if (scheduler == nullptr) {
+    for (size_t i = 0; i < num_chunks; i++) {
+      scatter(i, 0);
+    }
+    for (size_t i = 0; i < num_partitions; i++) {
+      build(i, 0);
+    }
+  } else {
+    scheduler->ParallelFor(num_chunks, scatter);
+    scheduler->ParallelFor(num_partitions, build);
+  }
+
+  num_entries_ = 0;
+  for (const auto &partition : partitions_) {
+    num_entries_ += partition.entries_.size();
+  }
+}
+
+void PartitionedJoinHashTable::BuildPartition(Partition *partition, std::vector<uint32_t> tuple_idxs) {
+  // Chunks were processed by arbitrary threads, restore the build order so that probes return matches in that order.
+  std::sort(tuple_idxs.begin(), tuple_idxs.end());
+
+  size_t num_buckets = 1;
+  while (num_buckets < tuple_idxs.size() * 2 && num_buckets < (static_cast<size_t>(1) << BUCKET_HASH_BITS)) {
+    num_buckets <<= 1;
+  }
+  partition->buckets_.assign(num_buckets, 0);
+  partition->entries_.resize(tuple_idxs.size());
+  // Insert at the head of the chains in reverse, so that a chain lists its entries in build order.
+  for (size_t i = tuple_idxs.size(); i > 0; i--) {
+    auto entry_idx = i - 1;
+    auto hash = hashes_[tuple_idxs[entry_idx]];
+    auto &head = partition->buckets_[hash & (num_buckets - 1)];
+    partition->entries_[entry_idx] = Entry{hash, tuple_idxs[entry_idx], head};
+    head = entry_idx + 1;
+  }
+}
+
+void PartitionedJoinHashTable::Probe(const std::vector<Value> &key, hash_t hash,
+                                     std::vector<const Tuple *> *matches) const {
+  if (partitions_.empty()) {
+    return;
+  }
+  const auto &partition = partitions_[PartitionOf(hash)];
+  auto next = partition.buckets_[hash & (partition.buckets_.size() - 1)];
+  while (next != 0) {
+    const auto &entry = partition.entries_[next - 1];
+    next = entry.next_;
+    if (entry.hash_ != hash) {
+      continue;
+    }
+    const auto &build_key = keys_[entry.tuple_idx_];
+    bool equal = true;
+    for (size_t i = 0; i < key.size() && equal; i++) {
+      equal = key[i].CompareEquals(build_key[i]) == CmpBool::CmpTrue;
+    }
+    if (equal) {
+      matches->push_back(&tuples_[entry.tuple_idx_]);
+    }
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,181 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_executor.cpp
+//
+// Identification: src/execution/merge_join_executor.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/merge_join_executor.h"
+
+#include <algorithm>
+
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** @return the ascending ORDER BY on the key expressions, to compare keys the way the children were sorted */
+auto AscendingOrderBys(const std::vector<AbstractExpressionRef> &key_exprs) -> OrderBys {
+  OrderBys order_bys;
+  order_bys.reserve(key_exprs.size());
+  for (const auto &expr : key_exprs) {
+    order_bys.emplace_back(OrderByType::ASC, expr);
+  }
+  return order_bys;
+}
+
+}  // namespace
+
+MergeJoinExecutor::MergeJoinExecutor(ExecutorContext *exec_ctx, const MergeJoinPlanNode *plan,
+                                     std::unique_ptr<AbstractExecutor> &&left_child,
+                                     std::unique_ptr<AbstractExecutor> &&right_child)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_child)),
+      right_executor_(std::move(right_child)),
+      comparator_(AscendingOrderBys(plan->LeftJoinKeyExpressions())) {
+  if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
+    throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
+  }
+}
+
+void MergeJoinExecutor::Init() {
+  left_executor_->Init();
+  right_executor_->Init();
+
+  left_batch_.Clear();
+  left_idx_ = 0;
+  right_batch_.Clear();
+  right_idx_ = 0;
+  right_done_ = false;
+  right_key_valid_ = false;
+  run_.clear();
+  run_key_.clear();
+  matches_.clear();
+  match_idx_ = 0;
+}
+
+auto MergeJoinExecutor::EvaluateKey(const Tuple &tuple, bool is_left) const -> std::vector<Value> {
+  const auto &exprs = is_left ? plan_->LeftJoinKeyExpressions() : plan_->RightJoinKeyExpressions();
+  const auto &schema = is_left ? left_executor_->GetOutputSchema() : right_executor_->GetOutputSchema();
+  std::vector<Value> key;
+  key.reserve(exprs.size());
+  for (const auto &expr : exprs) {
+    key.emplace_back(expr->Evaluate(&tuple, schema));
+  }
+  return key;
+}
+
+auto MergeJoinExecutor::HasNull(const std::vector<Value> &key) -> bool {
+  return std::any_of(key.begin(), key.end(), [](const Value &value) { return value.IsNull(); });
+}
+
+auto MergeJoinExecutor::NextLeftTuple() -> bool {
+  while (left_idx_ >= left_batch_.Size()) {
+    if (!left_executor_->NextBatch(&left_batch_)) {
+      return false;
+    }
+    left_idx_ = 0;
+  }
+  left_tuple_ = std::move(left_batch_.GetTuple(left_idx_++));
+  left_key_ = EvaluateKey(left_tuple_, true);
+  return true;
+}
+
+auto MergeJoinExecutor::PeekRightTuple() -> bool {
+  if (right_key_valid_) {
+    return true;
+  }
+  while (right_idx_ >= right_batch_.Size()) {
+    if (right_done_ || !right_executor_->NextBatch(&right_batch_)) {
+      right_done_ = true;
+      return false;
+    }
+    right_idx_ = 0;
+  }
+  right_key_ = EvaluateKey(right_batch_.GetTuple(right_idx_), false);
+  right_key_valid_ = true;
+  return true;
+}
+
+void MergeJoinExecutor::MatchLeftTuple() {
+  matches_.clear();
+  match_idx_ = 0;
+  if (!HasNull(left_key_)) {
+    if (run_.empty() || comparator_.Compare(left_key_, run_key_) != 0) {
+      // The left keys are ascending, so the current run is behind: skip the smaller right keys, and read the run of
+      // the left key if there is one.
+      run_.clear();
+      while (PeekRightTuple() && comparator_.Compare(right_key_, left_key_) < 0) {
+        right_idx_++;
+        right_key_valid_ = false;
+      }
+      while (PeekRightTuple() && comparator_.Compare(right_key_, left_key_) == 0) {
+        run_.emplace_back(std::move(right_batch_.GetTuple(right_idx_++)));
+        right_key_valid_ = false;
+      }
+      run_key_ = left_key_;
+    }
+    for (const auto &right_tuple : run_) {
+      matches_.push_back(&right_tuple);
+    }
+  }
+  if (matches_.empty() && plan_->GetJoinType() == JoinType::LEFT) {
+    matches_.push_back(nullptr);
+  }
+}
+
+auto MergeJoinExecutor::MakeOutputTuple(const Tuple &left_tuple, const Tuple *right_tuple) const -> Tuple {
+  const auto &left_schema = left_executor_->GetOutputSchema();
+  const auto &right_schema = right_executor_->GetOutputSchema();
+  std::vector<Value> values;
+  values.reserve(GetOutputSchema().GetColumnCount());
+  for (uint32_t i = 0; i < left_schema.GetColumnCount(); i++) {
+    values.emplace_back(left_tuple.GetValue(&left_schema, i));
+  }
+  for (uint32_t i = 0; i < right_schema.GetColumnCount(); i++) {
+    values.emplace_back(right_tuple == nullptr ? ValueFactory::GetNullValueByType(right_schema.GetColumn(i).GetType())
+                                               : right_tuple->GetValue(&right_schema, i));
+  }
+  return Tuple{values, &GetOutputSchema()};
+}
+
+auto MergeJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (true) {
+    if (match_idx_ < matches_.size()) {
+      *tuple = MakeOutputTuple(left_tuple_, matches_[match_idx_++]);
+      return true;
+    }
+    if (!NextLeftTuple()) {
+      return false;
+    }
+    MatchLeftTuple();
+  }
+}
+
+auto MergeJoinExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Clear();
+  while (!batch->IsFull()) {
+    if (match_idx_ < matches_.size()) {
+      for (; !batch->IsFull() && match_idx_ < matches_.size(); match_idx_++) {
+        auto [tuple, rid] = batch->AppendSlot();
+        *tuple = MakeOutputTuple(left_tuple_, matches_[match_idx_]);
+        *rid = RID{};
+      }
+      continue;
+    }
+    if (!NextLeftTuple()) {
+      break;
+    }
+    MatchLeftTuple();
+  }
+  return !batch->IsEmpty();
+}
+
+}  // namespace bustub
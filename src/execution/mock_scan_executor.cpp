@@ -13,6 +13,7 @@
 #include "execution/executors/mock_scan_executor.h"
 #include <algorithm>
 #include <random>
+#include <utility>
 
 #include "common/exception.h"
 #include "common/util/string_util.h"
@@ -412,21 +413,36 @@ MockScanExecutor::MockScanExecutor(ExecutorContext *exec_ctx, const MockScanPlan
 void MockScanExecutor::Init() {
   // Reset the cursor
   cursor_ = 0;
+  runtime_filters_.clear();
 }
 
 auto MockScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (cursor_ == size_) {
-    // Scan complete
-    return EXECUTOR_EXHAUSTED;
-  }
-  if (shuffled_idx_.empty()) {
-    *tuple = func_(cursor_);
-  } else {
-    *tuple = func_(shuffled_idx_[cursor_]);
-  }
-  ++cursor_;
-  *rid = MakeDummyRID();
-  return EXECUTOR_ACTIVE;
+  while (cursor_ < size_) {
+    if (shuffled_idx_.empty()) {
+      *tuple = func_(cursor_);
+    } else {
+      *tuple = func_(shuffled_idx_[cursor_]);
+    }
+    ++cursor_;
+    if (CheckRuntimeFilters(runtime_filters_, *tuple, GetOutputSchema())) {
+      *rid = MakeDummyRID();
+      return EXECUTOR_ACTIVE;
+    }
+  }
+  // Scan complete
+  return EXECUTOR_EXHAUSTED;
+}
+
+auto MockScanExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Clear();
+  while (!batch->IsFull() && cursor_ < size_) {
+    auto tuple = shuffled_idx_.empty() ? func_(cursor_) : func_(shuffled_idx_[cursor_]);
+    ++cursor_;
+    if (CheckRuntimeFilters(runtime_filters_, tuple, GetOutputSchema())) {
+      batch->Append(std::move(tuple), MakeDummyRID());
+    }
+  }
+  return batch->IsEmpty() ? EXECUTOR_EXHAUSTED : EXECUTOR_ACTIVE;
 }
 
 auto MockScanExecutor::MakeDummyRID() -> RID { return RID{0}; }
@@ -12,19 +12,124 @@
 
 #include "execution/executors/nested_index_join_executor.h"
 
+#include "type/value_factory.h"
+
 namespace bustub {
 
 NestIndexJoinExecutor::NestIndexJoinExecutor(ExecutorContext *exec_ctx, const NestedIndexJoinPlanNode *plan,
                                              std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_executor_(std::move(child_executor)),
+      index_info_(exec_ctx->GetCatalog()->GetIndex(plan->GetIndexOid())),
+      table_info_(exec_ctx->GetCatalog()->GetTable(plan->GetInnerTableOid())) {
   if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
     // Note for 2023 Spring: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
-void NestIndexJoinExecutor::Init() { throw NotImplementedException("NestIndexJoinExecutor is not implemented"); }
+void NestIndexJoinExecutor::Init() {
+  child_executor_->Init();
+  outer_batch_.Clear();
+  matches_.clear();
+  outer_idx_ = 0;
+  match_idx_ = 0;
+  outer_matched_ = false;
+  output_.Clear();
+  output_idx_ = 0;
+}
+
+auto NestIndexJoinExecutor::ProbeNextBatch() -> bool {
+  // Reset the cursor first: an exhausted child leaves the outer batch empty, and the cursor must stay at its end.
+  outer_idx_ = 0;
+  match_idx_ = 0;
+  outer_matched_ = false;
+  if (!child_executor_->NextBatch(&outer_batch_)) {
+    return false;
+  }
+  const auto &outer_schema = child_executor_->GetOutputSchema();
+  auto *key_schema = index_info_->index_->GetKeySchema();
+  std::vector<Tuple> keys;
+  std::vector<size_t> key_owner;
+  keys.reserve(outer_batch_.Size());
+  for (size_t i = 0; i < outer_batch_.Size(); i++) {
+    auto value = plan_->KeyPredicate()->Evaluate(&outer_batch_.GetTuple(i), outer_schema);
+    // A null key never matches.
+    if (!value.IsNull()) {
+      keys.emplace_back(std::vector<Value>{value}, key_schema);
+      key_owner.push_back(i);
+    }
+  }
+
+  std::vector<std::vector<RID>> results;
+  index_info_->index_->ScanKeys(keys, &results, exec_ctx_->GetTransaction());
+  matches_.assign(outer_batch_.Size(), {});
+  for (size_t i = 0; i < keys.size(); i++) {
+    matches_[key_owner[i]] = std::move(results[i]);
+  }
+  return true;
+}
+
+auto NestIndexJoinExecutor::MakeOutputTuple(const Tuple &outer_tuple, const Tuple *inner_tuple) const -> Tuple {
+  const auto &outer_schema = child_executor_->GetOutputSchema();
+  const auto &inner_schema = plan_->InnerTableSchema();
+  std::vector<Value> values;
+  values.reserve(GetOutputSchema().GetColumnCount());
+  for (uint32_t i = 0; i < outer_schema.GetColumnCount(); i++) {
+    values.emplace_back(outer_tuple.GetValue(&outer_schema, i));
+  }
+  for (uint32_t i = 0; i < inner_schema.GetColumnCount(); i++) {
+    values.emplace_back(inner_tuple == nullptr ? ValueFactory::GetNullValueByType(inner_schema.GetColumn(i).GetType())
+                                               : inner_tuple->GetValue(&inner_schema, i));
+  }
+  return Tuple{values, &GetOutputSchema()};
+}
 
-auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (output_idx_ == output_.Size()) {
+    output_idx_ = 0;
+    if (!NextBatch(&output_)) {
+      return false;
+    }
+  }
+  *rid = output_.GetRID(output_idx_);
+  *tuple = std::move(output_.GetTuple(output_idx_++));
+  return true;
+}
+
+auto NestIndexJoinExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Clear();
+  while (!batch->IsFull()) {
+    if (outer_idx_ == outer_batch_.Size()) {
+      if (!ProbeNextBatch()) {
+        break;
+      }
+      continue;
+    }
+
+    const auto &outer_tuple = outer_batch_.GetTuple(outer_idx_);
+    const auto &rids = matches_[outer_idx_];
+    if (match_idx_ < rids.size()) {
+      auto [meta, inner_tuple] = table_info_->table_->GetTuple(rids[match_idx_++]);
+      if (!meta.is_deleted_) {
+        auto [tuple, rid] = batch->AppendSlot();
+        *tuple = MakeOutputTuple(outer_tuple, &inner_tuple);
+        *rid = RID{};
+        outer_matched_ = true;
+      }
+      continue;
+    }
+    if (!outer_matched_ && plan_->GetJoinType() == JoinType::LEFT) {
+      auto [tuple, rid] = batch->AppendSlot();
+      *tuple = MakeOutputTuple(outer_tuple, nullptr);
+      *rid = RID{};
+    }
+    outer_idx_++;
+    match_idx_ = 0;
+    outer_matched_ = false;
+  }
+  return !batch->IsEmpty();
+}
 
 }  // namespace bustub
@@ -13,21 +13,172 @@
 #include "execution/executors/nested_loop_join_executor.h"
 #include "binder/table_ref/bound_join_ref.h"
 #include "common/exception.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 
 NestedLoopJoinExecutor::NestedLoopJoinExecutor(ExecutorContext *exec_ctx, const NestedLoopJoinPlanNode *plan,
                                                std::unique_ptr<AbstractExecutor> &&left_executor,
                                                std::unique_ptr<AbstractExecutor> &&right_executor)
-    : AbstractExecutor(exec_ctx) {
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_executor)),
+      right_executor_(std::move(right_executor)),
+      program_(ExpressionProgram::CompileJoin(plan->Predicate(), left_executor_->GetOutputSchema(),
+                                              right_executor_->GetOutputSchema())) {
   if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
     // Note for 2023 Spring: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
-void NestedLoopJoinExecutor::Init() { throw NotImplementedException("NestedLoopJoinExecutor is not implemented"); }
+void NestedLoopJoinExecutor::Init() {
+  left_executor_->Init();
+  left_batch_.Clear();
+  left_idx_ = 0;
+  left_done_ = false;
+  block_.clear();
+  block_matched_.clear();
+  block_loaded_ = false;
+  block_count_ = 0;
+  next_batch_.Clear();
+}
+
+auto NestedLoopJoinExecutor::LoadBlock() -> bool {
+  block_.clear();
+  size_t block_memory = 0;
+  // A block holds at least one tuple, however small the budget.
+  while (block_.empty() || block_memory < exec_ctx_->GetMemoryBudget()) {
+    if (left_idx_ == left_batch_.Size()) {
+      left_idx_ = 0;
+      if (left_done_ || !left_executor_->NextBatch(&left_batch_)) {
+        left_batch_.Clear();
+        left_done_ = true;
+        break;
+      }
+    }
+    auto &tuple = left_batch_.GetTuple(left_idx_++);
+    block_memory += sizeof(Tuple) + tuple.GetLength();
+    block_.emplace_back(std::move(tuple));
+  }
+  if (block_.empty()) {
+    return false;
+  }
+
+  block_matched_.assign(block_.size(), false);
+  block_loaded_ = true;
+  block_count_++;
+  right_executor_->Init();
+  right_batch_.Clear();
+  right_idx_ = 0;
+  block_idx_ = 0;
+  right_selected_ = false;
+  right_done_ = false;
+  unmatched_idx_ = 0;
+  return true;
+}
+
+auto NestedLoopJoinExecutor::Matches(const Tuple &left_tuple, const Tuple &right_tuple) const -> bool {
+  auto value = plan_->Predicate()->EvaluateJoin(&left_tuple, left_executor_->GetOutputSchema(), &right_tuple,
+                                                right_executor_->GetOutputSchema());
+  return !value.IsNull() && value.GetAs<bool>();
+}
 
-auto NestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto NestedLoopJoinExecutor::MakeOutputTuple(const Tuple &left_tuple, const Tuple *right_tuple) const -> Tuple {
+  const auto &left_schema = left_executor_->GetOutputSchema();
+  const auto &right_schema = right_executor_->GetOutputSchema();
+  std::vector<Value> values;
+  values.reserve(GetOutputSchema().GetColumnCount());
+  for (uint32_t i = 0; i < left_schema.GetColumnCount(); i++) {
+    values.emplace_back(left_tuple.GetValue(&left_schema, i));
+  }
+  for (uint32_t i = 0; i < right_schema.GetColumnCount(); i++) {
+    values.emplace_back(right_tuple == nullptr ? ValueFactory::GetNullValueByType(right_schema.GetColumn(i).GetType())
+                                               : right_tuple->GetValue(&right_schema, i));
+  }
+  return Tuple{values, &GetOutputSchema()};
+}
+
+auto NestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (!NextBatch(&next_batch_)) {
+    return false;
+  }
+  *tuple = std::move(next_batch_.GetTuple(0));
+  *rid = RID{};
+  return true;
+}
+
+auto NestedLoopJoinExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Clear();
+  while (!batch->IsFull()) {
+    if (!block_loaded_) {
+      if (!LoadBlock()) {
+        break;
+      }
+      continue;
+    }
+
+    if (right_idx_ < right_batch_.Size()) {
+      // Join the current right tuple with the rest of the block.
+      const auto &right_tuple = right_batch_.GetTuple(right_idx_);
+      if (program_.has_value()) {
+        if (!right_selected_) {
+          program_->Select(block_.data(), block_.size(), &right_tuple, &block_selection_);
+          right_selected_ = true;
+        }
+        for (; block_idx_ < block_selection_.size() && !batch->IsFull(); block_idx_++) {
+          auto left_idx = block_selection_[block_idx_];
+          block_matched_[left_idx] = true;
+          auto [tuple, rid] = batch->AppendSlot();
+          *tuple = MakeOutputTuple(block_[left_idx], &right_tuple);
+          *rid = RID{};
+        }
+        if (block_idx_ == block_selection_.size()) {
+          block_idx_ = 0;
+          right_selected_ = false;
+          right_idx_++;
+        }
+        continue;
+      }
+      for (; block_idx_ < block_.size() && !batch->IsFull(); block_idx_++) {
+        if (Matches(block_[block_idx_], right_tuple)) {
+          block_matched_[block_idx_] = true;
+          auto [tuple, rid] = batch->AppendSlot();
+          *tuple = MakeOutputTuple(block_[block_idx_], &right_tuple);
+          *rid = RID{};
+        }
+      }
+      if (block_idx_ == block_.size()) {
+        block_idx_ = 0;
+        right_idx_++;
+      }
+      continue;
+    }
+    if (!right_done_) {
+      right_idx_ = 0;
+      right_done_ = !right_executor_->NextBatch(&right_batch_);
+      if (right_done_) {
+        right_batch_.Clear();
+      }
+      continue;
+    }
+
+    // The right child is exhausted for this block: pad the left tuples that matched nothing.
+    if (plan_->GetJoinType() == JoinType::LEFT) {
+      for (; unmatched_idx_ < block_.size() && !batch->IsFull(); unmatched_idx_++) {
+        if (!block_matched_[unmatched_idx_]) {
+          auto [tuple, rid] = batch->AppendSlot();
+          *tuple = MakeOutputTuple(block_[unmatched_idx_], nullptr);
+          *rid = RID{};
+        }
+      }
+      if (unmatched_idx_ < block_.size()) {
+        continue;
+      }
+    }
+    block_loaded_ = false;
+  }
+  return !batch->IsEmpty();
+}
 
 }  // namespace bustub
@@ -74,7 +74,11 @@ auto AggregationPlanNode::InferAggSchema(const std::vector<AbstractExpressionRef
   }
   for (size_t idx = 0; idx < aggregates.size(); idx++) {
     // TODO(chi): correctly infer agg call return type
-    output.emplace_back(Column("<unnamed>", TypeId::INTEGER));
+    if (agg_types[idx] == AggregationType::AvgAggregate || agg_types[idx] == AggregationType::ApproxQuantileAggregate) {
+      output.emplace_back(Column("<unnamed>", TypeId::DECIMAL));
+    } else {
+      output.emplace_back(Column("<unnamed>", TypeId::INTEGER));
+    }
   }
   return Schema(output);
 }
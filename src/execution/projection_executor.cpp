@@ -1,11 +1,17 @@
 #include "execution/executors/projection_executor.h"
+
+#include <algorithm>
+
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 ProjectionExecutor::ProjectionExecutor(ExecutorContext *exec_ctx, const ProjectionPlanNode *plan,
                                        std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_executor_(std::move(child_executor)),
+      program_(ExpressionProgram::Compile(plan->GetExpressions(), child_executor_->GetOutputSchema())) {}
 
 void ProjectionExecutor::Init() {
   // Initialize the child executor
@@ -33,4 +39,43 @@ auto ProjectionExecutor::Next(Tuple *tuple, RID *rid) -> bool {
 
   return true;
 }
+
+auto ProjectionExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Clear();
+  if (child_batch_.Capacity() != batch->Capacity()) {
+    // Never pull more child tuples than the output batch can hold.
+    child_batch_ = TupleBatch{batch->Capacity()};
+  }
+  if (!child_executor_->NextBatch(&child_batch_)) {
+    return false;
+  }
+
+  const auto &exprs = plan_->GetExpressions();
+  const auto &child_schema = child_executor_->GetOutputSchema();
+  std::vector<Value> values{};
+  values.reserve(exprs.size());
+  if (program_.has_value()) {
+    for (size_t start = 0; start < child_batch_.Size(); start += ExpressionProgram::BATCH_SIZE) {
+      auto count = std::min(ExpressionProgram::BATCH_SIZE, child_batch_.Size() - start);
+      program_->Evaluate(&child_batch_.GetTuple(start), count);
+      for (size_t i = 0; i < count; i++) {
+        values.clear();
+        for (size_t expr_idx = 0; expr_idx < exprs.size(); expr_idx++) {
+          values.push_back(program_->GetValue(expr_idx, i));
+        }
+        batch->Append(Tuple{values, &GetOutputSchema()}, child_batch_.GetRID(start + i));
+      }
+    }
+    return true;
+  }
+  for (size_t i = 0; i < child_batch_.Size(); i++) {
+    values.clear();
+    for (const auto &expr : exprs) {
+      values.push_back(expr->Evaluate(&child_batch_.GetTuple(i), child_schema));
+    }
+    batch->Append(Tuple{values, &GetOutputSchema()}, child_batch_.GetRID(i));
+  }
+
+  return true;
+}
 }  // namespace bustub
@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// runtime_filter.cpp
+//
+// Identification: src/execution/runtime_filter.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/runtime_filter.h"
+
+#include <algorithm>
+
+#include "execution/expressions/column_value_expression.h"
+
+namespace bustub {
+
+auto ExpressionReadsOnlyLeadingColumns(const AbstractExpressionRef &expr, uint32_t num_columns) -> bool {
+  if (const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      column_value_expr != nullptr) {
+    return column_value_expr->GetColIdx() < num_columns;
+  }
+  return std::all_of(expr->GetChildren().begin(), expr->GetChildren().end(),
+                     [&](const auto &child) { return ExpressionReadsOnlyLeadingColumns(child, num_columns); });
+}
+
+BlockedBloomFilter::BlockedBloomFilter(size_t num_keys) {
+  constexpr size_t bits_per_block = sizeof(Block) * 8;
+  // The block index is computed from 32 bits of the hash.
+  auto num_blocks = std::min<size_t>((num_keys * BITS_PER_KEY + bits_per_block - 1) / bits_per_block, UINT32_MAX);
+  blocks_.resize(std::max<size_t>(num_blocks, 1), Block{});
+}
+
+auto BlockedBloomFilter::MaskOf(hash_t hash, size_t word) -> uint32_t {
+  // Odd multipliers spreading the low bits of the hash into a different bit of every word of the block.
+  static constexpr uint32_t SALTS[WORDS_PER_BLOCK] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                                      0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+  return 1U << ((static_cast<uint32_t>(hash) * SALTS[word]) >> 27);
+}
+
+void BlockedBloomFilter::Insert(hash_t hash) {
+  auto &block = blocks_[BlockIndexOf(hash)];
+  for (size_t i = 0; i < WORDS_PER_BLOCK; i++) {
+    block.words_[i] |= MaskOf(hash, i);
+  }
+}
+
+auto BlockedBloomFilter::MayContain(hash_t hash) const -> bool {
+  const auto &block = blocks_[BlockIndexOf(hash)];
+  for (size_t i = 0; i < WORDS_PER_BLOCK; i++) {
+    if ((block.words_[i] & MaskOf(hash, i)) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace bustub
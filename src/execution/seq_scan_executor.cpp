@@ -1,23 +1,154 @@
-//===----------------------------------------------------------------------===//
-//
-//                         BusTub
-//
-// seq_scan_executor.cpp
-//
-// Identification: src/execution/seq_scan_executor.cpp
-//
-// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
-//
-//===----------------------------------------------------------------------===//
-
-#include "execution/executors/seq_scan_executor.h"
-
-namespace bustub {
-
-SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan) : AbstractExecutor(exec_ctx) {}
-
-void SeqScanExecutor::Init() { throw NotImplementedException("SeqScanExecutor is not implemented"); }
-
-auto SeqScanExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
-
-}  // namespace bustub
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// seq_scan_executor.cpp
+//
+// Identification: src/execution/seq_scan_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/seq_scan_executor.h"
+
+#include <algorithm>
+
+namespace bustub {
+
+SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      table_info_(exec_ctx->GetCatalog()->GetTable(plan->GetTableOid())) {
+  if (plan->filter_predicate_ != nullptr) {
+    program_ = ExpressionProgram::CompilePredicate(plan->filter_predicate_, plan->OutputSchema());
+  }
+}
+
+void SeqScanExecutor::Init() {
+  iter_.reset();
+  morsels_.clear();
+  next_morsel_ = 0;
+  wave_.clear();
+  wave_idx_ = 0;
+  wave_tuple_idx_ = 0;
+  auto *scheduler = exec_ctx_->GetTaskScheduler();
+  if (scheduler != nullptr && scheduler->GetWorkerCount() > 0) {
+    morsels_ = table_info_->table_->MakeMorsels();
+    if (morsels_.size() <= 1) {
+      morsels_.clear();
+    }
+  }
+  if (morsels_.empty()) {
+    iter_.emplace(table_info_->table_->MakeIterator());
+  }
+  tasks_.assign(morsels_.empty() ? 1 : scheduler->GetSlotCount(), ScanTask{program_, {}, {}});
+  batch_.Clear();
+  batch_idx_ = 0;
+  runtime_filters_.clear();
+}
+
+auto SeqScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (batch_idx_ == batch_.Size()) {
+    batch_idx_ = 0;
+    if (!NextBatch(&batch_)) {
+      return false;
+    }
+  }
+  *rid = batch_.GetRID(batch_idx_);
+  *tuple = std::move(batch_.GetTuple(batch_idx_++));
+  return true;
+}
+
+auto SeqScanExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Clear();
+  if (morsels_.empty()) {
+    ReadTuples(&*iter_, batch, &tasks_[0]);
+    return !batch->IsEmpty();
+  }
+
+  while (!batch->IsFull()) {
+    if (wave_idx_ == wave_.size()) {
+      if (next_morsel_ == morsels_.size()) {
+        break;
+      }
+      ScanMorselWave();
+      continue;
+    }
+    auto &source = wave_[wave_idx_];
+    for (; !batch->IsFull() && wave_tuple_idx_ < source.Size(); wave_tuple_idx_++) {
+      batch->Append(std::move(source.GetTuple(wave_tuple_idx_)), source.GetRID(wave_tuple_idx_));
+    }
+    if (wave_tuple_idx_ == source.Size()) {
+      wave_idx_++;
+      wave_tuple_idx_ = 0;
+    }
+  }
+  return !batch->IsEmpty();
+}
+
+void SeqScanExecutor::ReadTuples(TableIterator *iter, TupleBatch *batch, ScanTask *task) const {
+  auto &tuples = task->tuples_;
+  while (!batch->IsFull() && !iter->IsEnd()) {
+    iter->ReadTupleRefs(batch->Capacity() - batch->Size(), &tuples);
+    if (task->program_.has_value()) {
+      task->program_->Select(tuples.data(), tuples.size(), nullptr, &task->selection_);
+      for (auto idx : task->selection_) {
+        AppendIfSelected(tuples[idx], false, batch);
+      }
+    } else {
+      for (const auto &tuple : tuples) {
+        AppendIfSelected(tuple, true, batch);
+      }
+    }
+  }
+  // Unlatch the last page read: a parent may write to it before asking for the next batch.
+  iter->ReleasePage();
+}
+
+void SeqScanExecutor::AppendIfSelected(const TupleRef &tuple, bool evaluate_predicate, TupleBatch *batch) const {
+  // Copy the tuple into the next slot of the batch, recycling its buffer, and take it back if it is filtered out.
+  auto [slot, rid] = batch->AppendSlot();
+  tuple.CopyTo(slot);
+  *rid = tuple.GetRid();
+  const auto &predicate = plan_->filter_predicate_;
+  if (evaluate_predicate && predicate != nullptr) {
+    auto value = predicate->Evaluate(slot, GetOutputSchema());
+    if (value.IsNull() || !value.GetAs<bool>()) {
+      batch->Truncate(batch->Size() - 1);
+      return;
+    }
+  }
+  // The filters are only read here, by the tasks of a parallel scan as well, and are safe to check concurrently.
+  if (!CheckRuntimeFilters(runtime_filters_, *slot, GetOutputSchema())) {
+    batch->Truncate(batch->Size() - 1);
+  }
+}
+
+void SeqScanExecutor::ScanMorselWave() {
+  auto *scheduler = exec_ctx_->GetTaskScheduler();
+  auto num_morsels = std::min(morsels_.size() - next_morsel_, scheduler->GetSlotCount());
+  std::vector<std::vector<TupleBatch>> outputs(num_morsels);
+  scheduler->ParallelFor(num_morsels, [&](size_t morsel_idx, size_t slot) {
+    auto iter = table_info_->table_->MakeMorselIterator(morsels_[next_morsel_ + morsel_idx]);
+    auto &batches = outputs[morsel_idx];
+    while (!iter.IsEnd()) {
+      if (batches.empty() || batches.back().IsFull()) {
+        batches.emplace_back();
+      }
+      ReadTuples(&iter, &batches.back(), &tasks_[slot]);
+    }
+  });
+  next_morsel_ += num_morsels;
+
+  wave_.clear();
+  wave_idx_ = 0;
+  wave_tuple_idx_ = 0;
+  for (auto &batches : outputs) {
+    for (auto &batch : batches) {
+      wave_.push_back(std::move(batch));
+    }
+  }
+}
+
+}  // namespace bustub
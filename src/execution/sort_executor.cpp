@@ -1,13 +1,215 @@
 #include "execution/executors/sort_executor.h"
 
+#include <algorithm>
+#include <utility>
+
 namespace bustub {
 
 SortExecutor::SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan,
                            std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_executor_(std::move(child_executor)),
+      comparator_(plan->GetOrderBy()),
+      normalizer_(plan->GetOrderBy()) {}
+
+void SortExecutor::Init() {
+  child_executor_->Init();
+  buffer_.clear();
+  buffer_memory_ = 0;
+  buffer_idx_ = 0;
+  runs_.clear();
+  merge_tree_.reset();
+  merge_sources_.clear();
+  merge_runs_.clear();
+
+  // Without a buffer pool there is nowhere to spill to, the whole input is sorted in memory.
+  bool can_spill = exec_ctx_->GetBufferPoolManager() != nullptr;
+  const auto &child_schema = child_executor_->GetOutputSchema();
+  TupleBatch batch{};
+  while (child_executor_->NextBatch(&batch)) {
+    for (size_t i = 0; i < batch.Size(); i++) {
+      auto &tuple = batch.GetTuple(i);
+      auto key = EvaluateSortKey(plan_->GetOrderBy(), tuple, child_schema);
+      auto &entry = buffer_.emplace_back(SortEntry{std::move(key), std::move(tuple)});
+      buffer_memory_ += EstimateMemory(entry);
+      if (can_spill && buffer_memory_ > exec_ctx_->GetMemoryBudget()) {
+        SpillRun();
+      }
+    }
+  }
+
+  if (runs_.empty()) {
+    SortBuffer();
+    return;
+  }
+  if (!buffer_.empty()) {
+    SpillRun();
+  }
+
+  // Every merge source buffers one page of tuples, merge as many runs at once as the budget allows.
+  auto max_fan_in = std::max<size_t>(2, exec_ctx_->GetMemoryBudget() / (4 * BUSTUB_PAGE_SIZE));
+  while (runs_.size() > max_fan_in) {
+    std::vector<std::unique_ptr<SpillFile>> merged_runs;
+    for (size_t begin = 0; begin < runs_.size(); begin += max_fan_in) {
+      auto end = std::min(runs_.size(), begin + max_fan_in);
+      StartMerge({std::make_move_iterator(runs_.begin() + begin), std::make_move_iterator(runs_.begin() + end)});
+      auto merged_run = std::make_unique<SpillFile>(exec_ctx_->GetBufferPoolManager());
+      SortEntry entry;
+      while (MergeNext(&entry)) {
+        merged_run->Append(entry.tuple_);
+      }
+      merged_run->Finish();
+      merged_runs.emplace_back(std::move(merged_run));
+    }
+    runs_ = std::move(merged_runs);
+  }
+  StartMerge(std::move(runs_));
+  runs_.clear();
+}
+
+auto SortExecutor::EstimateMemory(const SortEntry &entry) -> size_t {
+  return sizeof(SortEntry) + entry.tuple_.GetLength() + entry.key_.size() * sizeof(Value);
+}
+
+void SortExecutor::SortBuffer() {
+  auto num_tuples = buffer_.size();
+  if (num_tuples <= 1) {
+    return;
+  }
+  BUSTUB_ENSURE(num_tuples < UINT32_MAX, "too many tuples to sort in memory");
+  auto less = [this](const SortRef &lhs, const SortRef &rhs) {
+    auto cmp = lhs.normalized_key_.Compare(rhs.normalized_key_);
+    if (cmp == 0 && !normalizer_.IsExact()) {
+      cmp = comparator_.Compare(buffer_[lhs.idx_].key_, buffer_[rhs.idx_].key_);
+    }
+    // Ties are broken by position, which makes the sort stable.
+    return cmp < 0 || (cmp == 0 && lhs.idx_ < rhs.idx_);
+  };
+
+  // Split the input in chunks that are normalized and sorted in parallel.
+  auto *scheduler = exec_ctx_->GetTaskScheduler();
+  size_t num_chunks = 1;
+  if (scheduler != nullptr) {
+    num_chunks = std::max<size_t>(1, std::min(scheduler->GetSlotCount(), num_tuples / MIN_PARALLEL_SORT_CHUNK));
+  }
+  std::vector<size_t> bounds;
+  for (size_t i = 0; i <= num_chunks; i++) {
+    bounds.push_back(num_tuples * i / num_chunks);
+  }
+  std::vector<SortRef> refs(num_tuples);
+  auto sort_chunk = [&](size_t chunk_idx, size_t) {
+    for (auto i = bounds[chunk_idx]; i < bounds[chunk_idx + 1]; i++) {
+      normalizer_.Normalize(buffer_[i].key_, &refs[i].normalized_key_);
+      refs[i].idx_ = i;
+    }
+    std::sort(refs.begin() + bounds[chunk_idx], refs.begin() + bounds[chunk_idx + 1], less);
+  };
+
+  // Then merge the sorted chunks pairwise, each round merging all the pairs in parallel.
+  std::vector<SortRef> merged(num_chunks > 1 ? num_tuples : 0);
+  auto merge_pair = [&](size_t pair_idx, size_t) {
+    auto begin = bounds[2 * pair_idx];
+    auto middle = bounds[std::min(2 * pair_idx + 1, bounds.size() - 1)];
+    auto end = bounds[std::min(2 * pair_idx + 2, bounds.size() - 1)];
+    std::merge(refs.begin() + begin, refs.begin() + middle, refs.begin() + middle, refs.begin() + end,
+               merged.begin() + begin, less);
+  };
+
+  if (num_chunks == 1) {
+    sort_chunk(0, 0);
+  } else {
+    scheduler->ParallelFor(num_chunks, sort_chunk);
+    while (bounds.size() > 2) {
+      auto num_runs = bounds.size() - 1;
+      scheduler->ParallelFor((num_runs + 1) / 2, merge_pair);
+      refs.swap(merged);
+      std::vector<size_t> merged_bounds;
+      for (size_t i = 0; i < bounds.size(); i += 2) {
+        merged_bounds.push_back(bounds[i]);
+      }
+      if (merged_bounds.back() != num_tuples) {
+        merged_bounds.push_back(num_tuples);
+      }
+      bounds = std::move(merged_bounds);
+    }
+  }
+
+  std::vector<SortEntry> sorted;
+  sorted.reserve(num_tuples);
+  for (const auto &ref : refs) {
+    sorted.emplace_back(std::move(buffer_[ref.idx_]));
+  }
+  buffer_ = std::move(sorted);
+}
+
+void SortExecutor::SpillRun() {
+  SortBuffer();
+  auto run = std::make_unique<SpillFile>(exec_ctx_->GetBufferPoolManager());
+  for (const auto &entry : buffer_) {
+    run->Append(entry.tuple_);
+  }
+  run->Finish();
+  runs_.emplace_back(std::move(run));
+  buffer_.clear();
+  buffer_memory_ = 0;
+}
+
+auto SortExecutor::ReadEntry(SpillFile::Reader *reader, SortEntry *entry) const -> bool {
+  if (!reader->Next(&entry->tuple_)) {
+    return false;
+  }
+  entry->key_ = EvaluateSortKey(plan_->GetOrderBy(), entry->tuple_, child_executor_->GetOutputSchema());
+  return true;
+}
+
+auto SortExecutor::MergeSourceLess::operator()(size_t lhs, size_t rhs) const -> bool {
+  const auto &lhs_source = (*sources_)[lhs];
+  const auto &rhs_source = (*sources_)[rhs];
+  if (lhs_source.exhausted_ || rhs_source.exhausted_) {
+    return !lhs_source.exhausted_ && rhs_source.exhausted_;
+  }
+  auto cmp = comparator_->Compare(lhs_source.head_.key_, rhs_source.head_.key_);
+  return cmp < 0 || (cmp == 0 && lhs < rhs);
+}
+
+void SortExecutor::StartMerge(std::vector<std::unique_ptr<SpillFile>> runs) {
+  merge_tree_.reset();
+  merge_sources_.clear();
+  merge_runs_ = std::move(runs);
+  merge_sources_.reserve(merge_runs_.size());
+  for (const auto &run : merge_runs_) {
+    auto &source = merge_sources_.emplace_back(MergeSource{run->MakeReader(), SortEntry{}, false});
+    source.exhausted_ = !ReadEntry(&source.reader_, &source.head_);
+  }
+  merge_tree_.emplace(merge_sources_.size(), MergeSourceLess{&merge_sources_, &comparator_});
+}
 
-void SortExecutor::Init() { throw NotImplementedException("SortExecutor is not implemented"); }
+auto SortExecutor::MergeNext(SortEntry *entry) -> bool {
+  auto &source = merge_sources_[merge_tree_->Top()];
+  if (source.exhausted_) {
+    return false;
+  }
+  *entry = std::move(source.head_);
+  source.exhausted_ = !ReadEntry(&source.reader_, &source.head_);
+  merge_tree_->Replay();
+  return true;
+}
 
-auto SortExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto SortExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (merge_tree_.has_value()) {
+    SortEntry entry;
+    if (!MergeNext(&entry)) {
+      return false;
+    }
+    *tuple = std::move(entry.tuple_);
+    return true;
+  }
+  if (buffer_idx_ == buffer_.size()) {
+    return false;
+  }
+  *tuple = std::move(buffer_[buffer_idx_++].tuple_);
+  return true;
+}
 
 }  // namespace bustub
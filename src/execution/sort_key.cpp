@@ -0,0 +1,158 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key.cpp
+//
+// Identification: src/execution/sort_key.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/sort_key.h"
+
+#include <algorithm>
+
+#include "common/exception.h"
+
+namespace bustub {
+
+namespace {
+
+/** @return the number of bytes of the encoding of a non-null value, 0 for variable-length types */
+auto EncodedWidth(TypeId type) -> size_t {
+  switch (type) {
+    case TypeId::BOOLEAN:
+      return 1;
+    case TypeId::TINYINT:
+    case TypeId::SMALLINT:
+    case TypeId::INTEGER:
+    case TypeId::BIGINT:
+    case TypeId::DECIMAL:
+    case TypeId::TIMESTAMP:
+      return 8;
+    case TypeId::VARCHAR:
+      return 0;
+    default:
+      throw NotImplementedException("cannot sort on this type");
+  }
+}
+
+auto IsInteger(TypeId type) -> bool {
+  return type == TypeId::TINYINT || type == TypeId::SMALLINT || type == TypeId::INTEGER || type == TypeId::BIGINT;
+}
+
+void StoreBigEndian(uint64_t value, uint8_t *out) {
+  for (int i = 7; i >= 0; i--) {
+    out[i] = static_cast<uint8_t>(value);
+    value >>= 8;
+  }
+}
+
+auto IntegerBits(const Value &value) -> uint64_t {
+  int64_t raw = 0;
+  switch (value.GetTypeId()) {
+    case TypeId::TINYINT:
+      raw = value.GetAs<int8_t>();
+      break;
+    case TypeId::SMALLINT:
+      raw = value.GetAs<int16_t>();
+      break;
+    case TypeId::INTEGER:
+      raw = value.GetAs<int32_t>();
+      break;
+    default:
+      raw = value.GetAs<int64_t>();
+      break;
+  }
+  return static_cast<uint64_t>(raw) ^ (static_cast<uint64_t>(1) << 63);
+}
+
+auto DecimalBits(double raw) -> uint64_t {
+  if (raw == 0) {
+    // -0.0 and 0.0 compare equal.
+    raw = 0;
+  }
+  uint64_t bits;
+  memcpy(&bits, &raw, sizeof(bits));
+  return (bits >> 63) != 0 ? ~bits : bits | (static_cast<uint64_t>(1) << 63);
+}
+
+}  // namespace
+
+SortKeyNormalizer::SortKeyNormalizer(const OrderBys &order_bys) {
+  size_t size = 0;
+  for (const auto &[order_by_type, expr] : order_bys) {
+    auto type = expr->GetReturnType();
+    auto width = EncodedWidth(type);
+    if (width == 0) {
+      // A string takes whatever is left, and is likely to be truncated.
+      if (size + 1 < NORMALIZED_SORT_KEY_SIZE) {
+        columns_.push_back({type, order_by_type == OrderByType::DESC});
+      }
+      is_exact_ = false;
+      break;
+    }
+    if (size + 1 + width > NORMALIZED_SORT_KEY_SIZE) {
+      is_exact_ = false;
+      break;
+    }
+    columns_.push_back({type, order_by_type == OrderByType::DESC});
+    size += 1 + width;
+  }
+}
+
+void SortKeyNormalizer::Normalize(const std::vector<Value> &key, NormalizedSortKey *normalized_key) const {
+  auto *out = normalized_key->bytes_.data();
+  size_t pos = 0;
+  for (size_t i = 0; i < columns_.size(); i++) {
+    const auto &column = columns_[i];
+    size_t begin = pos;
+    const Value *value = &key[i];
+    Value cast_value;
+    if (!value->IsNull() && value->GetTypeId() != column.type_ &&
+        !(IsInteger(value->GetTypeId()) && IsInteger(column.type_))) {
+      cast_value = value->CastAs(column.type_);
+      value = &cast_value;
+    }
+
+    out[pos++] = value->IsNull() ? 0 : 1;
+    auto width = EncodedWidth(column.type_);
+    if (width == 0) {
+      // VARCHAR: the string bytes (without the terminating zero byte), zero-padded.
+      size_t len = 0;
+      if (!value->IsNull() && value->GetLength() > 0) {
+        len = std::min<size_t>(value->GetLength() - 1, NORMALIZED_SORT_KEY_SIZE - pos);
+        memcpy(out + pos, value->GetData(), len);
+      }
+      memset(out + pos + len, 0, NORMALIZED_SORT_KEY_SIZE - pos - len);
+      pos = NORMALIZED_SORT_KEY_SIZE;
+    } else if (value->IsNull()) {
+      memset(out + pos, 0, width);
+      pos += width;
+    } else if (column.type_ == TypeId::BOOLEAN) {
+      out[pos++] = value->GetAs<int8_t>() != 0 ? 1 : 0;
+    } else {
+      uint64_t bits;
+      if (column.type_ == TypeId::DECIMAL) {
+        bits = DecimalBits(value->GetAs<double>());
+      } else if (column.type_ == TypeId::TIMESTAMP) {
+        bits = value->GetAs<uint64_t>();
+      } else {
+        bits = IntegerBits(*value);
+      }
+      StoreBigEndian(bits, out + pos);
+      pos += width;
+    }
+
+    if (column.descending_) {
+      for (size_t j = begin; j < pos; j++) {
+        out[j] = ~out[j];
+      }
+    }
+  }
+  memset(out + pos, 0, NORMALIZED_SORT_KEY_SIZE - pos);
+}
+
+}  // namespace bustub
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// streaming_aggregation_executor.cpp
+//
+// Identification: src/execution/streaming_aggregation_executor.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/streaming_aggregation_executor.h"
+
+#include <utility>
+
+namespace bustub {
+
+StreamingAggregationExecutor::StreamingAggregationExecutor(ExecutorContext *exec_ctx,
+                                                           const StreamingAggregationPlanNode *plan,
+                                                           std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_(std::move(child)),
+      aggregator_(plan->GetAggregates(), plan->GetAggregateTypes(), plan->GetAggregateArgs()) {}
+
+void StreamingAggregationExecutor::Init() {
+  child_->Init();
+  batch_.Clear();
+  batch_idx_ = 0;
+  child_done_ = false;
+  has_group_ = false;
+}
+
+auto StreamingAggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  const auto &child_schema = child_->GetOutputSchema();
+  while (true) {
+    if (batch_idx_ == batch_.Size()) {
+      batch_idx_ = 0;
+      if (child_done_ || !child_->NextBatch(&batch_)) {
+        // End of input: the last group is complete.
+        child_done_ = true;
+        if (!has_group_) {
+          return false;
+        }
+        *tuple = MakeOutputTuple();
+        has_group_ = false;
+        return true;
+      }
+    }
+
+    const auto &input = batch_.GetTuple(batch_idx_++);
+    std::vector<Value> key;
+    for (const auto &expr : plan_->GetGroupBys()) {
+      key.emplace_back(expr->Evaluate(&input, child_schema));
+    }
+    std::vector<Value> values;
+    for (const auto &expr : plan_->GetAggregates()) {
+      values.emplace_back(expr->Evaluate(&input, child_schema));
+    }
+    std::string key_bytes;
+    SerializeAggregateKey(key, &key_bytes);
+
+    bool emit = has_group_ && key_bytes != group_key_;
+    if (emit) {
+      *tuple = MakeOutputTuple();
+    }
+    if (!has_group_ || emit) {
+      has_group_ = true;
+      group_key_ = std::move(key_bytes);
+      group_value_ = aggregator_.GenerateInitialAggregateValue();
+    }
+    aggregator_.CombineAggregateValues(&group_value_, AggregateValue{std::move(values)});
+    if (emit) {
+      return true;
+    }
+  }
+}
+
+auto StreamingAggregationExecutor::MakeOutputTuple() const -> Tuple {
+  auto values = DeserializeAggregateKey(group_key_.data(), group_key_.size());
+  auto aggregates = aggregator_.FinalizeAggregateValue(group_value_);
+  values.insert(values.end(), aggregates.begin(), aggregates.end());
+  return Tuple{std::move(values), &GetOutputSchema()};
+}
+
+}  // namespace bustub
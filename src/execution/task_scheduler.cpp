@@ -0,0 +1,208 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// task_scheduler.cpp
+//
+// Identification: src/execution/task_scheduler.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/task_scheduler.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace bustub {
+
+namespace {
+/** The scheduler owning the current thread, if the current thread is a worker */
+thread_local const TaskScheduler *current_scheduler = nullptr;
+/** The worker index of the current thread in `current_scheduler` */
+thread_local size_t current_worker_idx = 0;
+/** The scheduler whose external slot the current thread holds, if it is running a ParallelFor outside of the pool */
+thread_local const TaskScheduler *external_scheduler = nullptr;
+
+/** Holds the external slot of a scheduler for the current thread, unless the thread is a worker or already holds it */
+class ExternalSlotGuard {
+ public:
+  ExternalSlotGuard(const TaskScheduler *scheduler, std::mutex *latch, bool is_worker) {
+    if (!is_worker && external_scheduler != scheduler) {
+      lock_ = std::unique_lock(*latch);
+      external_scheduler = scheduler;
+    }
+  }
+
+  ~ExternalSlotGuard() {
+    if (lock_.owns_lock()) {
+      external_scheduler = nullptr;
+    }
+  }
+
+  DISALLOW_COPY_AND_MOVE(ExternalSlotGuard);
+
+ private:
+  std::unique_lock<std::mutex> lock_;
+};
+}  // namespace
+
+TaskScheduler::TaskScheduler(size_t num_workers) {
+  queues_.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; i++) {
+    queues_.emplace_back(std::make_unique<WorkerQueue>());
+  }
+  workers_.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; i++) {
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+TaskScheduler::~TaskScheduler() {
+  {
+    std::scoped_lock lock(sleep_latch_);
+    shutdown_ = true;
+  }
+  sleep_cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void TaskScheduler::ParallelFor(size_t num_tasks, const std::function<void(size_t, size_t)> &task) {
+  if (num_tasks == 0) {
+    return;
+  }
+  bool is_worker = current_scheduler == this;
+  size_t self = is_worker ? current_worker_idx : workers_.size();
+
+  // Threads outside of the pool share the last slot, so they take turns. A loop nested in a task that runs on the
+  // thread already holding the slot goes ahead.
+  ExternalSlotGuard external_slot{this, &external_latch_, is_worker};
+
+  if (workers_.empty() || num_tasks == 1) {
+    for (size_t i = 0; i < num_tasks; i++) {
+      task(i, self);
+    }
+    return;
+  }
+
+  TaskGroup group;
+  group.fn_ = &task;
+  group.pending_ = num_tasks;
+
+  // Deal contiguous ranges of tasks to the workers, so that neighbouring morsels start on the same thread and stealing
+  // only happens to balance the load.
+  size_t num_queues = queues_.size();
+  size_t per_queue = (num_tasks + num_queues - 1) / num_queues;
+  for (size_t q = 0; q < num_queues; q++) {
+    size_t begin = q * per_queue;
+    size_t end = std::min(num_tasks, begin + per_queue);
+    if (begin >= end) {
+      break;
+    }
+    std::scoped_lock lock(queues_[q]->latch_);
+    // The owner pops from the back, so push in reverse to run the range in order.
+    for (size_t i = end; i > begin; i--) {
+      queues_[q]->tasks_.push_back(Task{&group, i - 1});
+    }
+  }
+  num_queued_ += num_tasks;
+  {
+    std::scoped_lock lock(sleep_latch_);
+  }
+  sleep_cv_.notify_all();
+
+  // Help until every task of the group is picked up, running only the tasks of this group: a worker waiting here is
+  // in the middle of a task of an outer loop, which owns its slot, so it must not start another task of that loop.
+  // No task of the group is queued after this point, so once none is left, wait for the running ones to finish.
+  Task next{};
+  while (FindTask(self, &group, &next)) {
+    RunTask(next, self);
+  }
+  {
+    std::unique_lock lock(group.latch_);
+    group.done_cv_.wait(lock, [&group] { return group.pending_.load() == 0; });
+  }
+
+  if (group.exception_ != nullptr) {
+    std::rethrow_exception(group.exception_);
+  }
+}
+
+void TaskScheduler::WorkerLoop(size_t worker_idx) {
+  current_scheduler = this;
+  current_worker_idx = worker_idx;
+  Task task{};
+  while (true) {
+    if (FindTask(worker_idx, nullptr, &task)) {
+      RunTask(task, worker_idx);
+      continue;
+    }
+    std::unique_lock lock(sleep_latch_);
+    sleep_cv_.wait(lock, [this] { return shutdown_ || num_queued_.load() > 0; });
+    if (shutdown_) {
+      return;
+    }
+  }
+}
+
+auto TaskScheduler::FindTask(size_t worker_idx, const TaskGroup *group, Task *task) -> bool {
+  if (num_queued_.load() == 0) {
+    return false;
+  }
+  auto matches = [group](const Task &t) { return group == nullptr || t.group_ == group; };
+
+  // Own deque first, newest task first.
+  if (worker_idx < queues_.size()) {
+    auto &own = *queues_[worker_idx];
+    std::scoped_lock lock(own.latch_);
+    auto it = std::find_if(own.tasks_.rbegin(), own.tasks_.rend(), matches);
+    if (it != own.tasks_.rend()) {
+      *task = *it;
+      own.tasks_.erase(std::next(it).base());
+      num_queued_--;
+      return true;
+    }
+  }
+
+  // Steal the oldest task of a victim, starting from the next worker to spread the thieves.
+  for (size_t i = 1; i <= queues_.size(); i++) {
+    auto victim = (worker_idx + i) % queues_.size();
+    if (victim == worker_idx) {
+      continue;
+    }
+    auto &queue = *queues_[victim];
+    std::scoped_lock lock(queue.latch_);
+    auto it = std::find_if(queue.tasks_.begin(), queue.tasks_.end(), matches);
+    if (it != queue.tasks_.end()) {
+      *task = *it;
+      queue.tasks_.erase(it);
+      num_queued_--;
+      return true;
+    }
+  }
+  return false;
+}
+
+void TaskScheduler::RunTask(const Task &task, size_t slot) {
+  auto *group = task.group_;
+  try {
+    (*group->fn_)(task.task_idx_, slot);
+  } catch (...) {
+    std::scoped_lock lock(group->latch_);
+    if (group->exception_ == nullptr) {
+      group->exception_ = std::current_exception();
+    }
+  }
+  // The caller of ParallelFor may return (and destroy the group) as soon as it sees zero, so the last task signals
+  // before releasing the latch the caller waits on.
+  std::scoped_lock lock(group->latch_);
+  if (--group->pending_ == 0) {
+    group->done_cv_.notify_all();
+  }
+}
+
+}  // namespace bustub
@@ -1,15 +1,138 @@
 #include "execution/executors/topn_executor.h"
 
+#include <algorithm>
+#include <memory>
+#include <utility>
+
 namespace bustub {
 
+void TopNBoundaryFilter::SetBoundary(const NormalizedSortKey &normalized_key, const std::vector<Value> &key) {
+  std::shared_ptr<const Boundary> boundary = std::make_shared<Boundary>(Boundary{normalized_key, key});
+  std::atomic_store(&boundary_, std::move(boundary));
+}
+
+auto TopNBoundaryFilter::Check(const Tuple &tuple, const Schema &schema) const -> bool {
+  auto boundary = std::atomic_load(&boundary_);
+  if (boundary == nullptr) {
+    return true;
+  }
+  auto key = EvaluateSortKey(order_bys_, tuple, schema);
+  NormalizedSortKey normalized_key;
+  normalizer_.Normalize(key, &normalized_key);
+  int cmp = normalized_key.Compare(boundary->normalized_key_);
+  if (cmp == 0 && !normalizer_.IsExact()) {
+    cmp = comparator_.Compare(key, boundary->key_);
+  }
+  // A tuple equal to the boundary arrives after it, so it sorts after it as well.
+  return cmp < 0;
+}
+
+auto TopNBoundaryFilter::ReadsOnlyLeadingColumns(uint32_t num_columns) const -> bool {
+  return std::all_of(order_bys_.begin(), order_bys_.end(), [&](const auto &order_by) {
+    return ExpressionReadsOnlyLeadingColumns(order_by.second, num_columns);
+  });
+}
+
 TopNExecutor::TopNExecutor(ExecutorContext *exec_ctx, const TopNPlanNode *plan,
                            std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_executor_(std::move(child_executor)),
+      comparator_(plan->GetOrderBy()),
+      normalizer_(plan->GetOrderBy()) {}
+
+void TopNExecutor::Init() {
+  child_executor_->Init();
+  heap_.clear();
+  entries_.clear();
+  output_.clear();
+  output_idx_ = 0;
+  next_seq_ = 0;
+  boundary_filter_ = nullptr;
+  if (plan_->GetN() == 0) {
+    return;
+  }
+  BUSTUB_ENSURE(plan_->GetN() < UINT32_MAX, "N is too large for a top-n");
+
+  auto filter = std::make_shared<TopNBoundaryFilter>(plan_->GetOrderBy());
+  if (child_executor_->PushDownRuntimeFilter(filter)) {
+    boundary_filter_ = std::move(filter);
+  }
+
+  Tuple tuple;
+  RID rid;
+  while (child_executor_->Next(&tuple, &rid)) {
+    Consume(std::move(tuple));
+  }
+
+  // Popping the heap leaves it sorted in ascending order, which is the output order.
+  std::sort_heap(heap_.begin(), heap_.end(), [this](const HeapEntry &lhs, const HeapEntry &rhs) {
+    return SortsBefore(lhs.normalized_key_, entries_[lhs.slot_].key_, lhs.seq_, rhs);
+  });
+  output_.reserve(heap_.size());
+  for (const auto &entry : heap_) {
+    output_.push_back(entry.slot_);
+  }
+  heap_.clear();
+}
+
+auto TopNExecutor::SortsBefore(const NormalizedSortKey &normalized_key, const std::vector<Value> &key, uint64_t seq,
+                               const HeapEntry &entry) const -> bool {
+  int cmp = normalized_key.Compare(entry.normalized_key_);
+  if (cmp == 0 && !normalizer_.IsExact()) {
+    cmp = comparator_.Compare(key, entries_[entry.slot_].key_);
+  }
+  return cmp != 0 ? cmp < 0 : seq < entry.seq_;
+}
+
+void TopNExecutor::Consume(Tuple tuple) {
+  auto key = EvaluateSortKey(plan_->GetOrderBy(), tuple, child_executor_->GetOutputSchema());
+  NormalizedSortKey normalized_key;
+  normalizer_.Normalize(key, &normalized_key);
+  auto seq = next_seq_++;
+  auto heap_less = [this](const HeapEntry &lhs, const HeapEntry &rhs) {
+    return SortsBefore(lhs.normalized_key_, entries_[lhs.slot_].key_, lhs.seq_, rhs);
+  };
+
+  if (heap_.size() < plan_->GetN()) {
+    auto slot = static_cast<uint32_t>(entries_.size());
+    entries_.push_back(SortEntry{std::move(key), std::move(tuple)});
+    heap_.push_back(HeapEntry{normalized_key, seq, slot});
+    std::push_heap(heap_.begin(), heap_.end(), heap_less);
+    if (heap_.size() == plan_->GetN()) {
+      PublishBoundary();
+    }
+    return;
+  }
+
+  // The heap is full: the tuple only gets in by evicting the root, and takes over its slot.
+  if (!SortsBefore(normalized_key, key, seq, heap_.front())) {
+    return;
+  }
+  std::pop_heap(heap_.begin(), heap_.end(), heap_less);
+  auto slot = heap_.back().slot_;
+  entries_[slot] = SortEntry{std::move(key), std::move(tuple)};
+  heap_.back() = HeapEntry{normalized_key, seq, slot};
+  std::push_heap(heap_.begin(), heap_.end(), heap_less);
+  PublishBoundary();
+}
 
-void TopNExecutor::Init() { throw NotImplementedException("TopNExecutor is not implemented"); }
+void TopNExecutor::PublishBoundary() {
+  if (boundary_filter_ != nullptr) {
+    const auto &root = heap_.front();
+    boundary_filter_->SetBoundary(root.normalized_key_, entries_[root.slot_].key_);
+  }
+}
 
-auto TopNExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto TopNExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (output_idx_ == output_.size()) {
+    return false;
+  }
+  *tuple = entries_[output_[output_idx_++]].tuple_;
+  *rid = tuple->GetRid();
+  return true;
+}
 
-auto TopNExecutor::GetNumInHeap() -> size_t { throw NotImplementedException("TopNExecutor is not implemented"); };
+auto TopNExecutor::GetNumInHeap() -> size_t { return heap_.size(); };
 
 }  // namespace bustub
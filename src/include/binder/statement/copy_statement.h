@@ -0,0 +1,41 @@
+//===----------------------------------------------------------------------===//
+//                         BusTub
+//
+// binder/copy_statement.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "binder/bound_statement.h"
+#include "binder/table_ref/bound_base_table_ref.h"
+
+namespace bustub {
+
+/** `COPY table FROM 'file'`: bulk load a CSV file into a table. */
+class CopyStatement : public BoundStatement {
+ public:
+  explicit CopyStatement(std::unique_ptr<BoundBaseTableRef> table, std::string file_path, char delimiter, bool header,
+                         std::string null_string);
+
+  std::unique_ptr<BoundBaseTableRef> table_;
+
+  /** The file to load */
+  std::string file_path_;
+
+  /** The character between two fields of a row */
+  char delimiter_;
+
+  /** Whether the first line of the file is a header to skip */
+  bool header_;
+
+  /** The unquoted field that stands for NULL, the empty field by default */
+  std::string null_string_;
+
+  auto ToString() const -> std::string override;
+};
+
+}  // namespace bustub
@@ -17,6 +17,7 @@
 #include <optional>
 #include <shared_mutex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -24,8 +25,10 @@
 
 #include "catalog/catalog.h"
 #include "common/config.h"
+#include "common/exception.h"
 #include "common/util/string_util.h"
 #include "execution/check_options.h"
+#include "fmt/format.h"
 #include "libfort/lib/fort.hpp"
 #include "type/value.h"
 
@@ -41,7 +44,9 @@ class LogManager;
 class CheckpointManager;
 class Catalog;
 class ExecutionEngine;
+class TaskScheduler;
 
+class CopyStatement;
 class CreateStatement;
 class IndexStatement;
 class VariableSetStatement;
@@ -260,6 +265,7 @@ class BustubInstance {
   LogManager *log_manager_;
   CheckpointManager *checkpoint_manager_;
   Catalog *catalog_;
+  TaskScheduler *task_scheduler_;
   ExecutionEngine *execution_engine_;
   std::shared_mutex catalog_lock_;
 
@@ -275,6 +281,19 @@ class BustubInstance {
     return variable == "1" || variable == "true" || variable == "yes";
   }
 
+  /** @return the memory budget of memory-intensive executors, set by `set query_memory_budget=<bytes>` */
+  auto GetQueryMemoryBudget() -> size_t {
+    auto variable = GetSessionVariable("query_memory_budget");
+    if (variable.empty()) {
+      return DEFAULT_QUERY_MEMORY_BUDGET;
+    }
+    try {
+      return std::stoull(variable);
+    } catch (std::logic_error &e) {
+      throw Exception(fmt::format("invalid query_memory_budget: {}", variable));
+    }
+  }
+
  private:
   void CmdDisplayTables(ResultWriter &writer);
   void CmdDisplayIndices(ResultWriter &writer);
@@ -286,6 +305,7 @@ class BustubInstance {
   void HandleExplainStatement(Transaction *txn, const ExplainStatement &stmt, ResultWriter &writer);
   void HandleVariableShowStatement(Transaction *txn, const VariableShowStatement &stmt, ResultWriter &writer);
   void HandleVariableSetStatement(Transaction *txn, const VariableSetStatement &stmt, ResultWriter &writer);
+  void HandleCopyStatement(Transaction *txn, const CopyStatement &stmt, ResultWriter &writer);
 
   std::unordered_map<std::string, std::string> session_variables_;
 };
@@ -35,7 +35,11 @@ static constexpr int BUSTUB_PAGE_SIZE = 4096;
 static constexpr int BUFFER_POOL_SIZE = 10;                                          // size of buffer pool
 static constexpr int LOG_BUFFER_SIZE = ((BUFFER_POOL_SIZE + 1) * BUSTUB_PAGE_SIZE);  // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                               // size of extendible hash bucket
-static constexpr int LRUK_REPLACER_K = 10;  // lookback window for lru-k replacer
+static constexpr int LRUK_REPLACER_K = 10;       // lookback window for lru-k replacer
+static constexpr int BUSTUB_BATCH_SIZE = 128;    // number of tuples exchanged per NextBatch() call
+static constexpr int MORSEL_SIZE_IN_PAGES = 16;  // number of table pages scanned by one parallel scan task
+static constexpr size_t DEFAULT_QUERY_MEMORY_BUDGET = 64 << 20;  // bytes an operator may use before spilling to disk
+static constexpr size_t BULK_LOAD_CHUNK_SIZE = 1 << 20;         // bytes of a file parsed by one bulk load task
 
 using frame_id_t = int32_t;    // frame id type
 using page_id_t = int32_t;     // page id type
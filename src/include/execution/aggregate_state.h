@@ -0,0 +1,161 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregate_state.h
+//
+// Identification: src/include/execution/aggregate_state.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * AggregateState is the running state of an aggregate that does not fit in a single Value, e.g. the sum and the count
+ * of an AVG. Aggregates whose state is a Value (COUNT, SUM, MIN, MAX) do not use one.
+ *
+ * A state can be merged with the state of the same aggregate over other input values, directly or in serialized form,
+ * so that it supports the pre-aggregation and the spilling of the hash aggregation.
+ */
+class AggregateState {
+ public:
+  virtual ~AggregateState() = default;
+
+  /** Add an input value to the state. Null values are ignored. */
+  virtual void Combine(const Value &input) = 0;
+
+  /** Merge the state of the same aggregate, of the same concrete type, computed over other input values. */
+  virtual void Merge(const AggregateState &other) = 0;
+
+  /** Merge a state serialized by SerializeTo(). */
+  virtual void MergeSerialized(const char *bytes, size_t length) = 0;
+
+  /**
+   * Serialize the state as one or more parts that give the state back when merged together into an empty state.
+   * @param max_size the size a part should not exceed, which a state may only ignore for a part of a fixed size
+   * @param[out] parts the serialized parts
+   */
+  virtual void SerializeTo(size_t max_size, std::vector<std::string> *parts) const = 0;
+
+  /** @return the result of the aggregate */
+  virtual auto Finalize() const -> Value = 0;
+
+  /** @return an estimate of the memory taken by the state, in bytes */
+  virtual auto GetMemoryUsage() const -> size_t = 0;
+};
+
+/** The state of AVG: the sum and the number of the non-null input values. The result is a DECIMAL. */
+class AvgState : public AggregateState {
+ public:
+  void Combine(const Value &input) override;
+  void Merge(const AggregateState &other) override;
+  void MergeSerialized(const char *bytes, size_t length) override;
+  void SerializeTo(size_t max_size, std::vector<std::string> *parts) const override;
+  auto Finalize() const -> Value override;
+  auto GetMemoryUsage() const -> size_t override { return sizeof(AvgState); }
+
+ private:
+  double sum_{0};
+  int64_t count_{0};
+};
+
+/**
+ * The state of COUNT(DISTINCT): the set of the distinct non-null input values, serialized. Unlike the other states,
+ * it grows with its input, and is serialized in as many parts as needed.
+ */
+class CountDistinctState : public AggregateState {
+ public:
+  void Combine(const Value &input) override;
+  void Merge(const AggregateState &other) override;
+  void MergeSerialized(const char *bytes, size_t length) override;
+  void SerializeTo(size_t max_size, std::vector<std::string> *parts) const override;
+  auto Finalize() const -> Value override;
+  auto GetMemoryUsage() const -> size_t override { return memory_usage_; }
+
+ private:
+  void Insert(std::string &&value);
+
+  std::unordered_set<std::string> values_;
+  size_t memory_usage_{sizeof(CountDistinctState)};
+};
+
+/**
+ * The state of APPROX_COUNT_DISTINCT: a HyperLogLog sketch of 2^PRECISION one-byte registers, with a standard error of
+ * about 1.04 / sqrt(2^PRECISION). Each register holds the highest rank, i.e. position of the first set bit, seen among
+ * the hashes of the values that fall into it. Small cardinalities are estimated by linear counting of the empty
+ * registers. Two sketches merge by taking the maximum of every register.
+ */
+class HyperLogLogState : public AggregateState {
+ public:
+  static constexpr size_t PRECISION = 10;
+  static constexpr size_t NUM_REGISTERS = 1 << PRECISION;
+
+  void Combine(const Value &input) override;
+  void Merge(const AggregateState &other) override;
+  void MergeSerialized(const char *bytes, size_t length) override;
+  void SerializeTo(size_t max_size, std::vector<std::string> *parts) const override;
+  auto Finalize() const -> Value override;
+  auto GetMemoryUsage() const -> size_t override { return sizeof(HyperLogLogState); }
+
+ private:
+  std::array<uint8_t, NUM_REGISTERS> registers_{};
+};
+
+/**
+ * The state of APPROX_QUANTILE: a merging t-digest. Input values are buffered, and the buffer is periodically merged
+ * with the centroids, i.e. (mean, weight) clusters of values, sorted by mean. The size of a centroid is bounded by the
+ * arcsine scale function, so that centroids are small near the tails, where quantiles are the most sensitive, and
+ * there are at most about COMPRESSION of them. The quantile is interpolated between the centroid means.
+ */
+class TDigestState : public AggregateState {
+ public:
+  static constexpr double COMPRESSION = 100;
+  static constexpr size_t BUFFER_SIZE = 500;
+
+  /** @param quantile the quantile to compute, in [0, 1] */
+  explicit TDigestState(double quantile) : quantile_(quantile) {}
+
+  void Combine(const Value &input) override;
+  void Merge(const AggregateState &other) override;
+  void MergeSerialized(const char *bytes, size_t length) override;
+  void SerializeTo(size_t max_size, std::vector<std::string> *parts) const override;
+  auto Finalize() const -> Value override;
+  auto GetMemoryUsage() const -> size_t override {
+    return sizeof(TDigestState) + (centroids_.capacity() + buffer_.capacity()) * sizeof(Centroid);
+  }
+
+ private:
+  struct Centroid {
+    double mean_;
+    double weight_;
+  };
+
+  /** Add a centroid to the buffer, and merge the buffer once it is full. */
+  void Add(Centroid centroid);
+
+  /** Merge the buffered centroids into the centroids. */
+  void Compress();
+
+  /** @return the centroids and the buffered centroids, merged */
+  auto MergeCentroids() const -> std::vector<Centroid>;
+
+  double quantile_;
+  std::vector<Centroid> centroids_;
+  std::vector<Centroid> buffer_;
+  double min_{0};
+  double max_{0};
+};
+
+}  // namespace bustub
@@ -0,0 +1,113 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bulk_loader.h
+//
+// Identification: src/include/execution/bulk_loader.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "common/config.h"
+#include "concurrency/transaction.h"
+#include "execution/task_scheduler.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/** The format of a CSV file */
+struct CsvFormat {
+  /** The character between two fields of a row */
+  char delimiter_{','};
+  /** Whether the first row of the file is a header to skip */
+  bool header_{false};
+  /** The unquoted field that stands for NULL */
+  std::string null_string_;
+};
+
+/**
+ * BulkLoader loads a CSV file into a table, the `COPY table FROM 'file'` path. It bypasses the tuple-at-a-time insert
+ * path: there is no page latched per tuple, no index update per tuple, and no write record per tuple.
+ *
+ * The file is read in rounds of a few chunks per thread. The rows of a round are split into chunks of about
+ * `chunk_size` bytes at row boundaries, and every chunk is parsed by a task of its own into complete TablePages built
+ * in memory. The pages are then appended to the table, in file order, with TableHeap::AppendPages(). Finally the keys
+ * of the new tuples are sorted, and inserted into every index of the table in key order, which keeps the B+ tree
+ * descents on the same few leaves.
+ *
+ * Rows follow RFC 4180: a field may be quoted with double quotes, and a double quote within a quoted field is written
+ * twice. A row ends with "\n" or "\r\n", which a quoted field may contain. An unquoted field equal to the null string,
+ * the empty string by default, is NULL. Empty rows are skipped.
+ *
+ * The load is not undone if the transaction aborts, and rows loaded by the rounds before a malformed row stay in the
+ * table: the file is meant to be loaded in a table that nobody else writes to.
+ */
+class BulkLoader {
+ public:
+  /**
+   * Construct a new BulkLoader.
+   * @param table_info the table to load
+   * @param indexes the indexes of the table
+   * @param scheduler the scheduler the chunks are parsed on, or nullptr to parse them on the calling thread
+   * @param format the format of the file
+   * @param chunk_size the number of bytes of a chunk of rows, parsed by one task
+   */
+  BulkLoader(TableInfo *table_info, std::vector<IndexInfo *> indexes, TaskScheduler *scheduler, CsvFormat format,
+             size_t chunk_size = BULK_LOAD_CHUNK_SIZE);
+
+  /**
+   * Load a file into the table.
+   * @param file_path the file to load
+   * @param txn the transaction updating the indexes
+   * @return the number of rows loaded
+   */
+  auto Load(const std::string &file_path, Transaction *txn) -> size_t;
+
+ private:
+  /** A range of whole rows of the file, and the table pages they are parsed into */
+  struct Chunk {
+    const char *begin_;
+    const char *end_;
+    std::vector<std::unique_ptr<char[]>> pages_;
+    size_t num_rows_{0};
+  };
+
+  /**
+   * Split [begin, end) into chunks at row boundaries.
+   * @param at_eof whether `end` is the end of the file, so that the last row needs no line break
+   * @param[out] rest the start of the last, incomplete, row, which is not part of any chunk, or end
+   */
+  auto SplitChunks(const char *begin, const char *end, bool at_eof, const char **rest) const -> std::vector<Chunk>;
+
+  /** Parse the rows of a chunk into table pages. */
+  void ParseChunk(Chunk *chunk) const;
+
+  /** Convert a field of a row into a value of a column. */
+  auto ParseValue(std::string_view field, bool quoted, const Column &column) const -> Value;
+
+  /** Insert the tuples of the pages of the chunks, appended as `page_ids`, into every index. */
+  void UpdateIndexes(const std::vector<Chunk> &chunks, const std::vector<std::vector<page_id_t>> &page_ids,
+                     Transaction *txn);
+
+  /** Run `task(i)` for every i in [0, num_tasks), in parallel if there is a scheduler. */
+  void RunTasks(size_t num_tasks, const std::function<void(size_t)> &task);
+
+  TableInfo *table_info_;
+  std::vector<IndexInfo *> indexes_;
+  TaskScheduler *scheduler_;
+  CsvFormat format_;
+  size_t chunk_size_;
+};
+
+}  // namespace bustub
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include "buffer/buffer_pool_manager.h"
@@ -21,7 +22,9 @@
 #include "execution/executor_context.h"
 #include "execution/executor_factory.h"
 #include "execution/executors/init_check_executor.h"
+#include "execution/executors/nested_loop_join_executor.h"
 #include "execution/plans/abstract_plan.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -76,12 +79,12 @@ class ExecutionEngine {
   }
 
   void PerformChecks(ExecutorContext *exec_ctx) {
-    for (const auto &[left_executor, right_executor] : exec_ctx->GetNLJCheckExecutorSet()) {
-      auto casted_left_executor = dynamic_cast<const InitCheckExecutor *>(left_executor);
+    for (const auto &[join_executor, right_executor] : exec_ctx->GetNLJCheckExecutorSet()) {
+      auto casted_join_executor = dynamic_cast<const NestedLoopJoinExecutor *>(join_executor);
       auto casted_right_executor = dynamic_cast<const InitCheckExecutor *>(right_executor);
-      BUSTUB_ASSERT(casted_right_executor->GetInitCount() + 1 >= casted_left_executor->GetNextCount(),
-                    "nlj check failed, are you initialising the right executor every time when there is a left tuple? "
-                    "(off-by-one is okay)");
+      BUSTUB_ASSERT(casted_right_executor->GetInitCount() + 1 >= casted_join_executor->GetBlockCount(),
+                    "nlj check failed, are you initialising the right executor every time there is a block of left "
+                    "tuples? (off-by-one is okay)");
     }
   }
 
@@ -94,11 +97,12 @@ class ExecutionEngine {
    */
   static void PollExecutor(AbstractExecutor *executor, const AbstractPlanNodeRef &plan,
                            std::vector<Tuple> *result_set) {
-    RID rid{};
-    Tuple tuple{};
-    while (executor->Next(&tuple, &rid)) {
+    TupleBatch batch{};
+    while (executor->NextBatch(&batch)) {
       if (result_set != nullptr) {
-        result_set->push_back(tuple);
+        for (size_t i = 0; i < batch.Size(); i++) {
+          result_set->push_back(std::move(batch.GetTuple(i)));
+        }
       }
     }
   }
@@ -22,6 +22,7 @@
 #include "concurrency/transaction.h"
 #include "execution/check_options.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/task_scheduler.h"
 #include "storage/page/tmp_tuple_page.h"
 
 namespace bustub {
@@ -38,14 +39,16 @@ class ExecutorContext {
    * @param bpm The buffer pool manager that the executor uses
    * @param txn_mgr The transaction manager that the executor uses
    * @param lock_mgr The lock manager that the executor uses
+   * @param task_scheduler The worker pool for parallel executors, nullptr to run everything on the calling thread
    */
   ExecutorContext(Transaction *transaction, Catalog *catalog, BufferPoolManager *bpm, TransactionManager *txn_mgr,
-                  LockManager *lock_mgr, bool is_delete)
+                  LockManager *lock_mgr, bool is_delete, TaskScheduler *task_scheduler = nullptr)
       : transaction_(transaction),
         catalog_{catalog},
         bpm_{bpm},
         txn_mgr_(txn_mgr),
         lock_mgr_(lock_mgr),
+        task_scheduler_(task_scheduler),
         is_delete_(is_delete) {
     nlj_check_exec_set_ = std::deque<std::pair<AbstractExecutor *, AbstractExecutor *>>(
         std::deque<std::pair<AbstractExecutor *, AbstractExecutor *>>{});
@@ -74,6 +77,14 @@ class ExecutorContext {
   /** @return the transaction manager */
   auto GetTransactionManager() -> TransactionManager * { return txn_mgr_; }
 
+  /** @return the number of bytes a memory-intensive executor may use before spilling to temporary pages */
+  auto GetMemoryBudget() const -> size_t { return memory_budget_; }
+
+  void SetMemoryBudget(size_t memory_budget) { memory_budget_ = memory_budget; }
+
+  /** @return the worker pool for parallel execution, or nullptr if execution is single-threaded */
+  auto GetTaskScheduler() -> TaskScheduler * { return task_scheduler_; }
+
   /** @return the set of nlj check executors */
   auto GetNLJCheckExecutorSet() -> std::deque<std::pair<AbstractExecutor *, AbstractExecutor *>> & {
     return nlj_check_exec_set_;
@@ -82,8 +93,9 @@ class ExecutorContext {
   /** @return the check options */
   auto GetCheckOptions() -> std::shared_ptr<CheckOptions> { return check_options_; }
 
-  void AddCheckExecutor(AbstractExecutor *left_exec, AbstractExecutor *right_exec) {
-    nlj_check_exec_set_.emplace_back(left_exec, right_exec);
+  /** Register a nested loop join, and the init check executor of its right child */
+  void AddCheckExecutor(AbstractExecutor *join_exec, AbstractExecutor *right_exec) {
+    nlj_check_exec_set_.emplace_back(join_exec, right_exec);
   }
 
   void InitCheckOptions(std::shared_ptr<CheckOptions> &&check_options) {
@@ -104,6 +116,10 @@ class ExecutorContext {
   TransactionManager *txn_mgr_;
   /** The lock manager associated with this executor context */
   LockManager *lock_mgr_;
+  /** The worker pool for parallel execution, may be nullptr */
+  TaskScheduler *task_scheduler_;
+  /** The memory budget of memory-intensive executors, in bytes */
+  size_t memory_budget_{DEFAULT_QUERY_MEMORY_BUDGET};
   /** The set of NLJ check executors associated with this executor context */
   std::deque<std::pair<AbstractExecutor *, AbstractExecutor *>> nlj_check_exec_set_;
   /** The set of check options associated with this executor context */
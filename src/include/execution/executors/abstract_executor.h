@@ -13,6 +13,8 @@
 #pragma once
 
 #include "execution/executor_context.h"
+#include "execution/runtime_filter.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -21,6 +23,10 @@ class ExecutorContext;
  * The AbstractExecutor implements the Volcano tuple-at-a-time iterator model.
  * This is the base class from which all executors in the BustTub execution
  * engine inherit, and defines the minimal interface that all executors support.
+ *
+ * Executors may additionally produce tuples a batch at a time through NextBatch(). The default implementation
+ * adapts Next(), so an executor only needs to override NextBatch() when it can do better than one virtual call
+ * per tuple.
  */
 class AbstractExecutor {
  public:
@@ -47,6 +53,32 @@ class AbstractExecutor {
    */
   virtual auto Next(Tuple *tuple, RID *rid) -> bool = 0;
 
+  /**
+   * Yield the next batch of tuples from this executor. The batch is cleared before being filled. Next() and
+   * NextBatch() pull from the same stream, but a consumer should stick to one of them for a given Init().
+   * @param[out] batch The batch filled with the next tuples produced by this executor
+   * @return `true` if at least one tuple was produced, `false` if there are no more tuples
+   */
+  virtual auto NextBatch(TupleBatch *batch) -> bool {
+    batch->Clear();
+    while (!batch->IsFull()) {
+      auto [tuple, rid] = batch->AppendSlot();
+      if (!Next(tuple, rid)) {
+        batch->Truncate(batch->Size() - 1);
+        break;
+      }
+    }
+    return !batch->IsEmpty();
+  }
+
+  /**
+   * Offer a runtime filter over the output of this executor. An executor that accepts it applies it to the tuples it
+   * produces from then on, either itself or by pushing it further down. Must be called after Init().
+   * @param filter the filter, which expects tuples in the output schema of this executor
+   * @return `true` if the filter was accepted, `false` if it is ignored
+   */
+  virtual auto PushDownRuntimeFilter(const RuntimeFilterRef &filter) -> bool { return false; }
+
   /** @return The schema of the tuples that this executor produces */
   virtual auto GetOutputSchema() const -> const Schema & = 0;
 
@@ -13,7 +13,7 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -23,65 +23,101 @@
 #include "execution/executors/abstract_executor.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/aggregation_plan.h"
+#include "storage/table/spill_file.h"
 #include "storage/table/tuple.h"
 #include "type/value_factory.h"
 
 namespace bustub {
 
+/**
+ * Group keys are stored serialized: every value is written as its type id followed by Value::SerializeTo(). Two keys
+ * serialize to the same bytes if and only if they are equal, with null values of a type serializing identically so
+ * that they form one group, and a DECIMAL -0.0 serializing as 0.0.
+ */
+void SerializeAggregateKey(const std::vector<Value> &values, std::string *bytes);
+
+/** @return the values serialized by SerializeAggregateKey() into the given bytes */
+auto DeserializeAggregateKey(const char *bytes, size_t length) -> std::vector<Value>;
+
+/** @return the hash of a serialized key. The high bits are well mixed and can be used to pick a partition. */
+inline auto HashAggregateKey(const std::string &bytes) -> hash_t {
+  return HashUtil::Mix(HashUtil::HashBytes(bytes.data(), bytes.size()));
+}
+
 /**
  * A simplified hash table that has all the necessary functionality for aggregations.
+ *
+ * It is a flat open-addressing table with linear probing. The slots only hold a tag of the hash and the index of the
+ * group, and the groups are stored contiguously with their serialized key, so probing compares bytes and never touches
+ * a Value.
  */
 class SimpleAggregationHashTable {
  public:
+  /** A group of the table */
+  struct Group {
+    hash_t hash_;
+    std::string key_;
+    AggregateValue value_;
+  };
+
   /**
    * Construct a new SimpleAggregationHashTable instance.
    * @param agg_exprs the aggregation expressions
    * @param agg_types the types of aggregations
+   * @param agg_args the constant arguments of the aggregations, empty if none of them takes one
    */
   SimpleAggregationHashTable(const std::vector<AbstractExpressionRef> &agg_exprs,
-                             const std::vector<AggregationType> &agg_types)
-      : agg_exprs_{agg_exprs}, agg_types_{agg_types} {}
-
-  /** @return The initial aggregate value for this aggregation executor */
-  auto GenerateInitialAggregateValue() -> AggregateValue {
-    std::vector<Value> values{};
+                             const std::vector<AggregationType> &agg_types, std::vector<Value> agg_args = {})
+      : agg_exprs_{agg_exprs}, agg_types_{agg_types}, agg_args_{std::move(agg_args)} {
     for (const auto &agg_type : agg_types_) {
-      switch (agg_type) {
-        case AggregationType::CountStarAggregate:
-          // Count start starts at zero.
-          values.emplace_back(ValueFactory::GetIntegerValue(0));
-          break;
-        case AggregationType::CountAggregate:
-        case AggregationType::SumAggregate:
-        case AggregationType::MinAggregate:
-        case AggregationType::MaxAggregate:
-          // Others starts at null.
-          values.emplace_back(ValueFactory::GetNullValueByType(TypeId::INTEGER));
-          break;
-      }
+      has_states_ = has_states_ || HasState(agg_type);
     }
-    return {values};
   }
 
+  /** @return `true` if the running value of an aggregation type is an AggregateState rather than a Value */
+  static auto HasState(AggregationType agg_type) -> bool {
+    switch (agg_type) {
+      case AggregationType::AvgAggregate:
+      case AggregationType::CountDistinctAggregate:
+      case AggregationType::ApproxCountDistinctAggregate:
+      case AggregationType::ApproxQuantileAggregate:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  /** @return The initial aggregate value for this aggregation executor */
+  auto GenerateInitialAggregateValue() const -> AggregateValue;
+
+  /** @return the results of the aggregates of a running aggregate value */
+  auto FinalizeAggregateValue(const AggregateValue &value) const -> std::vector<Value>;
+
+  /**
+   * Serializes a running aggregate value as partial aggregate values that give it back once merged together into an
+   * initial value. The running value of an aggregate with a state is written as a VARCHAR holding the serialized state.
+   * @param value the running aggregate value
+   * @param max_size the size a part should not exceed, if the aggregates allow it
+   * @param[out] parts the serialized partial aggregate values
+   */
+  void SerializeAggregateValue(const AggregateValue &value, size_t max_size, std::vector<std::string> *parts) const;
+
+  /** @return the partial aggregate value serialized by SerializeAggregateValue() into the given bytes */
+  auto DeserializeAggregateValue(const char *bytes, size_t length) const -> AggregateValue;
+
   /**
-   * TODO(Student)
-   *
    * Combines the input into the aggregation result.
    * @param[out] result The output aggregate value
    * @param input The input value
    */
-  void CombineAggregateValues(AggregateValue *result, const AggregateValue &input) {
-    for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
-      switch (agg_types_[i]) {
-        case AggregationType::CountStarAggregate:
-        case AggregationType::CountAggregate:
-        case AggregationType::SumAggregate:
-        case AggregationType::MinAggregate:
-        case AggregationType::MaxAggregate:
-          break;
-      }
-    }
-  }
+  void CombineAggregateValues(AggregateValue *result, const AggregateValue &input);
+
+  /**
+   * Merges a partial aggregation result, computed over other input tuples of the same group, into the result.
+   * @param[out] result The output aggregate value
+   * @param partial The partial aggregate value
+   */
+  void MergeAggregateValues(AggregateValue *result, const AggregateValue &partial);
 
   /**
    * Inserts a value into the hash table and then combines it with the current aggregation.
@@ -89,64 +125,154 @@ class SimpleAggregationHashTable {
    * @param agg_val the value to be inserted
    */
   void InsertCombine(const AggregateKey &agg_key, const AggregateValue &agg_val) {
-    if (ht_.count(agg_key) == 0) {
-      ht_.insert({agg_key, GenerateInitialAggregateValue()});
+    std::string key;
+    SerializeAggregateKey(agg_key.group_bys_, &key);
+    auto hash = HashAggregateKey(key);
+    InsertCombine(std::move(key), hash, agg_val);
+  }
+
+  /**
+   * Inserts a value into the hash table under a serialized key and then combines it with the current aggregation.
+   * @param key the serialized key
+   * @param hash the hash of the key
+   * @param agg_val the value to be inserted
+   */
+  void InsertCombine(std::string &&key, hash_t hash, const AggregateValue &agg_val) {
+    auto *result = FindOrInsert(std::move(key), hash);
+    if (!has_states_) {
+      CombineAggregateValues(result, agg_val);
+      return;
     }
-    CombineAggregateValues(&ht_[agg_key], agg_val);
+    auto state_memory_usage = GetStateMemoryUsage(*result);
+    CombineAggregateValues(result, agg_val);
+    memory_usage_ += GetStateMemoryUsage(*result) - state_memory_usage;
+  }
+
+  /**
+   * Inserts a partial aggregation result into the hash table and then merges it with the current aggregation.
+   * @param key the serialized key
+   * @param hash the hash of the key
+   * @param partial the partial aggregate value
+   */
+  void InsertMerge(std::string &&key, hash_t hash, const AggregateValue &partial) {
+    auto *result = FindOrInsert(std::move(key), hash);
+    if (!has_states_) {
+      MergeAggregateValues(result, partial);
+      return;
+    }
+    auto state_memory_usage = GetStateMemoryUsage(*result);
+    MergeAggregateValues(result, partial);
+    memory_usage_ += GetStateMemoryUsage(*result) - state_memory_usage;
   }
 
   /**
    * Clear the hash table
    */
-  void Clear() { ht_.clear(); }
+  void Clear() {
+    slots_.clear();
+    groups_.clear();
+    memory_usage_ = 0;
+  }
+
+  /** @return the number of groups */
+  auto Size() const -> size_t { return groups_.size(); }
+
+  /** @return an estimate of the memory taken by the table, in bytes */
+  auto GetMemoryUsage() const -> size_t { return memory_usage_; }
+
+  /** @return the groups of the table, in insertion order */
+  auto GetGroups() const -> const std::vector<Group> & { return groups_; }
 
   /** An iterator over the aggregation hash table */
   class Iterator {
    public:
-    /** Creates an iterator for the aggregate map. */
-    explicit Iterator(std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter) : iter_{iter} {}
+    /** Creates an iterator for the aggregate groups. */
+    Iterator(const std::vector<Group> *groups, size_t idx) : groups_{groups}, idx_{idx} {}
 
     /** @return The key of the iterator */
-    auto Key() -> const AggregateKey & { return iter_->first; }
+    auto Key() -> AggregateKey {
+      const auto &key = (*groups_)[idx_].key_;
+      return {DeserializeAggregateKey(key.data(), key.size())};
+    }
 
     /** @return The value of the iterator */
-    auto Val() -> const AggregateValue & { return iter_->second; }
+    auto Val() -> const AggregateValue & { return (*groups_)[idx_].value_; }
 
     /** @return The iterator before it is incremented */
     auto operator++() -> Iterator & {
-      ++iter_;
+      ++idx_;
       return *this;
     }
 
     /** @return `true` if both iterators are identical */
-    auto operator==(const Iterator &other) -> bool { return this->iter_ == other.iter_; }
+    auto operator==(const Iterator &other) -> bool { return this->idx_ == other.idx_; }
 
     /** @return `true` if both iterators are different */
-    auto operator!=(const Iterator &other) -> bool { return this->iter_ != other.iter_; }
+    auto operator!=(const Iterator &other) -> bool { return this->idx_ != other.idx_; }
 
    private:
-    /** Aggregates map */
-    std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter_;
+    /** Aggregate groups */
+    const std::vector<Group> *groups_;
+    size_t idx_;
   };
 
   /** @return Iterator to the start of the hash table */
-  auto Begin() -> Iterator { return Iterator{ht_.cbegin()}; }
+  auto Begin() -> Iterator { return Iterator{&groups_, 0}; }
 
   /** @return Iterator to the end of the hash table */
-  auto End() -> Iterator { return Iterator{ht_.cend()}; }
+  auto End() -> Iterator { return Iterator{&groups_, groups_.size()}; }
 
  private:
-  /** The hash table is just a map from aggregate keys to aggregate values */
-  std::unordered_map<AggregateKey, AggregateValue> ht_{};
+  /** A slot of the table: the high bits of the hash of a group, and the index of the group plus one, or 0 if empty */
+  struct Slot {
+    uint32_t hash_tag_;
+    uint32_t group_;
+  };
+
+  /** @return the aggregate value of the group of a key, created if the key is new */
+  auto FindOrInsert(std::string &&key, hash_t hash) -> AggregateValue *;
+
+  /** Double the number of slots. */
+  void Grow();
+
+  /** @return the memory taken by the states of an aggregate value */
+  static auto GetStateMemoryUsage(const AggregateValue &value) -> size_t {
+    size_t memory_usage = 0;
+    for (const auto &state : value.states_) {
+      memory_usage += state == nullptr ? 0 : state->GetMemoryUsage();
+    }
+    return memory_usage;
+  }
+
+  /** @return the initial state of the idx'th aggregate, or nullptr if its running value is a Value */
+  auto MakeAggregateState(size_t idx) const -> std::unique_ptr<AggregateState>;
+
+  /** The slots, a power of two of them, at most half full */
+  std::vector<Slot> slots_;
+  /** The groups, in insertion order */
+  std::vector<Group> groups_;
+  size_t memory_usage_{0};
   /** The aggregate expressions that we have */
   const std::vector<AbstractExpressionRef> &agg_exprs_;
   /** The types of aggregations that we have */
   const std::vector<AggregationType> &agg_types_;
+  /** The constant arguments of the aggregations */
+  std::vector<Value> agg_args_;
+  /** Whether some aggregation has an AggregateState */
+  bool has_states_{false};
 };
 
 /**
  * AggregationExecutor executes an aggregation operation (e.g. COUNT, SUM, MIN, MAX)
  * over the tuples produced by a child executor.
+ *
+ * The groups are hash-partitioned on the high bits of the hash of their key into NUM_PARTITIONS tables. The input is
+ * consumed in chunks: with a task scheduler, every thread pre-aggregates its share of a chunk into thread-local tables,
+ * which are then merged into the shared tables one partition per task, without any locking.
+ *
+ * When the tables outgrow the memory budget of the executor context, their groups are written as partial aggregates
+ * to one spill file per partition and the tables are emptied. The spilled partitions are merged back one at a time
+ * once the input is exhausted, and partitions that still do not fit are split again on the next bits of the hash.
  */
 class AggregationExecutor : public AbstractExecutor {
  public:
@@ -170,13 +296,41 @@ class AggregationExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of aggregation results, filled straight from the groups of the partition tables.
+   * @param[out] batch The next batch produced by the aggregation
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
   /** @return The output schema for the aggregation */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
   /** Do not use or remove this function, otherwise you will get zero points. */
   auto GetChildExecutor() const -> const AbstractExecutor *;
 
+  /** Number of partitions of the groups, at every level of spilling */
+  static constexpr size_t PARTITION_BITS = 4;
+  static constexpr size_t NUM_PARTITIONS = 1 << PARTITION_BITS;
+  /** Spilled partitions are not split again past this level */
+  static constexpr size_t MAX_SPILL_LEVEL = 3;
+  /** Number of input tuples aggregated at once, and by one parallel task */
+  static constexpr size_t INPUT_CHUNK_SIZE = 64 * BUSTUB_BATCH_SIZE;
+  static constexpr size_t PREAGGREGATION_TASK_SIZE = 8 * BUSTUB_BATCH_SIZE;
+
  private:
+  /** A partition of the groups written to a spill file */
+  struct SpilledPartition {
+    std::unique_ptr<SpillFile> file_;
+    size_t level_;
+  };
+
+  /** @return the partition of a key hash at a level of partitioning */
+  static auto PartitionOf(hash_t hash, size_t level) -> size_t {
+    // The low bits pick the slots of the tables, partitions are taken from the high bits down.
+    return (hash >> (64 - PARTITION_BITS * (level + 1))) & (NUM_PARTITIONS - 1);
+  }
+
   /** @return The tuple as an AggregateKey */
   auto MakeAggregateKey(const Tuple *tuple) -> AggregateKey {
     std::vector<Value> keys;
@@ -195,14 +349,57 @@ class AggregationExecutor : public AbstractExecutor {
     return {vals};
   }
 
- private:
+  /** @return a table for the aggregates of the plan */
+  auto MakeTable() const -> SimpleAggregationHashTable {
+    return SimpleAggregationHashTable{plan_->GetAggregates(), plan_->GetAggregateTypes(), plan_->GetAggregateArgs()};
+  }
+
+  /** Aggregate a chunk of input tuples into the partition tables, then spill them if they take too much memory. */
+  void AggregateChunk(const std::vector<Tuple> &chunk);
+
+  /** Aggregate the tuples of the chunk in [begin, end) into a set of partition tables. */
+  void AggregateTuples(const std::vector<Tuple> &chunk, size_t begin, size_t end,
+                       std::vector<SimpleAggregationHashTable> *tables);
+
+  /** Write the groups of the partition tables to the level 0 spill files, and empty the tables. */
+  void SpillTables();
+
+  /**
+   * Append a group to a spill file, as one or more records holding partial aggregates of the group, so that the
+   * records fit in a page even if the aggregate states of the group do not, as long as the key does.
+   */
+  void SpillGroup(const SimpleAggregationHashTable &table, const SimpleAggregationHashTable::Group &group,
+                  SpillFile *file) const;
+
+  /** Merge the next spilled partition into partitions_[0], splitting it further if it is still too large. */
+  auto LoadNextPartition() -> bool;
+
+  /**
+   * Move the output position to the next group to emit, loading spilled partitions as needed.
+   * @return `false` if every group has been emitted
+   */
+  auto SeekNextGroup() -> bool;
+
+  /** @return the output tuple of a group: its key, then its aggregates */
+  auto MakeOutputTuple(const SimpleAggregationHashTable::Group &group) const -> Tuple;
+
   /** The aggregation plan node */
   const AggregationPlanNode *plan_;
   /** The child executor that produces tuples over which the aggregation is computed */
   std::unique_ptr<AbstractExecutor> child_;
-  /** Simple aggregation hash table */
-  // TODO(Student): Uncomment SimpleAggregationHashTable aht_;
-  /** Simple aggregation hash table iterator */
-  // TODO(Student): Uncomment SimpleAggregationHashTable::Iterator aht_iterator_;
+  /** The partition tables of the groups in memory */
+  std::vector<SimpleAggregationHashTable> partitions_;
+  /** The thread-local pre-aggregation tables, per task scheduler slot and partition */
+  std::vector<std::vector<SimpleAggregationHashTable>> local_tables_;
+  /** The level 0 spill files, one per partition, empty if nothing was spilled */
+  std::vector<std::unique_ptr<SpillFile>> spill_files_;
+  /** The spilled partitions left to merge */
+  std::vector<SpilledPartition> pending_partitions_;
+
+  /** The partition being emitted, and the next group to emit in it */
+  size_t output_partition_{0};
+  size_t output_idx_{0};
+  /** Whether the single row of an aggregation without groups over an empty input must be emitted */
+  bool emit_empty_row_{false};
 };
 }  // namespace bustub
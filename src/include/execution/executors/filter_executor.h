@@ -13,10 +13,12 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/expression_program.h"
 #include "execution/plans/filter_plan.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "storage/table/tuple.h"
@@ -24,7 +26,8 @@
 namespace bustub {
 
 /**
- * The FilterExecutor executor executes a filter.
+ * The FilterExecutor executor executes a filter. NextBatch() evaluates the predicate compiled into an ExpressionProgram
+ * when the compiler handles it.
  */
 class FilterExecutor : public AbstractExecutor {
  public:
@@ -48,6 +51,18 @@ class FilterExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples satisfying the predicate. The child batch is filtered in place.
+   * @param[out] batch The next batch produced by the filter
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
+  /** Runtime filters see the same tuples as the predicate, so they are passed on to the child. */
+  auto PushDownRuntimeFilter(const RuntimeFilterRef &filter) -> bool override {
+    return child_executor_->PushDownRuntimeFilter(filter);
+  }
+
   /** @return The output schema for the filter plan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
@@ -57,5 +72,9 @@ class FilterExecutor : public AbstractExecutor {
 
   /** The child executor from which tuples are obtained */
   std::unique_ptr<AbstractExecutor> child_executor_;
+
+  /** The compiled predicate, if it could be compiled, and the positions of the tuples it selects in a batch */
+  std::optional<ExpressionProgram> program_;
+  std::vector<uint32_t> selection_;
 };
 }  // namespace bustub
@@ -13,17 +13,64 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/join_hash_table.h"
 #include "execution/plans/hash_join_plan.h"
+#include "execution/runtime_filter.h"
+#include "storage/table/spill_file.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * HashJoinExecutor executes a nested-loop JOIN on two tables.
+ * JoinKeyFilter is the runtime filter an inner HashJoinExecutor pushes into its probe side once the build side is
+ * read: a probe tuple whose join key is null, falls outside the range of the build keys, or misses the Bloom filter of
+ * the build key hashes cannot match any build tuple, and is dropped.
+ */
+class JoinKeyFilter : public RuntimeFilter {
+ public:
+  /**
+   * @param key_exprs the expressions computing the join key of a probe tuple
+   * @param key_min the smallest value of every build key component, empty if the build side is empty
+   * @param key_max the largest value of every build key component, empty if the build side is empty
+   * @param bloom_filter the hashes of the build keys, as computed by PartitionedJoinHashTable::HashKey(), or nullptr
+   * to only check the range
+   */
+  JoinKeyFilter(std::vector<AbstractExpressionRef> key_exprs, std::vector<Value> key_min, std::vector<Value> key_max,
+                std::unique_ptr<BlockedBloomFilter> bloom_filter)
+      : key_exprs_(std::move(key_exprs)),
+        key_min_(std::move(key_min)),
+        key_max_(std::move(key_max)),
+        bloom_filter_(std::move(bloom_filter)) {}
+
+  auto Check(const Tuple &tuple, const Schema &schema) const -> bool override;
+
+  auto ReadsOnlyLeadingColumns(uint32_t num_columns) const -> bool override;
+
+ private:
+  std::vector<AbstractExpressionRef> key_exprs_;
+  std::vector<Value> key_min_;
+  std::vector<Value> key_max_;
+  std::unique_ptr<BlockedBloomFilter> bloom_filter_;
+};
+
+/**
+ * HashJoinExecutor executes a hybrid hash JOIN on two tables. The right child is the build side: it is materialized in
+ * Init() and loaded into a PartitionedJoinHashTable, in parallel if the executor context has a task scheduler. The left
+ * child is then streamed through the table.
+ *
+ * If the build side outgrows the memory budget of the executor context, the build tuples are hash-partitioned into
+ * SPILL_FANOUT partitions. Partition 0 stays in memory as long as it fits and the other partitions are written to spill
+ * files, along with the left tuples that hash to them. Once the left child is exhausted, the spilled partitions are
+ * joined one at a time, and partitions that still do not fit are partitioned again on the next bits of the hash.
+ *
+ * Once the build side is read, an inner join pushes a JoinKeyFilter on the build keys into the left child, so that the
+ * probe tuples without a match are dropped by the scan below instead of being probed, or spilled.
  */
 class HashJoinExecutor : public AbstractExecutor {
  public:
@@ -48,12 +95,124 @@ class HashJoinExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of joined tuples, filled by the probe loop with the matches of the probe tuples.
+   * @param[out] batch The next batch produced by the join
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
+  /**
+   * Filters on the output of the join that only read the columns of the left child are pushed into it: they drop all
+   * the output tuples of a left tuple or none of them.
+   */
+  auto PushDownRuntimeFilter(const RuntimeFilterRef &filter) -> bool override {
+    return filter->ReadsOnlyLeadingColumns(left_executor_->GetOutputSchema().GetColumnCount()) &&
+           left_executor_->PushDownRuntimeFilter(filter);
+  }
+
   /** @return The output schema for the join */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
+  /** Number of partitions a spilling build side is split into, at every level */
+  static constexpr size_t SPILL_FANOUT_BITS = 3;
+  static constexpr size_t SPILL_FANOUT = 1 << SPILL_FANOUT_BITS;
+  /** Spilled partitions are not split again past this level, e.g. when they only hold duplicates of one key */
+  static constexpr size_t MAX_SPILL_LEVEL = 4;
+  /**
+   * Past this many build tuples the JoinKeyFilter only checks the range of the keys: the hashes collected for its
+   * Bloom filter would take too much memory, and the filter itself would no longer fit in cache.
+   */
+  static constexpr size_t MAX_BLOOM_FILTER_KEYS = 1 << 22;
+  static_assert(PartitionedJoinHashTable::BUCKET_HASH_BITS + (MAX_SPILL_LEVEL + 1) * SPILL_FANOUT_BITS +
+                        PartitionedJoinHashTable::MAX_RADIX_BITS <=
+                    sizeof(hash_t) * 8,
+                "the spill partitions must not share hash bits with the buckets or the radix partitions");
+
  private:
-  /** The NestedLoopJoin plan node to be executed. */
+  /** A build partition and the probe tuples routed to it, written to spill files */
+  struct SpilledPartition {
+    std::unique_ptr<SpillFile> build_;
+    std::unique_ptr<SpillFile> probe_;
+    size_t level_;
+  };
+
+  /** @return the join key of a tuple of the left or right child */
+  auto EvaluateKey(const Tuple &tuple, bool is_left) const -> std::vector<Value>;
+
+  /** @return the spill partition of a key hash at a level of partitioning */
+  static auto SpillPartitionOf(hash_t hash, size_t level) -> size_t {
+    // The low bits pick hash table buckets and the high bits pick the radix partitions of the hash table, the spill
+    // partitions take the bits in between.
+    return (hash >> (PartitionedJoinHashTable::BUCKET_HASH_BITS + level * SPILL_FANOUT_BITS)) & (SPILL_FANOUT - 1);
+  }
+
+  /** @return a rough estimate of the memory taken in the hash table by build tuples of `data_size` bytes in total */
+  auto EstimateBuildMemory(size_t data_size, size_t num_tuples) const -> size_t;
+
+  /** Add a right tuple to the build side, spilling if the memory budget is exceeded. */
+  void AddBuildTuple(Tuple &&tuple);
+
+  /** Add a right tuple to the partitioned build side. */
+  void RouteBuildTuple(Tuple &&tuple, hash_t hash);
+
+  /** Record the key of a build tuple in the runtime filter being collected. */
+  void CollectFilterKey(const std::vector<Value> &key, hash_t hash);
+
+  /** Push a JoinKeyFilter on the collected build keys into the left child. */
+  void PushDownJoinKeyFilter();
+
+  /** Move on to the next probe tuple, from the left child or from a spilled partition. */
+  auto NextProbeTuple() -> bool;
+
+  /** Look up the matches of the current probe tuple into matches_, or spill it. */
+  void ProbeTuple();
+
+  /** Load the next spilled partition into the hash table, splitting it further if it is still too large. */
+  auto LoadNextPartition() -> bool;
+
+  /** @return the output tuple joining a left tuple with a right tuple, or with nulls if `right_tuple` is null */
+  auto MakeOutputTuple(const Tuple &left_tuple, const Tuple *right_tuple) const -> Tuple;
+
+  /** The HashJoin plan node to be executed. */
   const HashJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  std::unique_ptr<AbstractExecutor> right_executor_;
+  /** The hash table on the right child, or on the spilled partition being joined */
+  PartitionedJoinHashTable hash_table_;
+
+  /** Whether the build keys are collected for a JoinKeyFilter, only for an inner join */
+  bool collect_filter_keys_{false};
+  /** The range of every build key component, and the hashes of the build keys for the Bloom filter */
+  std::vector<Value> filter_key_min_;
+  std::vector<Value> filter_key_max_;
+  std::vector<hash_t> filter_hashes_;
+  bool filter_hashes_overflow_{false};
+
+  /** The build tuples kept in memory, and their estimated footprint */
+  std::vector<Tuple> resident_tuples_;
+  size_t resident_memory_{0};
+  /** The level 0 partitions, empty if the build side fits in memory */
+  std::vector<SpilledPartition> spill_partitions_;
+  /** Whether partition 0 is kept in memory while the build side is partitioned */
+  bool partition0_resident_{true};
+  /** The spilled partitions left to join */
+  std::vector<SpilledPartition> pending_partitions_;
+  /** The spilled partition being joined, and the reader of its probe tuples */
+  std::optional<SpilledPartition> current_partition_;
+  std::optional<SpillFile::Reader> probe_reader_;
+
+  /** The left tuples being read */
+  TupleBatch left_batch_;
+  /** The position of the next left tuple in left_batch_ */
+  size_t left_idx_{0};
+  bool left_done_{false};
+  /** The left tuple being probed */
+  Tuple probe_tuple_;
+  /** The right tuples matching the current probe tuple, nullptr standing for the null row of a left join */
+  std::vector<const Tuple *> matches_;
+  /** The next match of the current probe tuple to emit */
+  size_t match_idx_{0};
 };
 
 }  // namespace bustub
@@ -0,0 +1,119 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_executor.h
+//
+// Identification: src/include/execution/executors/merge_join_executor.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/sort_key.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * MergeJoinExecutor executes a sort-merge JOIN on two children sorted on their join keys. Both children are streamed:
+ * for every left tuple, the right child is advanced past the smaller keys, and the run of right tuples equal to the
+ * key is buffered, so that the following left tuples with the same key join with it without reading the right child
+ * again. Only the current run is kept in memory, no hash table is built.
+ *
+ * Keys are compared like ORDER BY compares them, with nulls first, but a key with a null never matches.
+ */
+class MergeJoinExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new MergeJoinExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The MergeJoin join plan to be executed
+   * @param left_child The child executor that produces tuples for the left side of join, sorted on the left keys
+   * @param right_child The child executor that produces tuples for the right side of join, sorted on the right keys
+   */
+  MergeJoinExecutor(ExecutorContext *exec_ctx, const MergeJoinPlanNode *plan,
+                    std::unique_ptr<AbstractExecutor> &&left_child, std::unique_ptr<AbstractExecutor> &&right_child);
+
+  /** Initialize the join */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the join.
+   * @param[out] tuple The next tuple produced by the join.
+   * @param[out] rid The next tuple RID, not used by merge join.
+   * @return `true` if a tuple was produced, `false` if there are no more tuples.
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /**
+   * Yield the next batch of joined tuples.
+   * @param[out] batch The next batch produced by the join
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
+  /** @return The output schema for the join */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
+
+ private:
+  /** @return the join key of a tuple of the left or right child */
+  auto EvaluateKey(const Tuple &tuple, bool is_left) const -> std::vector<Value>;
+
+  /** @return whether the key has a null, and cannot match any other key */
+  static auto HasNull(const std::vector<Value> &key) -> bool;
+
+  /** Move on to the next left tuple and its key. */
+  auto NextLeftTuple() -> bool;
+
+  /** Make sure right_tuple_ and right_key_ are the next right tuple, unless the right child is exhausted. */
+  auto PeekRightTuple() -> bool;
+
+  /** Look up the matches of the current left tuple into matches_, reading the right child up to its key. */
+  void MatchLeftTuple();
+
+  /** @return the output tuple joining a left tuple with a right tuple, or with nulls if `right_tuple` is null */
+  auto MakeOutputTuple(const Tuple &left_tuple, const Tuple *right_tuple) const -> Tuple;
+
+  /** The MergeJoin plan node to be executed. */
+  const MergeJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  std::unique_ptr<AbstractExecutor> right_executor_;
+  /** Compares left keys with right keys, in the order both children are sorted in */
+  SortKeyComparator comparator_;
+
+  /** The left tuples being read, and the position of the next one */
+  TupleBatch left_batch_;
+  size_t left_idx_{0};
+  /** The left tuple being joined, and its key */
+  Tuple left_tuple_;
+  std::vector<Value> left_key_;
+
+  /** The right tuples being read, and the position of the next one */
+  TupleBatch right_batch_;
+  size_t right_idx_{0};
+  bool right_done_{false};
+  /** The key of the next right tuple, at right_batch_[right_idx_], if it was evaluated */
+  std::vector<Value> right_key_;
+  bool right_key_valid_{false};
+
+  /** The run of right tuples with the key run_key_, which the last matched left tuples joined with */
+  std::vector<Tuple> run_;
+  std::vector<Value> run_key_;
+
+  /** The right tuples matching the current left tuple, nullptr standing for the null row of a left join */
+  std::vector<const Tuple *> matches_;
+  /** The next match of the current left tuple to emit */
+  size_t match_idx_{0};
+};
+
+}  // namespace bustub
@@ -25,6 +25,7 @@ namespace bustub {
 
 extern const char *mock_table_list[];
 auto GetMockTableSchemaOf(const std::string &table) -> Schema;
+auto GetSizeOf(const MockScanPlanNode *plan) -> size_t;
 
 /**
  * The MockScanExecutor executor executes a sequential table scan for tests.
@@ -49,6 +50,19 @@ class MockScanExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the sequential scan.
+   * @param[out] batch The next batch produced by the scan
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
+  /** Runtime filters are applied to the generated tuples before they are returned. */
+  auto PushDownRuntimeFilter(const RuntimeFilterRef &filter) -> bool override {
+    runtime_filters_.push_back(filter);
+    return true;
+  }
+
   /** @return The output schema for the sequential scan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
@@ -79,6 +93,9 @@ class MockScanExecutor : public AbstractExecutor {
 
   /** The shuffled output */
   std::vector<size_t> shuffled_idx_;
+
+  /** The runtime filters pushed down by the parents since the last Init() */
+  std::vector<RuntimeFilterRef> runtime_filters_;
 };
 
 }  // namespace bustub
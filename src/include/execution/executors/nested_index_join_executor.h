@@ -28,7 +28,9 @@
 namespace bustub {
 
 /**
- * IndexJoinExecutor executes index join operations.
+ * IndexJoinExecutor executes index join operations. The outer tuples are read a batch at a time, and the join keys of
+ * a whole batch are looked up in the index at once with Index::ScanKeys(), which lets a B+ tree sort them and sweep
+ * its leaves once per batch instead of descending from the root for every outer tuple.
  */
 class NestIndexJoinExecutor : public AbstractExecutor {
  public:
@@ -47,8 +49,32 @@ class NestIndexJoinExecutor : public AbstractExecutor {
 
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
  private:
+  /** Read the next batch of outer tuples and look up all their keys in the index. */
+  auto ProbeNextBatch() -> bool;
+
+  /** @return the output tuple joining an outer tuple with an inner tuple, or with nulls if `inner_tuple` is null */
+  auto MakeOutputTuple(const Tuple &outer_tuple, const Tuple *inner_tuple) const -> Tuple;
+
   /** The nested index join plan node. */
   const NestedIndexJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  const IndexInfo *index_info_;
+  const TableInfo *table_info_;
+
+  /** The outer tuples being joined, and the RIDs of the inner tuples matching each of them */
+  TupleBatch outer_batch_;
+  std::vector<std::vector<RID>> matches_;
+  /** The next outer tuple to join, and its next match */
+  size_t outer_idx_{0};
+  size_t match_idx_{0};
+  /** Whether the current outer tuple produced any output, for left joins */
+  bool outer_matched_{false};
+
+  /** The batch that Next() is served from */
+  TupleBatch output_;
+  size_t output_idx_{0};
 };
 }  // namespace bustub
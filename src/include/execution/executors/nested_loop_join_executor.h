@@ -13,17 +13,26 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/expression_program.h"
 #include "execution/plans/nested_loop_join_plan.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * NestedLoopJoinExecutor executes a nested-loop JOIN on two tables.
+ * NestedLoopJoinExecutor executes a block nested-loop JOIN on two tables. The left child is read in blocks of as many
+ * tuples as fit in the memory budget of the executor context, and the right child is scanned once per block, i.e. it
+ * is re-initialized for every block rather than for every left tuple. Each right tuple is joined with the whole block
+ * in a tight loop over the predicate, or by a single evaluation of the predicate compiled into an ExpressionProgram
+ * when the compiler handles it.
+ *
+ * The output of a block is ordered by right tuple first, then by left tuple.
  */
 class NestedLoopJoinExecutor : public AbstractExecutor {
  public:
@@ -49,12 +58,65 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of joined tuples.
+   * @param[out] batch The next batch produced by the join
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
   /** @return The output schema for the insert */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
+  /** @return The number of blocks of left tuples read since Init(), each of them scanning the right child once */
+  auto GetBlockCount() const -> size_t { return block_count_; }
+
  private:
+  /** Read the next block of left tuples and start scanning the right child for it. */
+  auto LoadBlock() -> bool;
+
+  /** @return whether the predicate holds for a left and a right tuple */
+  auto Matches(const Tuple &left_tuple, const Tuple &right_tuple) const -> bool;
+
+  /** @return the output tuple joining a left tuple with a right tuple, or with nulls if `right_tuple` is null */
+  auto MakeOutputTuple(const Tuple &left_tuple, const Tuple *right_tuple) const -> Tuple;
+
   /** The NestedLoopJoin plan node to be executed. */
   const NestedLoopJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  std::unique_ptr<AbstractExecutor> right_executor_;
+
+  /** The left tuples being read, and the position of the next one */
+  TupleBatch left_batch_;
+  size_t left_idx_{0};
+  bool left_done_{false};
+
+  /** The current block of left tuples, and whether each of them matched a right tuple, for left joins */
+  std::vector<Tuple> block_;
+  std::vector<bool> block_matched_;
+  bool block_loaded_{false};
+  size_t block_count_{0};
+
+  /** The right tuples being read, the position of the current one, and the next block tuple to join it with */
+  TupleBatch right_batch_;
+  size_t right_idx_{0};
+  size_t block_idx_{0};
+  bool right_done_{false};
+
+  /** The compiled predicate, if it could be compiled */
+  std::optional<ExpressionProgram> program_;
+  /**
+   * With a compiled predicate, the positions of the block tuples matching the current right tuple, and whether they
+   * were computed yet. block_idx_ is then a position in block_selection_.
+   */
+  std::vector<uint32_t> block_selection_;
+  bool right_selected_{false};
+
+  /** The next left tuple of the block to check for a null row, once the right child is exhausted */
+  size_t unmatched_idx_{0};
+
+  /** The single-tuple batch that Next() is served from */
+  TupleBatch next_batch_{1};
 };
 
 }  // namespace bustub
@@ -13,10 +13,12 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/expression_program.h"
 #include "execution/plans/projection_plan.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "storage/table/tuple.h"
@@ -24,7 +26,8 @@
 namespace bustub {
 
 /**
- * The ProjectionExecutor executor executes a projection.
+ * The ProjectionExecutor executor executes a projection. NextBatch() evaluates the expressions compiled into an
+ * ExpressionProgram when the compiler handles all of them.
  */
 class ProjectionExecutor : public AbstractExecutor {
  public:
@@ -47,6 +50,13 @@ class ProjectionExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of projected tuples, computed from one batch of the child executor.
+   * @param[out] batch The next batch produced by the projection
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
   /** @return The output schema for the projection plan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
@@ -56,5 +66,11 @@ class ProjectionExecutor : public AbstractExecutor {
 
   /** The child executor from which tuples are obtained */
   std::unique_ptr<AbstractExecutor> child_executor_;
+
+  /** The batch of child tuples being projected by NextBatch() */
+  TupleBatch child_batch_;
+
+  /** The compiled expressions, if they could be compiled */
+  std::optional<ExpressionProgram> program_;
 };
 }  // namespace bustub
@@ -12,17 +12,30 @@
 
 #pragma once
 
+#include <optional>
 #include <vector>
 
+#include "catalog/catalog.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/expression_program.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "execution/runtime_filter.h"
+#include "storage/table/table_iterator.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
  * The SeqScanExecutor executor executes a sequential table scan.
+ *
+ * With a task scheduler, a table of several morsels (see TableHeap::MakeMorsels()) is scanned in parallel, a wave of
+ * one morsel per slot at a time: every task reads and filters its morsel on its own, and the tuples of the wave are
+ * then returned in table order.
+ *
+ * Tuples are read in place from the pinned pages of the table, as TupleRefs, and only those that pass the filter
+ * predicate are copied into the batch. When the predicate can be compiled into an ExpressionProgram, it is evaluated on
+ * the tuples of a page at once. Runtime filters pushed down by a parent are applied together with the predicate.
  */
 class SeqScanExecutor : public AbstractExecutor {
  public:
@@ -44,11 +57,61 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the sequential scan.
+   * @param[out] batch The batch filled with the next tuples produced by the scan
+   * @return `true` if at least one tuple was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
+  /** Runtime filters are checked on every tuple read from the table, before it is added to a batch. */
+  auto PushDownRuntimeFilter(const RuntimeFilterRef &filter) -> bool override {
+    runtime_filters_.push_back(filter);
+    return true;
+  }
+
   /** @return The output schema for the sequential scan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
  private:
+  /** The state of a task of the scan */
+  struct ScanTask {
+    /** The compiled filter predicate, if it could be compiled, and the positions of the tuples it selects */
+    std::optional<ExpressionProgram> program_;
+    std::vector<uint32_t> selection_;
+    /** The tuples of the page being read */
+    std::vector<TupleRef> tuples_;
+  };
+
+  /** Read the next tuples of an iterator that pass the filters into a batch, as many as it has room for. */
+  void ReadTuples(TableIterator *iter, TupleBatch *batch, ScanTask *task) const;
+
+  /** Copy a tuple into a batch if it passes the filters, the filter predicate having been evaluated if compiled. */
+  void AppendIfSelected(const TupleRef &tuple, bool evaluate_predicate, TupleBatch *batch) const;
+
+  /** Scan the next wave of morsels in parallel */
+  void ScanMorselWave();
+
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
+  /** The table being scanned */
+  const TableInfo *table_info_;
+  /** The iterator of a serial scan */
+  std::optional<TableIterator> iter_;
+  /** The morsels scanned in parallel, empty for a serial scan, and the next one to scan */
+  std::vector<TableMorsel> morsels_;
+  size_t next_morsel_{0};
+  /** The tuples read from the current wave of morsels, in table order, and the next one to return */
+  std::vector<TupleBatch> wave_;
+  size_t wave_idx_{0};
+  size_t wave_tuple_idx_{0};
+  /** The filter predicate compiled once, if it could be compiled, and the tasks of the scan, one per slot */
+  std::optional<ExpressionProgram> program_;
+  std::vector<ScanTask> tasks_;
+  /** The runtime filters pushed down since Init() */
+  std::vector<RuntimeFilterRef> runtime_filters_;
+  /** The tuples produced by NextBatch() for Next() */
+  TupleBatch batch_;
+  size_t batch_idx_{0};
 };
 }  // namespace bustub
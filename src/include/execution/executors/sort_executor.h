@@ -13,18 +13,31 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/loser_tree.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/sort_plan.h"
+#include "execution/sort_key.h"
+#include "storage/table/spill_file.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
  * The SortExecutor executor executes a sort.
+ *
+ * Tuples are sorted on normalized keys: every tuple gets a fixed-size, memcmp-able encoding of its ORDER BY key, and
+ * (normalized key, position) pairs are sorted in parallel chunks that are then merged pairwise. Full key comparisons
+ * only happen on ties, and only when the normalized key is a truncated prefix of the key.
+ *
+ * Child tuples are sorted in memory as long as they fit in the memory budget of the executor context. Beyond that, the
+ * sort becomes an external merge sort: every time the buffered tuples exceed the budget they are sorted and written as
+ * a run to a spill file, and the runs are merged with a loser tree. If there are more runs than can be merged at once,
+ * intermediate passes merge groups of runs into longer runs first.
  */
 class SortExecutor : public AbstractExecutor {
  public:
@@ -52,5 +65,64 @@ class SortExecutor : public AbstractExecutor {
  private:
   /** The sort plan node to be executed */
   const SortPlanNode *plan_;
+
+  /** A sorted run being merged, and its smallest tuple not merged yet */
+  struct MergeSource {
+    SpillFile::Reader reader_;
+    SortEntry head_;
+    bool exhausted_;
+  };
+
+  /** Orders merge sources by their heads, exhausted sources last, ties broken by run order to keep the sort stable */
+  struct MergeSourceLess {
+    auto operator()(size_t lhs, size_t rhs) const -> bool;
+
+    const std::vector<MergeSource> *sources_;
+    const SortKeyComparator *comparator_;
+  };
+
+  /** @return a rough estimate of the memory taken by a buffered tuple */
+  static auto EstimateMemory(const SortEntry &entry) -> size_t;
+
+  /** A buffered tuple being sorted, by its normalized key and then by its position */
+  struct SortRef {
+    NormalizedSortKey normalized_key_;
+    uint32_t idx_;
+  };
+
+  /** Sort the buffered tuples, stable. */
+  void SortBuffer();
+
+  /** Sort the buffered tuples and write them out as a run. */
+  void SpillRun();
+
+  /** Read the next tuple of a run and evaluate its key. */
+  auto ReadEntry(SpillFile::Reader *reader, SortEntry *entry) const -> bool;
+
+  /** Start merging runs. */
+  void StartMerge(std::vector<std::unique_ptr<SpillFile>> runs);
+
+  /** Pop the next tuple of the runs being merged. */
+  auto MergeNext(SortEntry *entry) -> bool;
+
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  SortKeyComparator comparator_;
+  SortKeyNormalizer normalizer_;
+
+  /** The tuples buffered in memory, sorted once the child is exhausted if the sort did not spill */
+  std::vector<SortEntry> buffer_;
+  size_t buffer_memory_{0};
+  /** The next tuple of buffer_ to emit */
+  size_t buffer_idx_{0};
+
+  /** The sorted runs written so far */
+  std::vector<std::unique_ptr<SpillFile>> runs_;
+  /** The runs being merged, their heads and the tree merging them */
+  std::vector<std::unique_ptr<SpillFile>> merge_runs_;
+  std::vector<MergeSource> merge_sources_;
+  std::optional<LoserTree<MergeSourceLess>> merge_tree_;
+
+  /** Inputs smaller than this are not worth sorting in parallel */
+  static constexpr size_t MIN_PARALLEL_SORT_CHUNK = 4096;
 };
 }  // namespace bustub
@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// streaming_aggregation_executor.h
+//
+// Identification: src/include/execution/executors/streaming_aggregation_executor.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/executors/aggregation_executor.h"
+#include "execution/plans/streaming_aggregation_plan.h"
+#include "execution/tuple_batch.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * StreamingAggregationExecutor aggregates a child that produces the tuples of every group consecutively. Only the
+ * running aggregate of the current group is kept, and a group is emitted as soon as the first tuple of the next group
+ * arrives, so the aggregation takes constant memory and produces its first groups before the input is exhausted.
+ */
+class StreamingAggregationExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new StreamingAggregationExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The streaming aggregation plan to be executed
+   * @param child The child executor, producing the tuples of a group consecutively
+   */
+  StreamingAggregationExecutor(ExecutorContext *exec_ctx, const StreamingAggregationPlanNode *plan,
+                               std::unique_ptr<AbstractExecutor> &&child);
+
+  /** Initialize the aggregation */
+  void Init() override;
+
+  /**
+   * Yield the next group from the aggregation.
+   * @param[out] tuple The next tuple produced by the aggregation
+   * @param[out] rid The next tuple RID produced by the aggregation
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /** @return The output schema for the aggregation */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
+
+ private:
+  /** @return the output tuple of the current group */
+  auto MakeOutputTuple() const -> Tuple;
+
+  /** The streaming aggregation plan node */
+  const StreamingAggregationPlanNode *plan_;
+  /** The child executor that produces tuples over which the aggregation is computed */
+  std::unique_ptr<AbstractExecutor> child_;
+  /** Only used for its aggregate functions: it never holds any group */
+  SimpleAggregationHashTable aggregator_;
+
+  /** The tuples being read, and the position of the next one */
+  TupleBatch batch_;
+  size_t batch_idx_{0};
+  bool child_done_{false};
+  /** The current group: its serialized key and running aggregate, if it has seen a tuple */
+  bool has_group_{false};
+  std::string group_key_;
+  AggregateValue group_value_;
+};
+
+}  // namespace bustub
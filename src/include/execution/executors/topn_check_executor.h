@@ -46,6 +46,11 @@ class TopNCheckExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /** The boundary filter of the top-n goes through to the child executor. */
+  auto PushDownRuntimeFilter(const RuntimeFilterRef &filter) -> bool override {
+    return child_executor_ != nullptr && child_executor_->PushDownRuntimeFilter(filter);
+  }
+
   /** @return The output schema for the child executor */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
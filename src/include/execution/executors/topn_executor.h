@@ -20,12 +20,46 @@
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/topn_plan.h"
+#include "execution/runtime_filter.h"
+#include "execution/sort_key.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * The TopNExecutor executor executes a topn.
+ * TopNBoundaryFilter is the runtime filter a TopNExecutor pushes into its child once its heap is full: a tuple whose
+ * key does not sort strictly before the current N-th key cannot make it into the top N, and is dropped.
+ */
+class TopNBoundaryFilter : public RuntimeFilter {
+ public:
+  explicit TopNBoundaryFilter(const OrderBys &order_bys)
+      : order_bys_(order_bys), normalizer_(order_bys), comparator_(order_bys) {}
+
+  /** Replace the boundary with the key of the current N-th tuple. */
+  void SetBoundary(const NormalizedSortKey &normalized_key, const std::vector<Value> &key);
+
+  auto Check(const Tuple &tuple, const Schema &schema) const -> bool override;
+
+  auto ReadsOnlyLeadingColumns(uint32_t num_columns) const -> bool override;
+
+ private:
+  struct Boundary {
+    NormalizedSortKey normalized_key_;
+    std::vector<Value> key_;
+  };
+
+  OrderBys order_bys_;
+  SortKeyNormalizer normalizer_;
+  SortKeyComparator comparator_;
+  /** The current boundary, null until the heap is full. Accessed with std::atomic_load() / std::atomic_store(). */
+  std::shared_ptr<const Boundary> boundary_;
+};
+
+/**
+ * The TopNExecutor executor executes a topn. It keeps the best N tuples seen so far in a bounded max-heap ordered on
+ * normalized sort keys, whose root is the current N-th tuple. Once the heap is full, the key of the root is a boundary
+ * that every later tuple must beat: it is published to the child as a TopNBoundaryFilter so that the scan below drops
+ * hopeless tuples before they travel up the pipeline.
  */
 class TopNExecutor : public AbstractExecutor {
  public:
@@ -59,9 +93,39 @@ class TopNExecutor : public AbstractExecutor {
   auto GetNumInHeap() -> size_t;
 
  private:
+  /** A heap entry: the normalized key of a tuple in entries_, and its arrival order to keep the output stable */
+  struct HeapEntry {
+    NormalizedSortKey normalized_key_;
+    uint64_t seq_;
+    uint32_t slot_;
+  };
+
+  /** @return `true` if the tuple with the given key and sequence number sorts before the heap entry */
+  auto SortsBefore(const NormalizedSortKey &normalized_key, const std::vector<Value> &key, uint64_t seq,
+                   const HeapEntry &entry) const -> bool;
+
+  /** Offer a tuple to the heap. */
+  void Consume(Tuple tuple);
+
+  /** Publish the key of the heap root as the new boundary. */
+  void PublishBoundary();
+
   /** The topn plan node to be executed */
   const TopNPlanNode *plan_;
   /** The child executor from which tuples are obtained */
   std::unique_ptr<AbstractExecutor> child_executor_;
+
+  SortKeyComparator comparator_;
+  SortKeyNormalizer normalizer_;
+  /** The heap of the best tuples seen so far, with the worst one at the root */
+  std::vector<HeapEntry> heap_;
+  /** The tuples referenced by the heap. The slot of an evicted tuple is reused by the one replacing it. */
+  std::vector<SortEntry> entries_;
+  uint64_t next_seq_{0};
+  /** The boundary filter, null if the child did not accept it */
+  std::shared_ptr<TopNBoundaryFilter> boundary_filter_;
+  /** The top N, in output order, and the next one to emit */
+  std::vector<uint32_t> output_;
+  size_t output_idx_{0};
 };
 }  // namespace bustub
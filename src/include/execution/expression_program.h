@@ -0,0 +1,185 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// expression_program.h
+//
+// Identification: src/include/execution/expression_program.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/config.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "storage/table/data_chunk.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * ExpressionProgram is a list of expression trees compiled into a flat sequence of instructions over typed registers,
+ * and evaluated on a batch of tuples at a time instead of walking the trees once per tuple.
+ *
+ * A register is a ColumnVector holding one value per tuple of the batch, or a single value shared by every tuple for
+ * constants and for the columns of the right tuple of a join. Boolean registers hold a bitmap instead, so that
+ * comparisons produce one bit per tuple and AND/OR combine 64 tuples per instruction. Every instruction is bound at
+ * compile time to a kernel of vector_kernels.h instantiated for the types of its operands, so that the loop over the
+ * tuples makes no virtual call and builds no Value. Operands of different numeric types are first cast to the wider
+ * type, as Value comparisons do.
+ *
+ * Expressions the compiler does not handle, such as string functions or comparisons that go through a cast to
+ * VARCHAR, are left to AbstractExpression::Evaluate(): Compile() returns std::nullopt for them.
+ *
+ * A program evaluates into its own registers: threads evaluating the same expressions each need a copy.
+ */
+class ExpressionProgram {
+ public:
+  /**
+   * Compile expressions evaluated on the tuples of a schema, as by AbstractExpression::Evaluate().
+   * @return the program, or std::nullopt if an expression cannot be compiled
+   */
+  static auto Compile(const std::vector<AbstractExpressionRef> &exprs, const Schema &schema)
+      -> std::optional<ExpressionProgram>;
+
+  /**
+   * Compile a predicate evaluated on the tuples of a schema, for Select().
+   * @return the program, or std::nullopt if the predicate cannot be compiled or is not a boolean
+   */
+  static auto CompilePredicate(const AbstractExpressionRef &predicate, const Schema &schema)
+      -> std::optional<ExpressionProgram>;
+
+  /**
+   * Compile a join predicate evaluated on many left tuples and one right tuple, as by
+   * AbstractExpression::EvaluateJoin().
+   * @return the program, or std::nullopt if the predicate cannot be compiled or is not a boolean
+   */
+  static auto CompileJoin(const AbstractExpressionRef &predicate, const Schema &left_schema,
+                          const Schema &right_schema) -> std::optional<ExpressionProgram>;
+
+  /**
+   * Evaluate the expressions on a batch of tuples.
+   * @param tuples the tuples, or the left tuples of a join
+   * @param num_tuples the number of tuples, at most BATCH_SIZE
+   * @param right_tuple the right tuple of a join, nullptr if the program is not a join predicate
+   */
+  void Evaluate(const Tuple *tuples, size_t num_tuples, const Tuple *right_tuple = nullptr);
+
+  /** Evaluate the expressions on a batch of tuples read in place, e.g. from a table page. */
+  void Evaluate(const TupleRef *tuples, size_t num_tuples, const TupleRef *right_tuple = nullptr);
+
+  /** @return the value of an expression on a tuple of the last Evaluate() */
+  auto GetValue(size_t expr_idx, size_t tuple_idx) const -> Value;
+
+  /**
+   * Evaluate a predicate, the first expression of the program, on any number of tuples.
+   * @param tuples the tuples, or the left tuples of a join
+   * @param num_tuples the number of tuples
+   * @param right_tuple the right tuple of a join, nullptr if the program is not a join predicate
+   * @param[out] selection the positions of the tuples the predicate is true on, in increasing order
+   */
+  void Select(const Tuple *tuples, size_t num_tuples, const Tuple *right_tuple, std::vector<uint32_t> *selection);
+
+  /** Evaluate a predicate on tuples read in place, e.g. from a table page, so that only the selected ones get copied. */
+  void Select(const TupleRef *tuples, size_t num_tuples, const TupleRef *right_tuple,
+              std::vector<uint32_t> *selection);
+
+  /** Tuples evaluated by one Evaluate(), and the size of the registers */
+  static constexpr size_t BATCH_SIZE = BUSTUB_BATCH_SIZE;
+
+ private:
+  struct Register {
+    ColumnVector vector_;
+    /** The values of a BOOLEAN register, one bit per row, cleared on null rows */
+    std::vector<uint64_t> bits_;
+    /** Whether the register holds a single value shared by every tuple */
+    bool is_scalar_;
+    /** Whether the register holds a constant, set at compile time and kept across evaluations */
+    bool is_constant_;
+  };
+
+  /** Load a column of tuples into a register */
+  using LoadKernel = void (*)(const TupleRef *tuples, size_t num_tuples, uint32_t offset, bool is_inlined,
+                              Register *dst);
+  /** Compute a register from one or two operand registers, on `num_rows` rows */
+  using ComputeKernel = void (*)(const Register &lhs, const Register &rhs, Register *dst, size_t num_rows);
+
+  struct Instruction {
+    uint32_t dst_;
+    /** A load reads a column of the left or only tuples, or of the right tuple of a join */
+    LoadKernel load_;
+    uint32_t column_offset_;
+    bool column_inlined_;
+    bool from_right_;
+    /** A computation reads one or two registers, `rhs_` being equal to `lhs_` for a cast */
+    ComputeKernel compute_;
+    uint32_t lhs_;
+    uint32_t rhs_;
+  };
+
+  /** Words of the bitmap of a register */
+  static constexpr size_t BATCH_WORDS = (BATCH_SIZE + 63) / 64;
+
+  template <class T>
+  static void LoadColumn(const TupleRef *tuples, size_t num_tuples, uint32_t offset, bool is_inlined,
+                         Register *dst);
+  static void LoadBooleanColumn(const TupleRef *tuples, size_t num_tuples, uint32_t offset, bool is_inlined,
+                                Register *dst);
+  template <class From, class To>
+  static void Cast(const Register &src, const Register &unused, Register *dst, size_t num_rows);
+  template <class T, class Op>
+  static void Compare(const Register &lhs, const Register &rhs, Register *dst, size_t num_rows);
+  template <class Op>
+  static void CompareBooleans(const Register &lhs, const Register &rhs, Register *dst, size_t num_rows);
+  template <class T, class Op>
+  static void Arithmetic(const Register &lhs, const Register &rhs, Register *dst, size_t num_rows);
+  template <bool IS_AND>
+  static void Logic(const Register &lhs, const Register &rhs, Register *dst, size_t num_rows);
+
+  /** @return the comparison kernel of values of type T, with T = bool for BOOLEAN registers */
+  template <class T>
+  static auto PickCompare(ComparisonType comp_type) -> ComputeKernel;
+
+  /** Mark the rows on which an operand is null as null, and clear their bit if `dst` is a BOOLEAN register. */
+  static void PropagateNulls(const Register &lhs, const Register &rhs, Register *dst, size_t num_rows);
+
+  ExpressionProgram() = default;
+
+  /** Evaluate a predicate on at most BATCH_SIZE tuples, adding the positions it selects, plus `start`, to `selection` */
+  void SelectBatch(const TupleRef *tuples, size_t num_tuples, const TupleRef *right_tuple, size_t start,
+                   std::vector<uint32_t> *selection);
+
+  /** @return the register holding the value of an expression, or std::nullopt if it cannot be compiled */
+  auto CompileExpression(const AbstractExpressionRef &expr) -> std::optional<uint32_t>;
+
+  /** @return the register holding a column of the left (or only) schema, or of the right schema of a join */
+  auto CompileColumn(uint32_t tuple_idx, uint32_t col_idx) -> uint32_t;
+
+  /** @return the register holding the value of `src` cast to `type`, or std::nullopt if there is no such cast */
+  auto CompileCast(uint32_t src, TypeId type) -> std::optional<uint32_t>;
+
+  /** @return a new register */
+  auto AddRegister(TypeId type, bool is_scalar, bool is_constant) -> uint32_t;
+
+  /** The schema of the tuples, and of the right tuple of a join */
+  const Schema *left_schema_{nullptr};
+  const Schema *right_schema_{nullptr};
+  std::vector<Register> registers_;
+  std::vector<Instruction> instructions_;
+  /** The register of every column loaded so far, by (tuple index, column index), to load every column once */
+  std::vector<std::pair<std::pair<uint32_t, uint32_t>, uint32_t>> column_registers_;
+  /** The register holding the value of every compiled expression */
+  std::vector<uint32_t> outputs_;
+};
+
+}  // namespace bustub
@@ -32,37 +32,32 @@ namespace bustub {
 enum class ArithmeticType { Plus, Minus };
 
 /**
- * ArithmeticExpression represents two expressions being computed, ONLY SUPPORT INTEGER FOR NOW.
+ * ArithmeticExpression represents two expressions being computed. Both must be INTEGER, BIGINT or DECIMAL, of the same
+ * type. INTEGER arithmetic wraps around, BIGINT arithmetic fails on overflow as Value::Add() does.
  */
 class ArithmeticExpression : public AbstractExpression {
  public:
   /** Creates a new comparison expression representing (left comp_type right). */
   ArithmeticExpression(AbstractExpressionRef left, AbstractExpressionRef right, ArithmeticType compute_type)
-      : AbstractExpression({std::move(left), std::move(right)}, TypeId::INTEGER), compute_type_{compute_type} {
-    if (GetChildAt(0)->GetReturnType() != TypeId::INTEGER || GetChildAt(1)->GetReturnType() != TypeId::INTEGER) {
-      throw bustub::NotImplementedException("only support integer for now");
+      : AbstractExpression({left, std::move(right)}, left->GetReturnType()), compute_type_{compute_type} {
+    auto type = GetChildAt(0)->GetReturnType();
+    if (type != GetChildAt(1)->GetReturnType() ||
+        (type != TypeId::INTEGER && type != TypeId::BIGINT && type != TypeId::DECIMAL)) {
+      throw bustub::NotImplementedException("only support integer, bigint and decimal of the same type for now");
     }
   }
 
   auto Evaluate(const Tuple *tuple, const Schema &schema) const -> Value override {
     Value lhs = GetChildAt(0)->Evaluate(tuple, schema);
     Value rhs = GetChildAt(1)->Evaluate(tuple, schema);
-    auto res = PerformComputation(lhs, rhs);
-    if (res == std::nullopt) {
-      return ValueFactory::GetNullValueByType(TypeId::INTEGER);
-    }
-    return ValueFactory::GetIntegerValue(*res);
+    return PerformComputation(lhs, rhs);
   }
 
   auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
                     const Schema &right_schema) const -> Value override {
     Value lhs = GetChildAt(0)->EvaluateJoin(left_tuple, left_schema, right_tuple, right_schema);
     Value rhs = GetChildAt(1)->EvaluateJoin(left_tuple, left_schema, right_tuple, right_schema);
-    auto res = PerformComputation(lhs, rhs);
-    if (res == std::nullopt) {
-      return ValueFactory::GetNullValueByType(TypeId::INTEGER);
-    }
-    return ValueFactory::GetIntegerValue(*res);
+    return PerformComputation(lhs, rhs);
   }
 
   /** @return the string representation of the expression node and its children */
@@ -75,15 +70,20 @@ class ArithmeticExpression : public AbstractExpression {
   ArithmeticType compute_type_;
 
  private:
-  auto PerformComputation(const Value &lhs, const Value &rhs) const -> std::optional<int32_t> {
+  auto PerformComputation(const Value &lhs, const Value &rhs) const -> Value {
     if (lhs.IsNull() || rhs.IsNull()) {
-      return std::nullopt;
+      return ValueFactory::GetNullValueByType(GetReturnType());
+    }
+    if (GetReturnType() != TypeId::INTEGER) {
+      return compute_type_ == ArithmeticType::Plus ? lhs.Add(rhs) : lhs.Subtract(rhs);
     }
+    auto l = static_cast<uint32_t>(lhs.GetAs<int32_t>());
+    auto r = static_cast<uint32_t>(rhs.GetAs<int32_t>());
     switch (compute_type_) {
       case ArithmeticType::Plus:
-        return lhs.GetAs<int32_t>() + rhs.GetAs<int32_t>();
+        return ValueFactory::GetIntegerValue(static_cast<int32_t>(l + r));
       case ArithmeticType::Minus:
-        return lhs.GetAs<int32_t>() - rhs.GetAs<int32_t>();
+        return ValueFactory::GetIntegerValue(static_cast<int32_t>(l - r));
       default:
         UNREACHABLE("Unsupported arithmetic type.");
     }
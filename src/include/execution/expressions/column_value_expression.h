@@ -36,13 +36,14 @@ class ColumnValueExpression : public AbstractExpression {
       : AbstractExpression({}, ret_type), tuple_idx_{tuple_idx}, col_idx_{col_idx} {}
 
   auto Evaluate(const Tuple *tuple, const Schema &schema) const -> Value override {
-    return tuple->GetValue(&schema, col_idx_);
+    // The tuple outlives the evaluation, its strings are not copied.
+    return tuple->GetValueView(&schema, col_idx_);
   }
 
   auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
                     const Schema &right_schema) const -> Value override {
-    return tuple_idx_ == 0 ? left_tuple->GetValue(&left_schema, col_idx_)
-                           : right_tuple->GetValue(&right_schema, col_idx_);
+    return tuple_idx_ == 0 ? left_tuple->GetValueView(&left_schema, col_idx_)
+                           : right_tuple->GetValueView(&right_schema, col_idx_);
   }
 
   auto GetTupleIdx() const -> uint32_t { return tuple_idx_; }
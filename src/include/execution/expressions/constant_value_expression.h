@@ -27,11 +27,11 @@ class ConstantValueExpression : public AbstractExpression {
   /** Creates a new constant value expression wrapping the given value. */
   explicit ConstantValueExpression(const Value &val) : AbstractExpression({}, val.GetTypeId()), val_(val) {}
 
-  auto Evaluate(const Tuple *tuple, const Schema &schema) const -> Value override { return val_; }
+  auto Evaluate(const Tuple *tuple, const Schema &schema) const -> Value override { return val_.View(); }
 
   auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
                     const Schema &right_schema) const -> Value override {
-    return val_;
+    return val_.View();
   }
 
   /** @return the string representation of the plan node and its children */
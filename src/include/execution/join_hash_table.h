@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// join_hash_table.h
+//
+// Identification: src/include/execution/join_hash_table.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/util/hash_util.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/task_scheduler.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * PartitionedJoinHashTable is the build side of a hash join, radix-partitioned on the high bits of the key hash.
+ *
+ * The build runs in two parallel phases on a TaskScheduler. First, chunks of build tuples are hashed and their
+ * positions scattered into thread-local partition lists. Then every partition is built independently into a small
+ * chained hash table (a bucket array plus an entry array), sized so that one partition fits in cache. A probe computes
+ * the same hash and only touches the partition selected by the same bits.
+ */
+class PartitionedJoinHashTable {
+ public:
+  /**
+   * Construct a new PartitionedJoinHashTable.
+   * @param key_exprs the expressions computing the join key of a build tuple
+   * @param schema the schema of the build tuples
+   */
+  PartitionedJoinHashTable(std::vector<AbstractExpressionRef> key_exprs, const Schema *schema);
+
+  /**
+   * Build the table. Tuples with a null key component can never match and are not inserted.
+   * @param tuples the build tuples, owned by the table from now on
+   * @param scheduler the worker pool to build with, nullptr to build on the calling thread
+   */
+  void Build(std::vector<Tuple> tuples, TaskScheduler *scheduler);
+
+  /**
+   * Compute the hash of a join key.
+   * @return the hash, or std::nullopt if a key component is null, in which case the key matches nothing
+   */
+  static auto HashKey(const std::vector<Value> &key) -> std::optional<hash_t>;
+
+  /**
+   * Find the build tuples whose key equals `key`, in build order.
+   * @param key the probe key
+   * @param hash the hash of the probe key, as computed by HashKey()
+   * @param[out] matches the matching tuples, appended
+   */
+  void Probe(const std::vector<Value> &key, hash_t hash, std::vector<const Tuple *> *matches) const;
+
+  /** @return the number of partitions of the last build */
+  auto GetPartitionCount() const -> size_t { return partitions_.size(); }
+
+  /** @return the number of tuples inserted by the last build */
+  auto Size() const -> size_t { return num_entries_; }
+
+  /** Upper bound on the number of radix bits, to keep the scatter phase cache-friendly */
+  static constexpr size_t MAX_RADIX_BITS = 8;
+  /** The number of low hash bits the buckets of a partition are picked from */
+  static constexpr size_t BUCKET_HASH_BITS = 32;
+  /** Build tuples per partition we aim for, so that the entries and buckets of a partition fit in L2 */
+  static constexpr size_t TARGET_PARTITION_SIZE = 4096;
+  /** Build tuples hashed by one task of the scatter phase */
+  static constexpr size_t SCATTER_CHUNK_SIZE = 1024;
+
+ private:
+  struct Entry {
+    hash_t hash_;
+    uint32_t tuple_idx_;
+    /** Index + 1 of the next entry in the bucket chain, 0 for the end of the chain */
+    uint32_t next_;
+  };
+
+  struct Partition {
+    /** Index + 1 of the first entry of every bucket, 0 for an empty bucket */
+    std::vector<uint32_t> buckets_;
+    std::vector<Entry> entries_;
+  };
+
+  auto EvaluateKey(const Tuple &tuple) const -> std::vector<Value>;
+
+  auto PartitionOf(hash_t hash) const -> size_t {
+    return radix_bits_ == 0 ? 0 : hash >> (sizeof(hash_t) * 8 - radix_bits_);
+  }
+
+  void BuildPartition(Partition *partition, std::vector<uint32_t> tuple_idxs);
+
+  std::vector<AbstractExpressionRef> key_exprs_;
+  const Schema *schema_;
+  std::vector<Tuple> tuples_;
+  /** The join key of every build tuple, evaluated once during the build */
+  std::vector<std::vector<Value>> keys_;
+  std::vector<hash_t> hashes_;
+  size_t radix_bits_{0};
+  std::vector<Partition> partitions_;
+  size_t num_entries_{0};
+};
+
+}  // namespace bustub
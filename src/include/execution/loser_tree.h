@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// loser_tree.h
+//
+// Identification: src/include/execution/loser_tree.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * LoserTree is a tournament tree for k-way merging. Every internal node remembers the loser of the match played there
+ * and the overall winner sits at the root, so replacing the winner replays a single leaf-to-root path: log2(k)
+ * comparisons against the stored losers, versus about twice as many for a binary heap.
+ *
+ * The tree only manipulates source indices. `Less(a, b)` must tell whether the current head of source `a` should be
+ * output before the head of source `b`; exhausted sources must compare after every other source.
+ */
+template <class Less>
+class LoserTree {
+ public:
+  /**
+   * Build the tree over the current heads of the sources.
+   * @param num_sources the number of sources, at least 1
+   * @param less the comparator of source heads
+   */
+  LoserTree(size_t num_sources, Less less) : num_sources_(num_sources), less_(std::move(less)), tree_(num_sources) {
+    BUSTUB_ASSERT(num_sources > 0, "merging no sources");
+    tree_[0] = Build(1);
+  }
+
+  /** @return the source whose head comes first */
+  auto Top() const -> size_t { return tree_[0]; }
+
+  /** Restore the tree after the head of the winning source changed, i.e. after it was advanced or exhausted. */
+  void Replay() {
+    auto winner = tree_[0];
+    for (auto node = (winner + num_sources_) / 2; node > 0; node /= 2) {
+      if (less_(tree_[node], winner)) {
+        std::swap(tree_[node], winner);
+      }
+    }
+    tree_[0] = winner;
+  }
+
+ private:
+  /** Play the matches of a subtree and return its winner. Leaves are nodes [num_sources_, 2 * num_sources_). */
+  auto Build(size_t node) -> size_t {
+    if (node >= num_sources_) {
+      return node - num_sources_;
+    }
+    auto left = Build(2 * node);
+    auto right = Build(2 * node + 1);
+    if (less_(right, left)) {
+      tree_[node] = left;
+      return right;
+    }
+    tree_[node] = right;
+    return left;
+  }
+
+  size_t num_sources_;
+  Less less_;
+  /** tree_[0] is the winner, tree_[1, num_sources_) the losers of the internal nodes */
+  std::vector<size_t> tree_;
+};
+
+}  // namespace bustub
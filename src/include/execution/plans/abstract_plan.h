@@ -38,10 +38,12 @@ enum class PlanType {
   Update,
   Delete,
   Aggregation,
+  StreamingAggregation,
   Limit,
   NestedLoopJoin,
   NestedIndexJoin,
   HashJoin,
+  MergeJoin,
   Filter,
   Values,
   Projection,
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "common/util/hash_util.h"
+#include "execution/aggregate_state.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
 #include "fmt/format.h"
@@ -26,11 +27,21 @@
 namespace bustub {
 
 /** AggregationType enumerates all the possible aggregation functions in our system */
-enum class AggregationType { CountStarAggregate, CountAggregate, SumAggregate, MinAggregate, MaxAggregate };
+enum class AggregationType {
+  CountStarAggregate,
+  CountAggregate,
+  SumAggregate,
+  MinAggregate,
+  MaxAggregate,
+  AvgAggregate,
+  CountDistinctAggregate,
+  ApproxCountDistinctAggregate,
+  ApproxQuantileAggregate
+};
 
 /**
  * AggregationPlanNode represents the various SQL aggregation functions.
- * For example, COUNT(), SUM(), MIN() and MAX().
+ * For example, COUNT(), SUM(), MIN(), MAX(), AVG(), COUNT(DISTINCT), APPROX_COUNT_DISTINCT() and APPROX_QUANTILE().
  *
  * NOTE: To simplify this project, AggregationPlanNode must always have exactly one child.
  */
@@ -43,13 +54,16 @@ class AggregationPlanNode : public AbstractPlanNode {
    * @param group_bys The group by clause of the aggregation
    * @param aggregates The expressions that we are aggregating
    * @param agg_types The types that we are aggregating
+   * @param agg_args The constant arguments of the aggregates, empty if none of them takes one
    */
   AggregationPlanNode(SchemaRef output_schema, AbstractPlanNodeRef child, std::vector<AbstractExpressionRef> group_bys,
-                      std::vector<AbstractExpressionRef> aggregates, std::vector<AggregationType> agg_types)
+                      std::vector<AbstractExpressionRef> aggregates, std::vector<AggregationType> agg_types,
+                      std::vector<Value> agg_args = {})
       : AbstractPlanNode(std::move(output_schema), {std::move(child)}),
         group_bys_(std::move(group_bys)),
         aggregates_(std::move(aggregates)),
-        agg_types_(std::move(agg_types)) {}
+        agg_types_(std::move(agg_types)),
+        agg_args_(std::move(agg_args)) {}
 
   /** @return The type of the plan node */
   auto GetType() const -> PlanType override { return PlanType::Aggregation; }
@@ -75,6 +89,9 @@ class AggregationPlanNode : public AbstractPlanNode {
   /** @return The aggregate types */
   auto GetAggregateTypes() const -> const std::vector<AggregationType> & { return agg_types_; }
 
+  /** @return The constant arguments of the aggregates, empty if none of them takes one */
+  auto GetAggregateArgs() const -> const std::vector<Value> & { return agg_args_; }
+
   static auto InferAggSchema(const std::vector<AbstractExpressionRef> &group_bys,
                              const std::vector<AbstractExpressionRef> &aggregates,
                              const std::vector<AggregationType> &agg_types) -> Schema;
@@ -87,6 +104,11 @@ class AggregationPlanNode : public AbstractPlanNode {
   std::vector<AbstractExpressionRef> aggregates_;
   /** The aggregation types */
   std::vector<AggregationType> agg_types_;
+  /**
+   * The constant argument of each aggregate, e.g. the quantile of APPROX_QUANTILE, or a null value for the aggregates
+   * that take none. Empty if none of them takes one.
+   */
+  std::vector<Value> agg_args_;
 
  protected:
   auto PlanNodeToString() const -> std::string override;
@@ -116,6 +138,11 @@ struct AggregateKey {
 struct AggregateValue {
   /** The aggregate values */
   std::vector<Value> aggregates_;
+  /**
+   * The states of the aggregates that do not fit in a single Value, null for the others. Empty if no aggregate has
+   * one, or if the value is an input to aggregate.
+   */
+  std::vector<std::unique_ptr<AggregateState>> states_{};
 };
 
 }  // namespace bustub
@@ -160,6 +187,18 @@ struct fmt::formatter<bustub::AggregationType> : formatter<std::string> {
       case AggregationType::MaxAggregate:
         name = "max";
         break;
+      case AggregationType::AvgAggregate:
+        name = "avg";
+        break;
+      case AggregationType::CountDistinctAggregate:
+        name = "count_distinct";
+        break;
+      case AggregationType::ApproxCountDistinctAggregate:
+        name = "approx_count_distinct";
+        break;
+      case AggregationType::ApproxQuantileAggregate:
+        name = "approx_quantile";
+        break;
     }
     return formatter<std::string>::format(name, ctx);
   }
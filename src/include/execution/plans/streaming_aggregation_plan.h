@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// streaming_aggregation_plan.h
+//
+// Identification: src/include/execution/plans/streaming_aggregation_plan.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/plans/aggregation_plan.h"
+
+namespace bustub {
+
+/**
+ * StreamingAggregationPlanNode is an aggregation whose child produces the tuples of every group consecutively, e.g.
+ * because it is sorted on the GROUP BY columns. It is planned by the optimizer in place of an AggregationPlanNode, and
+ * carries the same group-by and aggregate expressions.
+ */
+class StreamingAggregationPlanNode : public AggregationPlanNode {
+ public:
+  /**
+   * Construct a new StreamingAggregationPlanNode.
+   * @param output_schema The output format of this plan node
+   * @param child The child plan to aggregate data over, producing the tuples of a group consecutively
+   * @param group_bys The group by clause of the aggregation
+   * @param aggregates The expressions that we are aggregating
+   * @param agg_types The types that we are aggregating
+   * @param agg_args The constant arguments of the aggregates, empty if none of them takes one
+   */
+  StreamingAggregationPlanNode(SchemaRef output_schema, AbstractPlanNodeRef child,
+                               std::vector<AbstractExpressionRef> group_bys,
+                               std::vector<AbstractExpressionRef> aggregates, std::vector<AggregationType> agg_types,
+                               std::vector<Value> agg_args = {})
+      : AggregationPlanNode(std::move(output_schema), std::move(child), std::move(group_bys), std::move(aggregates),
+                            std::move(agg_types), std::move(agg_args)) {}
+
+  /** @return The type of the plan node */
+  auto GetType() const -> PlanType override { return PlanType::StreamingAggregation; }
+
+  BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(StreamingAggregationPlanNode);
+
+ protected:
+  auto PlanNodeToString() const -> std::string override;
+};
+
+}  // namespace bustub
@@ -0,0 +1,106 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// runtime_filter.h
+//
+// Identification: src/include/execution/runtime_filter.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/util/hash_util.h"
+#include "execution/expressions/abstract_expression.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * A RuntimeFilter is a predicate that an operator builds while it runs and hands down to its child executors through
+ * AbstractExecutor::PushDownRuntimeFilter(), so that tuples the operator is going to discard anyway are dropped as
+ * early as possible. A runtime filter may let through tuples that the operator discards later, but it must never drop
+ * a tuple that the operator would keep.
+ *
+ * The operator may keep tightening the filter while the child runs: Check() can be called concurrently with updates.
+ */
+class RuntimeFilter {
+ public:
+  virtual ~RuntimeFilter() = default;
+
+  /**
+   * @param tuple a tuple produced by the executor the filter was pushed into
+   * @param schema the schema of the tuple
+   * @return `false` if the tuple can be dropped
+   */
+  virtual auto Check(const Tuple &tuple, const Schema &schema) const -> bool = 0;
+
+  /**
+   * @param num_columns a number of leading columns of the tuples the filter was built for
+   * @return `true` if Check() only reads those columns, so that it can be checked on any tuple that starts with them,
+   * e.g. on the left input of a join instead of its output
+   */
+  virtual auto ReadsOnlyLeadingColumns(uint32_t num_columns) const -> bool { return false; }
+};
+
+using RuntimeFilterRef = std::shared_ptr<const RuntimeFilter>;
+
+/** @return `true` if the tuple passes all the filters */
+inline auto CheckRuntimeFilters(const std::vector<RuntimeFilterRef> &filters, const Tuple &tuple,
+                                const Schema &schema) -> bool {
+  for (const auto &filter : filters) {
+    if (!filter->Check(tuple, schema)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** @return `true` if the expression only reads columns among the first `num_columns` of its input tuple */
+auto ExpressionReadsOnlyLeadingColumns(const AbstractExpressionRef &expr, uint32_t num_columns) -> bool;
+
+/**
+ * BlockedBloomFilter is a Bloom filter on 64-bit hashes whose bits are grouped into 32-byte blocks: every hash sets
+ * one bit in each of the eight 32-bit words of a single block, so that an insert or a lookup touches one cache line.
+ * The filter has no false negatives, and about BITS_PER_KEY bits per key keep its false positive rate well under 1%.
+ */
+class BlockedBloomFilter {
+ public:
+  /** @param num_keys the number of keys the filter is sized for */
+  explicit BlockedBloomFilter(size_t num_keys);
+
+  void Insert(hash_t hash);
+
+  /** @return `false` if no key with this hash was inserted, `true` if one probably was */
+  auto MayContain(hash_t hash) const -> bool;
+
+  /** @return the size of the filter in bytes */
+  auto GetSize() const -> size_t { return blocks_.size() * sizeof(Block); }
+
+  static constexpr size_t BITS_PER_KEY = 16;
+
+ private:
+  static constexpr size_t WORDS_PER_BLOCK = 8;
+
+  struct alignas(32) Block {
+    uint32_t words_[WORDS_PER_BLOCK];
+  };
+
+  /** @return the index of the block of a hash, picked from its high 32 bits */
+  auto BlockIndexOf(hash_t hash) const -> size_t { return ((hash >> 32) * blocks_.size()) >> 32; }
+
+  /** @return the bit a hash sets in a word of its block, picked from its low 32 bits */
+  static auto MaskOf(hash_t hash, size_t word) -> uint32_t;
+
+  std::vector<Block> blocks_;
+};
+
+}  // namespace bustub
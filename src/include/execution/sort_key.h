@@ -0,0 +1,143 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key.h
+//
+// Identification: src/include/execution/sort_key.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "catalog/schema.h"
+#include "execution/expressions/abstract_expression.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+using OrderBys = std::vector<std::pair<OrderByType, AbstractExpressionRef>>;
+
+/** A tuple along with the values of its ORDER BY keys, so that sorting does not evaluate the keys again */
+struct SortEntry {
+  std::vector<Value> key_;
+  Tuple tuple_;
+};
+
+/** @return the values of the ORDER BY keys of a tuple */
+inline auto EvaluateSortKey(const OrderBys &order_bys, const Tuple &tuple, const Schema &schema) -> std::vector<Value> {
+  std::vector<Value> key;
+  key.reserve(order_bys.size());
+  for (const auto &[order_by_type, expr] : order_bys) {
+    key.emplace_back(expr->Evaluate(&tuple, schema));
+  }
+  return key;
+}
+
+/**
+ * SortKeyComparator orders ORDER BY keys. Nulls sort before any other value, so they come first in ascending order and
+ * last in descending order.
+ */
+class SortKeyComparator {
+ public:
+  explicit SortKeyComparator(const OrderBys &order_bys) {
+    descending_.reserve(order_bys.size());
+    for (const auto &[order_by_type, expr] : order_bys) {
+      descending_.push_back(order_by_type == OrderByType::DESC);
+    }
+  }
+
+  /** @return a negative number, zero, or a positive number if `lhs` sorts before, with, or after `rhs` */
+  auto Compare(const std::vector<Value> &lhs, const std::vector<Value> &rhs) const -> int {
+    for (size_t i = 0; i < descending_.size(); i++) {
+      int cmp = CompareValues(lhs[i], rhs[i]);
+      if (cmp != 0) {
+        return descending_[i] ? -cmp : cmp;
+      }
+    }
+    return 0;
+  }
+
+  auto operator()(const std::vector<Value> &lhs, const std::vector<Value> &rhs) const -> bool {
+    return Compare(lhs, rhs) < 0;
+  }
+
+  auto operator()(const SortEntry &lhs, const SortEntry &rhs) const -> bool { return Compare(lhs.key_, rhs.key_) < 0; }
+
+ private:
+  static auto CompareValues(const Value &lhs, const Value &rhs) -> int {
+    if (lhs.IsNull() || rhs.IsNull()) {
+      return static_cast<int>(!lhs.IsNull()) - static_cast<int>(!rhs.IsNull());
+    }
+    if (lhs.CompareLessThan(rhs) == CmpBool::CmpTrue) {
+      return -1;
+    }
+    if (lhs.CompareGreaterThan(rhs) == CmpBool::CmpTrue) {
+      return 1;
+    }
+    return 0;
+  }
+
+  std::vector<bool> descending_;
+};
+
+/** Size in bytes of a normalized sort key */
+static constexpr size_t NORMALIZED_SORT_KEY_SIZE = 32;
+
+/**
+ * NormalizedSortKey is a fixed-size byte string encoding (a prefix of) the ORDER BY key of a tuple, such that comparing
+ * two normalized keys with memcmp orders them like SortKeyComparator orders the keys they were made from.
+ */
+struct NormalizedSortKey {
+  std::array<uint8_t, NORMALIZED_SORT_KEY_SIZE> bytes_;
+
+  /** @return a negative number, zero, or a positive number if `this` sorts before, with, or after `other` */
+  auto Compare(const NormalizedSortKey &other) const -> int {
+    return memcmp(bytes_.data(), other.bytes_.data(), NORMALIZED_SORT_KEY_SIZE);
+  }
+};
+
+/**
+ * SortKeyNormalizer encodes ORDER BY keys into NormalizedSortKeys. Every key column is encoded as a null marker followed
+ * by the value in big-endian, order-preserving form, with all the bytes inverted for descending columns:
+ *
+ *   BOOLEAN -> 1 byte | TINYINT, SMALLINT, INTEGER, BIGINT -> 8 bytes, sign bit flipped | TIMESTAMP -> 8 bytes
+ *   DECIMAL -> 8 bytes, sign bit flipped for positive numbers and every bit flipped for negative ones
+ *   VARCHAR -> the leading bytes of the string, zero-padded to the end of the normalized key
+ *
+ * A VARCHAR column takes the rest of the normalized key, and columns that do not fit are left out. In both cases the
+ * normalized key is only a prefix: keys that differ after normalization are ordered correctly, but equal normalized
+ * keys must be compared with SortKeyComparator to break the tie.
+ */
+class SortKeyNormalizer {
+ public:
+  explicit SortKeyNormalizer(const OrderBys &order_bys);
+
+  /** @return `true` if normalized keys encode the whole key, so that equal normalized keys mean equal keys */
+  auto IsExact() const -> bool { return is_exact_; }
+
+  /** Encode a key, as evaluated by EvaluateSortKey(). */
+  void Normalize(const std::vector<Value> &key, NormalizedSortKey *normalized_key) const;
+
+ private:
+  struct KeyColumn {
+    TypeId type_;
+    bool descending_;
+  };
+
+  /** The key columns that are encoded */
+  std::vector<KeyColumn> columns_;
+  bool is_exact_{true};
+};
+
+}  // namespace bustub
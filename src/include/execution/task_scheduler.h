@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// task_scheduler.h
+//
+// Identification: src/include/execution/task_scheduler.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * TaskScheduler is a pool of worker threads that runs morsel-sized tasks for parallel query execution.
+ *
+ * Every worker owns a task deque. A worker pops its own tasks from the back (LIFO, cache-friendly) and, when it runs
+ * dry, steals from the front of another worker's deque (FIFO, the largest remaining work). The thread submitting a
+ * parallel loop does not sit idle: it runs the tasks of its own loop until the loop completes, so nested parallel loops
+ * issued from worker threads cannot deadlock. It never picks up a task of another loop while it waits, so a thread
+ * runs at most one task of a loop at a time, and the slot a task gets is its own until it returns. Once every task of
+ * its loop has been picked up, it sleeps until the last one finishes.
+ *
+ * All the threads outside of the pool share a single slot, so their parallel loops run one at a time.
+ */
+class TaskScheduler {
+ public:
+  /**
+   * Start the worker threads.
+   * @param num_workers the number of worker threads, 0 to run every task on the calling thread
+   */
+  explicit TaskScheduler(size_t num_workers = std::thread::hardware_concurrency());
+
+  /** Stop and join the worker threads. Pending tasks are dropped. */
+  ~TaskScheduler();
+
+  DISALLOW_COPY_AND_MOVE(TaskScheduler);
+
+  /** @return the number of worker threads */
+  auto GetWorkerCount() const -> size_t { return workers_.size(); }
+
+  /**
+   * @return the number of distinct slot ids passed to ParallelFor tasks, i.e. how many thread-local states a parallel
+   * operator needs: one per worker, plus one for the thread calling ParallelFor.
+   */
+  auto GetSlotCount() const -> size_t { return workers_.size() + 1; }
+
+  /**
+   * Run `task(task_idx, slot)` for every `task_idx` in [0, num_tasks) across the workers, and block until all of them
+   * have finished. `slot` is in [0, GetSlotCount()) and identifies the executing thread, so that tasks can update
+   * thread-local state without synchronization. If a task throws, the first exception is rethrown here once all the
+   * tasks are done. A thread outside of the pool waits for the loops of other such threads to finish first.
+   */
+  void ParallelFor(size_t num_tasks, const std::function<void(size_t task_idx, size_t slot)> &task);
+
+ private:
+  /** Book-keeping shared by the tasks of one ParallelFor call */
+  struct TaskGroup {
+    const std::function<void(size_t, size_t)> *fn_;
+    /** The number of unfinished tasks, only decremented under `latch_` */
+    std::atomic<size_t> pending_;
+    /** Protects `exception_`, and signals `done_cv_` when `pending_` reaches zero */
+    std::mutex latch_;
+    std::condition_variable done_cv_;
+    std::exception_ptr exception_;
+  };
+
+  struct Task {
+    TaskGroup *group_;
+    size_t task_idx_;
+  };
+
+  struct WorkerQueue {
+    std::mutex latch_;
+    std::deque<Task> tasks_;
+  };
+
+  void WorkerLoop(size_t worker_idx);
+
+  /**
+   * Pop a task from the worker's own deque, newest first, or steal one from another worker, oldest first.
+   * @param worker_idx the worker looking for a task, GetWorkerCount() for a thread outside of the pool
+   * @param group if not null, only take tasks of this group
+   */
+  auto FindTask(size_t worker_idx, const TaskGroup *group, Task *task) -> bool;
+
+  void RunTask(const Task &task, size_t slot);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  /** Held by a thread outside of the pool for the duration of its ParallelFor, as it owns the external slot */
+  std::mutex external_latch_;
+
+  /** Signals idle workers that tasks were queued */
+  std::mutex sleep_latch_;
+  std::condition_variable sleep_cv_;
+  std::atomic<size_t> num_queued_{0};
+  bool shutdown_{false};
+};
+
+}  // namespace bustub
@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_batch.h
+//
+// Identification: src/include/execution/tuple_batch.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * TupleBatch is the unit of exchange of the batch-at-a-time executor interface (`AbstractExecutor::NextBatch`).
+ * It holds up to `Capacity()` tuples together with their RIDs. Slots are reused across calls, so a tuple written
+ * into a slot can recycle the buffer of the tuple that previously occupied it.
+ */
+class TupleBatch {
+ public:
+  /**
+   * Construct a new, empty TupleBatch.
+   * @param capacity the maximum number of tuples held by the batch
+   */
+  explicit TupleBatch(size_t capacity = BUSTUB_BATCH_SIZE) : capacity_(capacity) {
+    BUSTUB_ASSERT(capacity_ > 0, "batch capacity must be positive");
+    tuples_.reserve(capacity_);
+    rids_.reserve(capacity_);
+  }
+
+  /** @return the maximum number of tuples the batch can hold */
+  auto Capacity() const -> size_t { return capacity_; }
+
+  /** @return the number of tuples in the batch */
+  auto Size() const -> size_t { return size_; }
+
+  /** @return `true` if the batch holds no tuple */
+  auto IsEmpty() const -> bool { return size_ == 0; }
+
+  /** @return `true` if no more tuple can be appended */
+  auto IsFull() const -> bool { return size_ == capacity_; }
+
+  /** Remove all tuples from the batch. The slots are kept for reuse. */
+  void Clear() { size_ = 0; }
+
+  /** Append a tuple to the batch. The batch must not be full. */
+  void Append(Tuple &&tuple, RID rid) {
+    BUSTUB_ASSERT(!IsFull(), "append to a full batch");
+    if (size_ < tuples_.size()) {
+      tuples_[size_] = std::move(tuple);
+      rids_[size_] = rid;
+    } else {
+      tuples_.emplace_back(std::move(tuple));
+      rids_.emplace_back(rid);
+    }
+    size_++;
+  }
+
+  /**
+   * Append an empty slot to the batch and return it, so that the caller can write a tuple in place.
+   * @return the tuple and RID of the new slot
+   */
+  auto AppendSlot() -> std::pair<Tuple *, RID *> {
+    BUSTUB_ASSERT(!IsFull(), "append to a full batch");
+    if (size_ == tuples_.size()) {
+      tuples_.emplace_back();
+      rids_.emplace_back();
+    }
+    size_++;
+    return {&tuples_[size_ - 1], &rids_[size_ - 1]};
+  }
+
+  /** @return the idx-th tuple of the batch */
+  auto GetTuple(size_t idx) -> Tuple & { return tuples_[idx]; }
+  auto GetTuple(size_t idx) const -> const Tuple & { return tuples_[idx]; }
+
+  /** @return the RID of the idx-th tuple of the batch */
+  auto GetRID(size_t idx) const -> RID { return rids_[idx]; }
+
+  /**
+   * Keep the idx-th tuple, moving it to position `pos` (`pos <= idx`). Used to compact a batch in place while
+   * preserving the order of the surviving tuples.
+   */
+  void MoveTo(size_t idx, size_t pos) {
+    BUSTUB_ASSERT(pos <= idx && idx < size_, "invalid batch compaction");
+    if (pos != idx) {
+      std::swap(tuples_[pos], tuples_[idx]);
+      rids_[pos] = rids_[idx];
+    }
+  }
+
+  /** Shrink the batch to its first `size` tuples. */
+  void Truncate(size_t size) {
+    BUSTUB_ASSERT(size <= size_, "truncate cannot grow a batch");
+    size_ = size;
+  }
+
+ private:
+  /** The tuple slots; only the first `size_` of them are valid */
+  std::vector<Tuple> tuples_;
+  /** The RIDs of the tuple slots */
+  std::vector<RID> rids_;
+  /** The number of valid tuples */
+  size_t size_{0};
+  /** The maximum number of tuples */
+  size_t capacity_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,157 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// vector_kernels.h
+//
+// Identification: src/include/execution/vector_kernels.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace bustub {
+
+/**
+ * Kernels over arrays of fixed-size values, one value per row of a batch. Comparisons produce a bitmap with one bit
+ * per row, 64 rows to a word, that filters combine with word-wise AND/OR and turn into a selection vector.
+ *
+ * Every kernel is a branch-free loop over plain arrays that compilers turn into SIMD instructions: build with
+ * -DBUSTUB_ENABLE_AVX2=ON to let them use AVX2, the kernels stay correct scalar loops otherwise. An operand marked as
+ * scalar holds a single value compared with, or added to, every row, as constants are.
+ */
+
+/** Rows covered by one word of a bitmap */
+static constexpr size_t BITMAP_WORD_BITS = 64;
+
+/** @return the number of words of a bitmap over num_rows rows */
+constexpr auto BitmapWordCount(size_t num_rows) -> size_t {
+  return (num_rows + BITMAP_WORD_BITS - 1) / BITMAP_WORD_BITS;
+}
+
+/** @return the mask of the bits of the last word of a bitmap over num_rows rows that cover a row */
+constexpr auto BitmapLastWordMask(size_t num_rows) -> uint64_t {
+  auto tail = num_rows % BITMAP_WORD_BITS;
+  return tail == 0 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << tail) - 1;
+}
+
+/**
+ * Set bit i of a bitmap to pred(i) for every row i < num_rows. The bits of the last word past num_rows are cleared.
+ * The predicate is evaluated on a whole word of rows at a time, without a branch.
+ */
+template <class Pred>
+void FillBitmap(size_t num_rows, uint64_t *out, Pred &&pred) {
+  size_t num_full_words = num_rows / BITMAP_WORD_BITS;
+  for (size_t word = 0; word < num_full_words; word++) {
+    const size_t base = word * BITMAP_WORD_BITS;
+    uint64_t bits = 0;
+    for (size_t j = 0; j < BITMAP_WORD_BITS; j++) {
+      bits |= static_cast<uint64_t>(pred(base + j)) << j;
+    }
+    out[word] = bits;
+  }
+  if (num_full_words * BITMAP_WORD_BITS < num_rows) {
+    const size_t base = num_full_words * BITMAP_WORD_BITS;
+    uint64_t bits = 0;
+    for (size_t j = 0; base + j < num_rows; j++) {
+      bits |= static_cast<uint64_t>(pred(base + j)) << j;
+    }
+    out[num_full_words] = bits;
+  }
+}
+
+/**
+ * Compare two operands row by row: bit i of `out` is set if op(lhs[i], rhs[i]).
+ * @tparam LHS_SCALAR whether lhs holds a single value for every row
+ * @tparam RHS_SCALAR whether rhs holds a single value for every row
+ */
+template <class T, class Op, bool LHS_SCALAR, bool RHS_SCALAR>
+void CompareKernel(const T *__restrict lhs, const T *__restrict rhs, size_t num_rows, uint64_t *__restrict out) {
+  static_assert(std::is_arithmetic_v<T>);
+  Op op;
+  const T lhs_value = lhs[0];
+  const T rhs_value = rhs[0];
+  FillBitmap(num_rows, out, [&](size_t i) {
+    return op(LHS_SCALAR ? lhs_value : lhs[i], RHS_SCALAR ? rhs_value : rhs[i]);
+  });
+}
+
+/** Addition of two values, wrapping around for integers */
+struct PlusOp {
+  template <class T>
+  static auto Apply(T lhs, T rhs) -> T {
+    if constexpr (std::is_integral_v<T>) {
+      using U = std::make_unsigned_t<T>;
+      return static_cast<T>(static_cast<U>(lhs) + static_cast<U>(rhs));
+    } else {
+      return lhs + rhs;
+    }
+  }
+
+  /** @return whether the integer result of Apply(lhs, rhs) wrapped around */
+  template <class T>
+  static auto Overflows(T lhs, T rhs, T result) -> bool {
+    // The sum overflows if both operands have the same sign and the result has the other one.
+    return ((lhs ^ result) & (rhs ^ result)) < 0;
+  }
+};
+
+/** Subtraction of two values, wrapping around for integers */
+struct MinusOp {
+  template <class T>
+  static auto Apply(T lhs, T rhs) -> T {
+    if constexpr (std::is_integral_v<T>) {
+      using U = std::make_unsigned_t<T>;
+      return static_cast<T>(static_cast<U>(lhs) - static_cast<U>(rhs));
+    } else {
+      return lhs - rhs;
+    }
+  }
+
+  /** @return whether the integer result of Apply(lhs, rhs) wrapped around */
+  template <class T>
+  static auto Overflows(T lhs, T rhs, T result) -> bool {
+    // The difference overflows if the operands have different signs and the result has the sign of rhs.
+    return ((lhs ^ rhs) & (lhs ^ result)) < 0;
+  }
+};
+
+/**
+ * Compute op(lhs[i], rhs[i]) into out[i] for every row.
+ * @tparam Op PlusOp or MinusOp
+ */
+template <class T, class Op, bool LHS_SCALAR, bool RHS_SCALAR>
+void ArithmeticKernel(const T *__restrict lhs, const T *__restrict rhs, size_t num_rows, T *__restrict out) {
+  static_assert(std::is_arithmetic_v<T>);
+  const T lhs_value = lhs[0];
+  const T rhs_value = rhs[0];
+  for (size_t i = 0; i < num_rows; i++) {
+    out[i] = Op::Apply(LHS_SCALAR ? lhs_value : lhs[i], RHS_SCALAR ? rhs_value : rhs[i]);
+  }
+}
+
+/** Set bit i of `out` if result[i], computed by ArithmeticKernel() on integers, overflowed. */
+template <class T, class Op, bool LHS_SCALAR, bool RHS_SCALAR>
+void OverflowKernel(const T *__restrict lhs, const T *__restrict rhs, const T *__restrict result, size_t num_rows,
+                    uint64_t *__restrict out) {
+  static_assert(std::is_integral_v<T>);
+  const T lhs_value = lhs[0];
+  const T rhs_value = rhs[0];
+  FillBitmap(num_rows, out, [&](size_t i) {
+    return Op::Overflows(LHS_SCALAR ? lhs_value : lhs[i], RHS_SCALAR ? rhs_value : rhs[i], result[i]);
+  });
+}
+
+/** Set bit i of `out` if values[i] equals `value`, e.g. to find the null values of a column. */
+template <class T>
+void EqualsBitmap(const T *__restrict values, T value, size_t num_rows, uint64_t *__restrict out) {
+  FillBitmap(num_rows, out, [&](size_t i) { return values[i] == value; });
+}
+
+}  // namespace bustub
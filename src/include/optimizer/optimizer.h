@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "catalog/catalog.h"
+#include "common/config.h"
 #include "concurrency/transaction.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
@@ -19,8 +20,9 @@ namespace bustub {
  */
 class Optimizer {
  public:
-  explicit Optimizer(const Catalog &catalog, bool force_starter_rule)
-      : catalog_(catalog), force_starter_rule_(force_starter_rule) {}
+  explicit Optimizer(const Catalog &catalog, bool force_starter_rule,
+                     size_t memory_budget = DEFAULT_QUERY_MEMORY_BUDGET)
+      : catalog_(catalog), force_starter_rule_(force_starter_rule), memory_budget_(memory_budget) {}
 
   auto Optimize(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
@@ -41,6 +43,16 @@ class Optimizer {
    */
   auto OptimizeMergeFilterNLJ(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief push the terms of an inner join predicate that read only one side of the join into that side, as a filter or
+   * into the predicate of a child join. Cross joins planned with a filter on top then join on their own equi-join terms
+   * only, and can become hash joins, instead of computing the cross product.
+   */
+  auto OptimizePushDownJoinPredicate(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /** @brief AND a predicate on the output of a plan into the plan, as a filter or into the predicate of a join. */
+  auto AddPredicate(const AbstractPlanNodeRef &plan, const AbstractExpressionRef &predicate) -> AbstractPlanNodeRef;
+
   /**
    * @brief optimize nested loop join into hash join.
    * In the starter code, we will check NLJs with exactly one equal condition. You can further support optimizing joins
@@ -92,6 +104,25 @@ class Optimizer {
    */
   auto OptimizeSortLimitAsTopN(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief get the columns that the output of a plan is sorted on in ascending order, from the most significant one.
+   * Sort and TopN are sorted on their leading ascending ORDER BY columns and an index scan on the index key, while
+   * filters, limits and column projections keep the order of their child, and a merge join the order of its left child.
+   */
+  auto GetOutputOrdering(const AbstractPlanNodeRef &plan) -> std::vector<uint32_t>;
+
+  /**
+   * @brief optimize aggregation as streaming aggregation when its child is sorted on the group by columns
+   */
+  auto OptimizeAggregationAsStreaming(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief optimize hash join as merge join when it needs no hash table. That is the case when both children are
+   * already sorted on the join keys, e.g. by index scans, or can be sorted by an index scan. Otherwise, the children
+   * are sorted instead of hashed if the estimated spill traffic of the sorts is below that of a hybrid hash join.
+   */
+  auto OptimizeHashJoinAsMergeJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
   /**
    * @brief get the estimated cardinality for a table based on the table name. Useful when join reordering. BusTub
    * doesn't support statistics for now, so it's the only way for you to get the table size :(
@@ -101,12 +132,22 @@ class Optimizer {
    */
   auto EstimatedCardinality(const std::string &table_name) -> std::optional<size_t>;
 
+  /**
+   * @brief get an upper bound of the number of tuples a plan outputs, from the estimated cardinality of the tables it
+   * scans, or the size of the mock tables. Only scans and the plans that output at most as many tuples as their child
+   * are estimated.
+   */
+  auto EstimatedOutputCardinality(const AbstractPlanNodeRef &plan) -> std::optional<size_t>;
+
   /** Catalog will be used during the planning process. USERS SHOULD ENSURE IT OUTLIVES
    * OPTIMIZER, otherwise it's a dangling reference.
    */
   const Catalog &catalog_;
 
   const bool force_starter_rule_;
+
+  /** The memory budget of memory-intensive executors, which the plan should stay within */
+  const size_t memory_budget_;
 };
 
 }  // namespace bustub
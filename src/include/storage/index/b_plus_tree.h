@@ -81,6 +81,16 @@ class BPlusTree {
   // Return the value associated with a given key
   auto GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *txn = nullptr) -> bool;
 
+  /**
+   * Look up a batch of keys in one sweep through the tree. The path from the root to the current leaf is kept, and
+   * the next key only climbs back to the lowest page whose subtree contains it, so that a dense batch walks the leaves
+   * left to right instead of descending from the root once per key.
+   * @param keys The keys to look up, sorted in ascending order
+   * @param[out] results The values found for each key, in the order of the keys
+   */
+  void GetValues(const std::vector<KeyType> &keys, std::vector<std::vector<ValueType>> *results,
+                 Transaction *txn = nullptr);
+
   // Return the page id of the root node
   auto GetRootPageId() -> page_id_t;
 
@@ -117,6 +127,15 @@ class BPlusTree {
   void RemoveFromFile(const std::string &file_name, Transaction *txn = nullptr);
 
  private:
+  /** @return the slot of the child of an internal page whose subtree holds the key */
+  auto ChildIndex(const InternalPage *page, const KeyType &key) const -> int;
+
+  /** @return the first slot of a leaf page whose key is not less than the key */
+  auto LeafLowerBound(const LeafPage *page, const KeyType &key) const -> int;
+
+  /** Insert the separator of a split page and its new right sibling into the parent, splitting it if it overflows. */
+  void InsertIntoParent(Context *ctx, page_id_t left_page_id, const KeyType &key, page_id_t right_page_id);
+
   /* Debug Routines for FREE!! */
   void ToGraph(page_id_t page_id, const BPlusTreePage *page, std::ofstream &out);
 
@@ -63,6 +63,7 @@ class BPlusTreeInternalPage : public BPlusTreePage {
   /**
    *
    * @param value the value to search for
+   * @return the index of the value, or -1 if the page does not hold it
    */
   auto ValueIndex(const ValueType &value) const -> int;
 
@@ -73,6 +74,12 @@ class BPlusTreeInternalPage : public BPlusTreePage {
    */
   auto ValueAt(int index) const -> ValueType;
 
+  /**
+   * @param index the index
+   * @param value the new value at the index
+   */
+  void SetValueAt(int index, const ValueType &value);
+
   /**
    * @brief For test only, return a string representing all keys in
    * this internal page, formatted as "(key1,key2,key3,...)"
@@ -0,0 +1,97 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map_page.h
+//
+// Identification: src/include/storage/page/free_space_map_page.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "common/config.h"
+
+namespace bustub {
+
+static constexpr uint64_t FREE_SPACE_MAP_PAGE_HEADER_SIZE = 8;
+
+/**
+ * A page of the free space map of a table heap. It has one entry per table page: the page id, and a fill level of
+ * one byte that says how large a tuple the page can take, in units of FREE_SPACE_UNIT bytes, rounded down.
+ *
+ *  Format (size in bytes):
+ *  ------------------------------------------------------------------------------------------------------
+ *  | NextPageId (4) | NumEntries (4) | PageId_1 (4) | ... | PageId_MAX (4) | Level_1 (1) | ... | Level_MAX (1) |
+ *  ------------------------------------------------------------------------------------------------------
+ *
+ * The levels are stored apart from the page ids, so that looking for a page with room scans a plain byte array.
+ */
+class FreeSpaceMapPage {
+ public:
+  // Delete all constructor / destructor to ensure memory safety
+  FreeSpaceMapPage() = delete;
+  FreeSpaceMapPage(const FreeSpaceMapPage &other) = delete;
+
+  /** Bytes of free space per fill level */
+  static constexpr size_t FREE_SPACE_UNIT = BUSTUB_PAGE_SIZE / 256;
+  /** Entries of a page */
+  static constexpr uint32_t MAX_ENTRIES =
+      (BUSTUB_PAGE_SIZE - FREE_SPACE_MAP_PAGE_HEADER_SIZE) / (sizeof(page_id_t) + sizeof(uint8_t));
+
+  /** Initialize an empty page of the map. */
+  void Init();
+
+  /** @return the page id of the next page of the map */
+  auto GetNextPageId() const -> page_id_t { return next_page_id_; }
+
+  /** Set the page id of the next page of the map. */
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  /** @return the number of table pages in this page of the map */
+  auto GetNumEntries() const -> uint32_t { return num_entries_; }
+
+  /** @return whether the page has no room for another entry */
+  auto IsFull() const -> bool { return num_entries_ == MAX_ENTRIES; }
+
+  /**
+   * Add a table page to the map. The page must not be full.
+   * @return the index of its entry
+   */
+  auto AddEntry(page_id_t page_id, size_t free_space) -> uint32_t;
+
+  /** @return the table page of an entry */
+  auto GetPageId(uint32_t idx) const -> page_id_t { return page_ids_[idx]; }
+
+  /** @return the free space of the table page of an entry, rounded down to a multiple of FREE_SPACE_UNIT */
+  auto GetFreeSpace(uint32_t idx) const -> size_t { return levels_[idx] * FREE_SPACE_UNIT; }
+
+  /** Set the free space of the table page of an entry. */
+  void SetFreeSpace(uint32_t idx, size_t free_space) { levels_[idx] = ToLevel(free_space); }
+
+  /**
+   * Find a table page with room for `size` bytes, looking from entry `start` modulo the number of entries and wrapping
+   * around, so that callers starting at different entries tend to pick different pages.
+   * @return the index of the entry, or nullopt if no page has enough room
+   */
+  auto FindEntry(size_t size, size_t start) const -> std::optional<uint32_t>;
+
+ private:
+  static auto ToLevel(size_t free_space) -> uint8_t {
+    return free_space / FREE_SPACE_UNIT > UINT8_MAX ? UINT8_MAX : free_space / FREE_SPACE_UNIT;
+  }
+
+  page_id_t next_page_id_;
+  uint32_t num_entries_;
+  page_id_t page_ids_[MAX_ENTRIES];
+  uint8_t levels_[MAX_ENTRIES];
+};
+
+static_assert(sizeof(FreeSpaceMapPage) <= BUSTUB_PAGE_SIZE);
+
+}  // namespace bustub
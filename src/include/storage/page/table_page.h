@@ -27,7 +27,7 @@
 
 namespace bustub {
 
-static constexpr uint64_t TABLE_PAGE_HEADER_SIZE = 8;
+static constexpr uint64_t TABLE_PAGE_HEADER_SIZE = 12;
 
 /**
  * Slotted page format:
@@ -35,20 +35,24 @@ static constexpr uint64_t TABLE_PAGE_HEADER_SIZE = 8;
  *  | HEADER | ... FREE SPACE ... | ... INSERTED TUPLES ... |
  *  ---------------------------------------------------------
  *                                ^
- *                                free space pointer
+ *                                tuple start
  *
  *  Header format (size in bytes):
- *  ----------------------------------------------------------------------------
- *  | NextPageId (4)| NumTuples(2) | NumDeletedTuples(2) |
- *  ----------------------------------------------------------------------------
+ *  ----------------------------------------------------------------------------------------------
+ *  | NextPageId (4)| NumTuples(2) | NumDeletedTuples(2) | TupleStart(2) | NumFreeSlots(2) |
+ *  ----------------------------------------------------------------------------------------------
  *  ----------------------------------------------------------------
- *  | Tuple_1 offset+size (4) | Tuple_2 offset+size (4) | ... |
+ *  | Tuple_1 offset+size+meta (16) | Tuple_2 offset+size+meta (16) | ... |
  *  ----------------------------------------------------------------
  *
  * Tuple format:
  * | meta | data |
+ *
+ * The space of a tuple whose deletion is complete (deleted, with no delete txn) is reclaimed when an insert does not
+ * fit otherwise: its slot is freed, and the remaining tuples are compacted towards the end of the page. Their slots,
+ * and so their RIDs, do not change. A freed slot has offset 0 and a deleted meta, and is reused by a later insert.
+ * NumTuples counts the slots, freed ones included.
  */
-
 class TablePage {
  public:
   /**
@@ -65,16 +69,40 @@ class TablePage {
   /** Set the page id of the next page in the table. */
   void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
 
-  /** Get the next offset to insert, return nullopt if this tuple cannot fit in this page */
+  /**
+   * Get the next offset to insert, without reclaiming the space of deleted tuples.
+   * @return nullopt if this tuple cannot fit in the free space of this page
+   */
   auto GetNextTupleOffset(const TupleMeta &meta, const Tuple &tuple) const -> std::optional<uint16_t>;
 
   /**
-   * Insert a tuple into the table.
+   * Insert a tuple into the table, in a freed slot if there is one. If the tuple does not fit in the free space, the
+   * space of the tuples whose deletion is complete is reclaimed first.
    * @param tuple tuple to insert
-   * @return true if the insert is successful (i.e. there is enough space)
+   * @return the slot of the tuple, or nullopt if there is not enough space
    */
   auto InsertTuple(const TupleMeta &meta, const Tuple &tuple) -> std::optional<uint16_t>;
 
+  /**
+   * Free the slots of the tuples whose deletion is complete and compact the other tuples at the end of the page,
+   * preserving their slots.
+   * @return the number of bytes reclaimed
+   */
+  auto Compact() -> size_t;
+
+  /** @return the free space of this page, in bytes, without reclaiming the space of deleted tuples */
+  auto GetFreeSpace() const -> size_t {
+    return tuple_start_ - TABLE_PAGE_HEADER_SIZE - TUPLE_INFO_SIZE * num_tuples_;
+  }
+
+  /** @return the length of the largest tuple an insert can store, reclaiming the space of deleted tuples if needed */
+  auto GetInsertableSpace() const -> size_t;
+
+  /** @return whether the space of a tuple can be reclaimed, its deletion being complete */
+  static auto IsReclaimable(const TupleMeta &meta) -> bool {
+    return meta.is_deleted_ && meta.delete_txn_id_ == INVALID_TXN_ID;
+  }
+
   /**
    * Update a tuple.
    */
@@ -85,6 +113,13 @@ class TablePage {
    */
   auto GetTuple(const RID &rid) const -> std::pair<TupleMeta, Tuple>;
 
+  /**
+   * Read a tuple in place, without copying it out of the page. The reference is only valid while the page stays
+   * pinned and latched.
+   * @return the meta and a reference to the tuple
+   */
+  auto GetTupleRef(const RID &rid) const -> std::pair<TupleMeta, TupleRef>;
+
   /**
    * Read a tuple meta from a table.
    */
@@ -103,6 +138,8 @@ class TablePage {
   page_id_t next_page_id_;
   uint16_t num_tuples_;
   uint16_t num_deleted_tuples_;
+  uint16_t tuple_start_;
+  uint16_t num_free_slots_;
   TupleInfo tuple_info_[0];
 
   static constexpr size_t TUPLE_INFO_SIZE = 16;
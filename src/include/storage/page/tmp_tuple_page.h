@@ -1,15 +1,13 @@
 #pragma once
 
-#include "storage/page/page.h"
+#include <cstring>
+
+#include "common/config.h"
 #include "storage/table/tmp_tuple.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
-// To pass the test cases for this class, you must follow the existing TmpTuplePage format and implement the
-// existing functions exactly as they are! It may be helpful to look at TablePage.
-// Remember that this task is optional, you get full credit if you finish the next task.
-
 /**
  * TmpTuplePage format:
  *
@@ -17,20 +15,68 @@ namespace bustub {
  * | PageId (4) | LSN (4) | FreeSpace (4) | (free space) | TupleSize2 | TupleData2 | TupleSize1 | TupleData1 |
  *
  * We choose this format because DeserializeExpression expects to read Size followed by Data.
+ *
+ * FreeSpace is the offset of the most recently inserted record. The records are contiguous from there to the end of
+ * the page, newest first, so a page can be scanned by walking from FreeSpace to the end.
+ *
+ * Like TablePage, a TmpTuplePage is laid over the data of a buffer pool page, as returned by a page guard.
  */
-class TmpTuplePage : public Page {
+class TmpTuplePage {
  public:
   void Init(page_id_t page_id, uint32_t page_size) {
     memcpy(GetData(), &page_id, sizeof(page_id_t));
-    memcpy(GetData() + sizeof(page_id_t), &page_size, sizeof(uint32_t));
+    SetFreeSpaceOffset(page_size);
   }
 
-  auto GetTablePageId() -> page_id_t { return INVALID_PAGE_ID; }
+  auto GetTablePageId() const -> page_id_t { return *reinterpret_cast<const page_id_t *>(GetData()); }
 
-  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool { return false; }
+  /** @return the offset of the most recently inserted record, or the page size if the page is empty */
+  auto GetFreeSpaceOffset() const -> uint32_t {
+    return *reinterpret_cast<const uint32_t *>(GetData() + OFFSET_FREE_SPACE);
+  }
+
+  /**
+   * Insert a tuple.
+   * @param tuple the tuple to insert
+   * @param[out] out the location of the inserted tuple
+   * @return `false` if the page does not have enough free space left
+   */
+  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool {
+    auto record_size = sizeof(uint32_t) + tuple.GetLength();
+    auto free_space_offset = GetFreeSpaceOffset();
+    if (free_space_offset < SIZE_TMP_TUPLE_PAGE_HEADER + record_size) {
+      return false;
+    }
+    free_space_offset -= record_size;
+    tuple.SerializeTo(GetData() + free_space_offset);
+    SetFreeSpaceOffset(free_space_offset);
+    *out = TmpTuple(GetTablePageId(), free_space_offset);
+    return true;
+  }
+
+  /**
+   * Read the record at an offset.
+   * @param offset the offset of a record, as returned by Insert()
+   * @param[out] tuple the tuple stored there
+   * @return the offset of the record inserted just before this one
+   */
+  auto Get(size_t offset, Tuple *tuple) const -> size_t {
+    tuple->DeserializeFrom(GetData() + offset);
+    return offset + sizeof(uint32_t) + tuple->GetLength();
+  }
+
+  static constexpr size_t SIZE_TMP_TUPLE_PAGE_HEADER = 12;
 
  private:
+  auto GetData() -> char * { return page_start_; }
+  auto GetData() const -> const char * { return page_start_; }
+
+  void SetFreeSpaceOffset(uint32_t offset) { memcpy(GetData() + OFFSET_FREE_SPACE, &offset, sizeof(uint32_t)); }
+
+  static constexpr size_t OFFSET_FREE_SPACE = 8;
   static_assert(sizeof(page_id_t) == 4);
+
+  char page_start_[0];
 };
 
 }  // namespace bustub
@@ -0,0 +1,206 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// data_chunk.h
+//
+// Identification: src/include/storage/table/data_chunk.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/config.h"
+#include "common/macros.h"
+#include "storage/table/tuple.h"
+#include "type/type_id.h"
+#include "type/value.h"
+
+namespace bustub {
+
+class TablePage;
+
+/**
+ * ColumnVector stores up to `capacity` values of a single column in a typed, contiguous array, with a null bitmap on
+ * the side. Fixed-size values are stored with their natural C++ type (see `GetData<T>()`):
+ *
+ *   BOOLEAN, TINYINT -> int8_t | SMALLINT -> int16_t | INTEGER -> int32_t | BIGINT -> int64_t
+ *   DECIMAL -> double | TIMESTAMP -> uint64_t
+ *
+ * VARCHAR values are copied into a per-vector string heap and read back as `std::string_view`, so decoding a column
+ * never allocates a `Value`.
+ */
+class ColumnVector {
+ public:
+  /**
+   * Construct a new ColumnVector.
+   * @param type the type of the column
+   * @param capacity the maximum number of rows
+   */
+  ColumnVector(TypeId type, size_t capacity);
+
+  /** @return the type of the column */
+  auto GetType() const -> TypeId { return type_; }
+
+  /** @return the typed array of a fixed-size column */
+  template <class T>
+  auto GetData() -> T * {
+    BUSTUB_ASSERT(sizeof(T) == width_, "column accessed with a type of the wrong width");
+    return reinterpret_cast<T *>(data_.data());
+  }
+
+  template <class T>
+  auto GetData() const -> const T * {
+    BUSTUB_ASSERT(sizeof(T) == width_, "column accessed with a type of the wrong width");
+    return reinterpret_cast<const T *>(data_.data());
+  }
+
+  /** @return `true` if the row is null */
+  auto IsNull(size_t row) const -> bool { return ((null_mask_[row / 64] >> (row % 64)) & 1) != 0; }
+
+  /** @return `true` if at least one row is null */
+  auto HasNull() const -> bool { return has_null_; }
+
+  /** Mark the row as null or not null */
+  void SetNull(size_t row, bool is_null);
+
+  /** @return the null bitmap, one bit per row, 64 rows to a word */
+  auto GetNullMask() const -> const uint64_t * { return null_mask_.data(); }
+
+  /** Mark the rows whose bit is set in `mask`, a bitmap over the first num_rows rows, as null. */
+  void MarkNulls(const uint64_t *mask, size_t num_rows);
+
+  /**
+   * @return the string stored at a row of a VARCHAR column, without the terminating zero byte. The view is valid until
+   * the vector is reset.
+   */
+  auto GetString(size_t row) const -> std::string_view;
+
+  /** Decode the serialized value at `storage` (as written by `Value::SerializeTo`) into a row. */
+  void SetFromStorage(size_t row, const char *storage);
+
+  /** Store a value into a row. */
+  void SetValue(size_t row, const Value &value);
+
+  /** @return the value at a row, materialized as a `Value` */
+  auto GetValue(size_t row) const -> Value;
+
+  /** Forget all the rows. */
+  void Reset();
+
+ private:
+  struct StringEntry {
+    uint32_t offset_;
+    uint32_t len_;
+  };
+
+  void SetRawString(size_t row, const char *data, uint32_t len);
+
+  /** The column type */
+  TypeId type_;
+  /** Size in bytes of one entry of data_ */
+  size_t width_;
+  /** Fixed-size values, or StringEntry for VARCHAR. Backed by uint64_t to keep every entry aligned. */
+  std::vector<uint64_t> data_;
+  /** One bit per row, set if the row is null */
+  std::vector<uint64_t> null_mask_;
+  bool has_null_{false};
+  /** The bytes of VARCHAR values */
+  std::vector<char> string_heap_;
+};
+
+/**
+ * DataChunk is a columnar batch of rows: one ColumnVector per column of a schema, plus an optional selection vector
+ * that lists the rows still alive (e.g. after a filter) so that rows do not need to be moved around.
+ */
+class DataChunk {
+ public:
+  /**
+   * Construct a new DataChunk.
+   * @param schema the schema of the rows, which must outlive the chunk
+   * @param capacity the maximum number of rows
+   */
+  explicit DataChunk(const Schema *schema, size_t capacity = BUSTUB_BATCH_SIZE);
+
+  /** @return the schema of the rows */
+  auto GetSchema() const -> const Schema & { return *schema_; }
+
+  /** @return the column at idx */
+  auto GetColumn(uint32_t idx) -> ColumnVector & { return columns_[idx]; }
+  auto GetColumn(uint32_t idx) const -> const ColumnVector & { return columns_[idx]; }
+
+  /** @return the number of columns */
+  auto GetColumnCount() const -> uint32_t { return columns_.size(); }
+
+  /** @return the number of rows physically stored, ignoring the selection */
+  auto Size() const -> size_t { return size_; }
+
+  /** @return the maximum number of rows */
+  auto Capacity() const -> size_t { return capacity_; }
+
+  /** @return `true` if no row can be appended */
+  auto IsFull() const -> bool { return size_ == capacity_; }
+
+  /** Remove all rows and the selection. */
+  void Reset();
+
+  /** Decode a serialized tuple (in the `Tuple` row format) and append it as a new row. */
+  void AppendTupleData(const char *data);
+
+  /** Append a tuple as a new row. */
+  void AppendTuple(const Tuple &tuple) { AppendTupleData(tuple.GetData()); }
+
+  /**
+   * Append the live tuples of a table page, starting at a slot, until the chunk is full.
+   * @param page the table page, which must be latched by the caller
+   * @param page_id the id of the table page, used to fill in the RIDs
+   * @param start_slot the first slot to read
+   * @return the first slot that was not read, equal to the number of tuples in the page if the page was exhausted
+   */
+  auto AppendTablePage(const TablePage &page, page_id_t page_id, uint32_t start_slot) -> uint32_t;
+
+  /** @return the RID of a row, if it was loaded from a table page */
+  auto GetRID(size_t row) const -> RID { return rids_[row]; }
+
+  /** @return the value at a row and column */
+  auto GetValue(uint32_t col_idx, size_t row) const -> Value { return columns_[col_idx].GetValue(row); }
+
+  /** @return a row materialized as a tuple */
+  auto GetTuple(size_t row) const -> Tuple;
+
+  /** @return `true` if a selection vector restricts the live rows */
+  auto HasSelection() const -> bool { return has_selection_; }
+
+  /** Restrict the live rows to `selection`, a strictly increasing list of row positions. */
+  void SetSelection(std::vector<uint32_t> selection);
+
+  /** Drop the selection vector, making every row live again. */
+  void ClearSelection() {
+    has_selection_ = false;
+    selection_.clear();
+  }
+
+  /** @return the number of live rows */
+  auto GetSelectedCount() const -> size_t { return has_selection_ ? selection_.size() : size_; }
+
+  /** @return the row position of the i-th live row */
+  auto GetSelectedRow(size_t i) const -> uint32_t { return has_selection_ ? selection_[i] : i; }
+
+ private:
+  const Schema *schema_;
+  size_t capacity_;
+  size_t size_{0};
+  std::vector<ColumnVector> columns_;
+  std::vector<RID> rids_;
+  bool has_selection_{false};
+  std::vector<uint32_t> selection_;
+};
+
+}  // namespace bustub
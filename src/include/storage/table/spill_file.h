@@ -0,0 +1,119 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// spill_file.h
+//
+// Identification: src/include/storage/table/spill_file.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/config.h"
+#include "common/macros.h"
+#include "storage/page/page_guard.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * SpillFile is an append-only sequence of tuples stored in temporary pages (TmpTuplePage) of the buffer pool. Operators
+ * that run out of their memory budget write their intermediate state to spill files and read it back sequentially.
+ *
+ * Only the page being written is pinned while appending, and only the page being read is pinned while reading, so a
+ * spill file holds at most one frame at a time. The pages are deleted when the file is destroyed.
+ *
+ * A tuple too large for a TmpTuplePage, e.g. an aggregation group with a large sketch, is stored on its own run of
+ * overflow pages, which hold its serialized record split into page-sized fragments.
+ */
+class SpillFile {
+ public:
+  /**
+   * Sequential reader of a spill file. Tuples are returned in the order they were appended, one page at a time.
+   */
+  class Reader {
+   public:
+    explicit Reader(const SpillFile *file) : file_(file) {}
+
+    /**
+     * Read the next tuple.
+     * @param[out] tuple the next tuple
+     * @return `false` if the whole file was read
+     */
+    auto Next(Tuple *tuple) -> bool;
+
+   private:
+    void LoadPage(page_id_t page_id);
+
+    /** Read a large tuple from its run of overflow pages, starting at the page `page_idx_`. */
+    void LoadLargeTuple(uint32_t record_size);
+
+    const SpillFile *file_;
+    /** The index in the file of the next page to load */
+    size_t page_idx_{0};
+    /** The tuples of the current page, in append order */
+    std::vector<Tuple> buffer_;
+    size_t buffer_idx_{0};
+  };
+
+  /**
+   * Create an empty spill file.
+   * @param bpm the buffer pool the pages are allocated from
+   */
+  explicit SpillFile(BufferPoolManager *bpm) : bpm_(bpm) {}
+
+  ~SpillFile();
+
+  DISALLOW_COPY_AND_MOVE(SpillFile);
+
+  /** Append a tuple of any size. Throws if the buffer pool has no free frame. */
+  void Append(const Tuple &tuple);
+
+  /** Unpin the page being written. Must be called once all the tuples were appended, before reading. */
+  void Finish();
+
+  /** @return a reader positioned at the first tuple */
+  auto MakeReader() const -> Reader {
+    BUSTUB_ASSERT(write_page_id_ == INVALID_PAGE_ID, "reading a spill file that is still being written");
+    return Reader{this};
+  }
+
+  /** @return the number of tuples in the file */
+  auto Size() const -> size_t { return num_tuples_; }
+
+  /** @return the total size of the serialized tuples, in bytes */
+  auto GetDataSize() const -> size_t { return data_size_; }
+
+  /** @return the number of pages of the file */
+  auto GetPageCount() const -> size_t { return pages_.size(); }
+
+ private:
+  /** A page of the file: a TmpTuplePage of whole records, or a fragment of a record too large for one */
+  struct FilePage {
+    page_id_t page_id_;
+    /** The size of the whole record on the first overflow page of a large tuple, 0 on any other page */
+    uint32_t large_record_size_;
+  };
+
+  /** Allocate a page at the end of the file. */
+  auto NewPage(uint32_t large_record_size) -> BasicPageGuard;
+
+  /** Write a tuple too large for a TmpTuplePage to a run of overflow pages. */
+  void AppendLarge(const Tuple &tuple);
+
+  BufferPoolManager *bpm_;
+  std::vector<FilePage> pages_;
+  /** The last page, pinned while the file is written, and its id */
+  BasicPageGuard write_guard_;
+  page_id_t write_page_id_{INVALID_PAGE_ID};
+  size_t num_tuples_{0};
+  size_t data_size_{0};
+};
+
+}  // namespace bustub
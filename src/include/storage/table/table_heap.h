@@ -12,9 +12,15 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <memory>
 #include <mutex>  // NOLINT
 #include <optional>
+#include <shared_mutex>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "buffer/buffer_pool_manager.h"
 #include "common/config.h"
@@ -27,9 +33,27 @@
 
 namespace bustub {
 
+/**
+ * TableMorsel is a contiguous range of pages of a table heap, the unit of work of a parallel sequential scan.
+ */
+struct TableMorsel {
+  /** The first tuple of the morsel */
+  RID start_rid_;
+  /** The RID right after the last tuple of the morsel, as used by TableIterator */
+  RID stop_at_rid_;
+};
+
 /**
  * TableHeap represents a physical table on disk.
  * This is just a doubly-linked list of pages.
+ *
+ * A free space map, stored in pages of its own, keeps the room left in every page of the table.
+ *
+ * Inserting threads are spread over NUM_INSERT_LANES insert lanes, and append to the page of their lane, so that
+ * concurrent inserts go to disjoint pages. When the page of a lane is full, the lane claims another page with room
+ * from the free space map, or a new page appended to the table. A page claimed by a lane has a fill level of zero in
+ * the map, so that other lanes do not pick it, until it is full. New pages are chained without a table-wide latch:
+ * the link is set under the latch of the last page, and the last page id moves forward by compare-and-swap.
  */
 class TableHeap {
   friend class TableIterator;
@@ -54,9 +78,18 @@ class TableHeap {
                    Transaction *txn = nullptr, table_oid_t oid = 0) -> std::optional<RID>;
 
   /**
-   * Insert a tuple into the table. If the tuple is too large (>= page_size), return false.
+   * Append complete table pages, built in memory by the caller, to the end of the table: the bulk load path. The pages
+   * are written into new pages of the buffer pool, chained, and linked after the last page of the table at once.
+   * @param pages the images of the pages, BUSTUB_PAGE_SIZE bytes each, initialized as TablePages
+   * @return the ids of the new pages, in order, so that the caller can compute the RIDs of the tuples
+   */
+  auto AppendPages(const std::vector<std::unique_ptr<char[]>> &pages) -> std::vector<page_id_t>;
+
+  /**
+   * Update the meta of a tuple. Once the deletion of a tuple is complete, i.e. it is deleted with no delete txn, its
+   * space can be reused by later inserts, and so can its RID.
    * @param meta new tuple meta
-   * @param[out] rid the rid of the inserted tuple
+   * @param rid the rid of the tuple
    */
   void UpdateTupleMeta(const TupleMeta &meta, RID rid);
 
@@ -81,6 +114,17 @@ class TableHeap {
   /** @return the iterator of this table, use this for project 4 except updates */
   auto MakeEagerIterator() -> TableIterator;
 
+  /**
+   * Split the tuples currently in the table into morsels of `pages_per_morsel` pages each. Like MakeIterator(), the
+   * morsels do not cover tuples inserted after this call.
+   * @param pages_per_morsel the number of pages in every morsel but the last one
+   * @return the morsels, in table order
+   */
+  auto MakeMorsels(size_t pages_per_morsel = MORSEL_SIZE_IN_PAGES) -> std::vector<TableMorsel>;
+
+  /** @return an iterator over the tuples of a morsel */
+  auto MakeMorselIterator(const TableMorsel &morsel) -> TableIterator;
+
   /** @return the id of the first page of this table */
   inline auto GetFirstPageId() const -> page_id_t { return first_page_id_; }
 
@@ -96,8 +140,35 @@ class TableHeap {
   BufferPoolManager *bpm_;
   page_id_t first_page_id_{INVALID_PAGE_ID};
 
+  /**
+   * Claim a page with room for a tuple of `size` bytes according to the free space map, if any, setting its fill level
+   * to zero.
+   */
+  auto ClaimPageWithSpace(size_t size) -> std::optional<page_id_t>;
+
+  /** Set the free space of a table page in the free space map. The caller holds the write latch of the page. */
+  void UpdateFreeSpace(page_id_t page_id, size_t free_space);
+
+  /** Add a new table page to the free space map. */
+  void AddToFreeSpaceMap(page_id_t page_id, size_t free_space);
+
+  /** Link a chain of new pages, from first_page_id to last_page_id, after the last page of the table. */
+  void LinkPages(page_id_t first_page_id, page_id_t last_page_id);
+
+  /** Insert lanes */
+  static constexpr size_t NUM_INSERT_LANES = 16;
+
+  std::atomic<page_id_t> last_page_id_{INVALID_PAGE_ID};
+  /** The page every insert lane appends to, INVALID_PAGE_ID until it claims one */
+  std::array<std::atomic<page_id_t>, NUM_INSERT_LANES> insert_page_ids_;
+
+  /** The first and last pages of the free space map, the last one being protected by latch_ */
   std::mutex latch_;
-  page_id_t last_page_id_{INVALID_PAGE_ID}; /* protected by latch_ */
+  page_id_t first_fsm_page_id_{INVALID_PAGE_ID};
+  page_id_t last_fsm_page_id_{INVALID_PAGE_ID};
+  /** The entry of every table page in the free space map, as its map page and index, protected by fsm_latch_ */
+  std::shared_mutex fsm_latch_;
+  std::unordered_map<page_id_t, std::pair<page_id_t, uint32_t>> fsm_entries_;
 };
 
 }  // namespace bustub
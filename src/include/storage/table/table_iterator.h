@@ -15,15 +15,18 @@
 #include <cassert>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "common/macros.h"
 #include "common/rid.h"
 #include "concurrency/transaction.h"
+#include "storage/page/page_guard.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 class TableHeap;
+class TablePage;
 
 /**
  * TableIterator enables the sequential scan of a TableHeap.
@@ -41,6 +44,17 @@ class TableIterator {
 
   auto GetTuple() -> std::pair<TupleMeta, Tuple>;
 
+  /**
+   * Reference the live tuples that follow in the current page, up to `max_tuples`, and move past them. Deleted tuples
+   * are skipped. The tuples are not copied out of the page: the iterator keeps the page pinned and read-latched, and
+   * the references valid, until the next call to ReadTupleRefs(), GetTuple(), operator++ or ReleasePage().
+   * The iterator must not be at the end.
+   */
+  void ReadTupleRefs(size_t max_tuples, std::vector<TupleRef> *tuples);
+
+  /** Unpin and unlatch the page of the last ReadTupleRefs(), invalidating its references. */
+  void ReleasePage() { page_guard_.Drop(); }
+
   auto GetRID() -> RID;
 
   auto IsEnd() -> bool;
@@ -48,8 +62,13 @@ class TableIterator {
   auto operator++() -> TableIterator &;
 
  private:
+  /** Move to the tuple after the current one, `page` being the page of the current tuple. */
+  void Advance(const TablePage *page);
+
   TableHeap *table_heap_;
   RID rid_;
+  /** The page read by the last ReadTupleRefs() */
+  ReadPageGuard page_guard_;
 
   // When creating table iterator, we will record the maximum RID that we should scan.
   // Otherwise we will have dead loops when updating while scanning. (In project 4, update should be implemented as
@@ -42,6 +42,8 @@ struct TupleMeta {
 
 static_assert(sizeof(TupleMeta) == TUPLE_META_SIZE);
 
+class TupleRef;
+
 /**
  * Tuple format:
  * ---------------------------------------------------------------------
@@ -52,6 +54,7 @@ class Tuple {
   friend class TablePage;
   friend class TableHeap;
   friend class TableIterator;
+  friend class TupleRef;
 
  public:
   // Default constructor (to create a dummy tuple)
@@ -93,17 +96,24 @@ class Tuple {
   // checks the schema to see how to return the Value.
   auto GetValue(const Schema *schema, uint32_t column_idx) const -> Value;
 
+  // Get the value of a specified column, borrowing variable length data from the tuple:
+  // the value must not outlive the tuple, see Value::DeserializeViewFrom().
+  auto GetValueView(const Schema *schema, uint32_t column_idx) const -> Value;
+
   // Generates a key tuple given schemas and attributes
   auto KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs) -> Tuple;
 
   // Is the column value null ?
   inline auto IsNull(const Schema *schema, uint32_t column_idx) const -> bool {
-    Value value = GetValue(schema, column_idx);
+    Value value = GetValueView(schema, column_idx);
     return value.IsNull();
   }
 
   auto ToString(const Schema *schema) const -> std::string;
 
+  // Get a reference to the tuple data, valid until the tuple is modified or destroyed
+  auto AsRef() const -> TupleRef;
+
  private:
   // Get the starting storage address of specific column
   auto GetDataPtr(const Schema *schema, uint32_t column_idx) const -> const char *;
@@ -112,4 +122,42 @@ class Tuple {
   std::vector<char> data_;
 };
 
+/**
+ * TupleRef refers to the data of a tuple, in the Tuple format, stored elsewhere: usually in a table page pinned by
+ * the TableIterator that handed it out, or in a Tuple. It is only valid as long as that storage is, so that a scan
+ * can read the tuples of a page in place and only copy out those it keeps, with ToTuple() or CopyTo().
+ */
+class TupleRef {
+ public:
+  TupleRef() = default;
+  TupleRef(const char *data, uint32_t length, RID rid) : data_(data), length_(length), rid_(rid) {}
+
+  inline auto GetRid() const -> RID { return rid_; }
+
+  inline auto GetData() const -> const char * { return data_; }
+
+  inline auto GetLength() const -> uint32_t { return length_; }
+
+  // Get the value of a specified column, copying variable length data out of the referenced storage
+  auto GetValue(const Schema *schema, uint32_t column_idx) const -> Value;
+
+  // Get the value of a specified column, borrowing variable length data from the referenced storage
+  auto GetValueView(const Schema *schema, uint32_t column_idx) const -> Value;
+
+  // Copy the tuple into an owned Tuple
+  auto ToTuple() const -> Tuple;
+
+  // Copy the tuple into `tuple`, reusing its buffer
+  void CopyTo(Tuple *tuple) const;
+
+ private:
+  friend class Tuple;
+
+  auto GetDataPtr(const Schema *schema, uint32_t column_idx) const -> const char *;
+
+  const char *data_{nullptr};
+  uint32_t length_{0};
+  RID rid_{};
+};
+
 }  // namespace bustub
@@ -29,6 +29,12 @@ inline auto GetCmpBool(bool boolean) -> CmpBool { return boolean ? CmpBool::CmpT
 // A value is an abstract class that represents a view over SQL data stored in
 // some materialized state. All values have a type and comparison functions, but
 // subclasses implement other type-specific functionality.
+//
+// VARCHAR data is either owned by the value or borrowed from a tuple, a page or
+// another value (see DeserializeViewFrom() and View()). Owned strings of up to
+// INLINE_VARLEN_SIZE bytes are stored inside the value, without allocating.
+// Copying or moving a borrowing value makes an owning one: only the value a view
+// is returned into borrows, and it must not outlive the bytes it reads.
 class Value {
   // Friend Type classes
   friend class Type;
@@ -64,7 +70,9 @@ class Value {
 
   Value() : Value(TypeId::INVALID) {}
   Value(const Value &other);
-  auto operator=(Value other) -> Value &;
+  Value(Value &&other) noexcept;
+  auto operator=(const Value &other) -> Value &;
+  auto operator=(Value &&other) noexcept -> Value &;
   ~Value();
   // NOLINTNEXTLINE
   friend void Swap(Value &first, Value &second) {
@@ -139,6 +147,16 @@ class Value {
     return Type::GetInstance(type_id)->DeserializeFrom(storage);
   }
 
+  // Deserialize a value of the given type from the given storage space, borrowing
+  // variable length data from the storage space instead of copying it.
+  static auto DeserializeViewFrom(const char *storage, TypeId type_id) -> Value;
+
+  // Return a value borrowing the variable length data of this value.
+  auto View() const -> Value;
+
+  // Strings of up to this many bytes, terminating zero included, are stored inline.
+  static constexpr uint32_t INLINE_VARLEN_SIZE = 16;
+
   // Return a string version of this value
   inline auto ToString() const -> std::string { return Type::GetInstance(type_id_)->ToString(*this); }
   // Create a copy of this value
@@ -156,6 +174,7 @@ class Value {
     uint64_t timestamp_;
     char *varlen_;
     const char *const_varlen_;
+    char inline_varlen_[INLINE_VARLEN_SIZE];
   } value_;
 
   union {
@@ -163,9 +182,19 @@ class Value {
     TypeId elem_type_id_;
   } size_;
 
+  // Whether the value owns its variable length data, inline or on the heap
   bool manage_data_;
   // The data type
   TypeId type_id_;
+
+ private:
+  // Whether the variable length data is owned and stored in inline_varlen_
+  inline auto IsVarlenInline() const -> bool { return manage_data_ && size_.len_ <= INLINE_VARLEN_SIZE; }
+  inline auto GetVarlenData() const -> const char * {
+    return IsVarlenInline() ? value_.inline_varlen_ : value_.const_varlen_;
+  }
+  // Take ownership of a copy of the variable length data
+  void CopyVarlen(const char *data, uint32_t len);
 };
 }  // namespace bustub
 
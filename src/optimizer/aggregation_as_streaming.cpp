@@ -0,0 +1,52 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/streaming_aggregation_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+auto Optimizer::OptimizeAggregationAsStreaming(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeAggregationAsStreaming(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::Aggregation) {
+    const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(*optimized_plan);
+    // Without groups, there is nothing to stream.
+    if (agg_plan.GetGroupBys().empty()) {
+      return optimized_plan;
+    }
+    std::vector<uint32_t> group_by_columns;
+    for (const auto &expr : agg_plan.GetGroupBys()) {
+      const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      if (column_value_expr == nullptr) {
+        return optimized_plan;
+      }
+      group_by_columns.push_back(column_value_expr->GetColIdx());
+    }
+    std::sort(group_by_columns.begin(), group_by_columns.end());
+    group_by_columns.erase(std::unique(group_by_columns.begin(), group_by_columns.end()), group_by_columns.end());
+
+    // The tuples of a group are consecutive if the child is sorted on the group by columns first, in any order.
+    auto ordering = GetOutputOrdering(agg_plan.GetChildPlan());
+    if (ordering.size() < group_by_columns.size()) {
+      return optimized_plan;
+    }
+    ordering.resize(group_by_columns.size());
+    std::sort(ordering.begin(), ordering.end());
+    if (ordering == group_by_columns) {
+      return std::make_shared<StreamingAggregationPlanNode>(agg_plan.output_schema_, agg_plan.GetChildPlan(),
+                                                            agg_plan.GetGroupBys(), agg_plan.GetAggregates(),
+                                                            agg_plan.GetAggregateTypes(), agg_plan.GetAggregateArgs());
+    }
+  }
+  return optimized_plan;
+}
+
+}  // namespace bustub
@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#include "execution/executors/hash_join_executor.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "optimizer/optimizer.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+namespace {
+
+/**
+ * @return the permutation of the key columns that the ordering starts with, i.e. the position in `key_columns` of each
+ * leading column of `ordering`, if it starts with all the key columns in some order
+ */
+auto KeyOrderOf(const std::vector<uint32_t> &ordering, const std::vector<uint32_t> &key_columns)
+    -> std::optional<std::vector<size_t>> {
+  if (ordering.size() < key_columns.size()) {
+    return std::nullopt;
+  }
+  std::vector<size_t> key_order;
+  for (size_t i = 0; i < key_columns.size(); i++) {
+    auto it = std::find(key_columns.begin(), key_columns.end(), ordering[i]);
+    if (it == key_columns.end() || std::find(key_order.begin(), key_order.end(), it - key_columns.begin()) !=
+                                       key_order.end()) {
+      return std::nullopt;
+    }
+    key_order.push_back(it - key_columns.begin());
+  }
+  return key_order;
+}
+
+template <typename T>
+auto Permute(const std::vector<T> &values, const std::vector<size_t> &order) -> std::vector<T> {
+  std::vector<T> permuted;
+  permuted.reserve(order.size());
+  for (auto idx : order) {
+    permuted.push_back(values[idx]);
+  }
+  return permuted;
+}
+
+/** @return a sort of the plan on the key columns, in ascending order */
+auto SortOnKeys(const AbstractPlanNodeRef &plan, const std::vector<uint32_t> &key_columns) -> AbstractPlanNodeRef {
+  std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys;
+  for (auto col_idx : key_columns) {
+    order_bys.emplace_back(OrderByType::ASC, std::make_shared<ColumnValueExpression>(
+                                                 0, col_idx, plan->OutputSchema().GetColumn(col_idx).GetType()));
+  }
+  return std::make_shared<SortPlanNode>(plan->output_schema_, plan, std::move(order_bys));
+}
+
+/**
+ * @return the bytes a hybrid hash join writes to and reads back from spill files, for a build side taking `build_size`
+ * bytes in its hash table and a probe side of `probe_size` bytes
+ */
+auto HashJoinSpillCost(double build_size, double probe_size, double memory_budget) -> double {
+  if (build_size <= memory_budget) {
+    return 0;
+  }
+  // Once the build side overflows, all the partitions but one go to disk along with their share of the probe side, and
+  // a spilled partition that still does not fit is partitioned again, which writes and reads it once more.
+  const auto fanout = static_cast<double>(HashJoinExecutor::SPILL_FANOUT);
+  double num_passes = 1;
+  for (auto partition_size = build_size / fanout;
+       partition_size > memory_budget && num_passes <= HashJoinExecutor::MAX_SPILL_LEVEL; partition_size /= fanout) {
+    num_passes++;
+  }
+  return 2 * (build_size + probe_size) * (fanout - 1) / fanout * num_passes;
+}
+
+/** @return the bytes an external merge sort of `size` bytes writes to and reads back from spill files */
+auto SortSpillCost(double size, double memory_budget) -> double {
+  if (size <= memory_budget) {
+    return 0;
+  }
+  // The runs are written and read once, and once more for every intermediate pass merging too many runs at once, with
+  // the fan-in of SortExecutor.
+  auto num_runs = std::ceil(size / memory_budget);
+  auto max_fan_in = std::max(2.0, std::floor(memory_budget / (4 * BUSTUB_PAGE_SIZE)));
+  double num_passes = 1;
+  for (; num_runs > max_fan_in; num_runs = std::ceil(num_runs / max_fan_in)) {
+    num_passes++;
+  }
+  return 2 * size * num_passes;
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeHashJoinAsMergeJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeHashJoinAsMergeJoin(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::HashJoin) {
+    return optimized_plan;
+  }
+  const auto &hash_join_plan = dynamic_cast<const HashJoinPlanNode &>(*optimized_plan);
+  if (!(hash_join_plan.GetJoinType() == JoinType::INNER || hash_join_plan.GetJoinType() == JoinType::LEFT)) {
+    return optimized_plan;
+  }
+  std::vector<uint32_t> left_columns;
+  std::vector<uint32_t> right_columns;
+  for (auto [exprs, columns] : {std::make_pair(&hash_join_plan.LeftJoinKeyExpressions(), &left_columns),
+                                std::make_pair(&hash_join_plan.RightJoinKeyExpressions(), &right_columns)}) {
+    for (const auto &expr : *exprs) {
+      const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      if (column_value_expr == nullptr) {
+        return optimized_plan;
+      }
+      columns->push_back(column_value_expr->GetColIdx());
+    }
+  }
+
+  // Both children must be sorted on the keys in the same order. Take the order a child is already sorted in, if any.
+  auto left_ordering = GetOutputOrdering(hash_join_plan.GetLeftPlan());
+  auto right_ordering = GetOutputOrdering(hash_join_plan.GetRightPlan());
+  auto key_order = KeyOrderOf(left_ordering, left_columns);
+  if (!key_order.has_value()) {
+    key_order = KeyOrderOf(right_ordering, right_columns);
+  }
+  if (!key_order.has_value()) {
+    key_order.emplace(left_columns.size());
+    std::iota(key_order->begin(), key_order->end(), 0);
+  }
+  left_columns = Permute(left_columns, *key_order);
+  right_columns = Permute(right_columns, *key_order);
+
+  // A child that is not sorted yet is sorted for free if the sort can be done by an index scan.
+  auto sorted_child = [this](const AbstractPlanNodeRef &child, std::vector<uint32_t> ordering,
+                             const std::vector<uint32_t> &columns) -> AbstractPlanNodeRef {
+    if (ordering.size() >= columns.size() && std::equal(columns.begin(), columns.end(), ordering.begin())) {
+      return child;
+    }
+    auto index_scan = OptimizeOrderByAsIndexScan(SortOnKeys(child, columns));
+    return index_scan->GetType() == PlanType::IndexScan ? index_scan : nullptr;
+  };
+  auto left = sorted_child(hash_join_plan.GetLeftPlan(), std::move(left_ordering), left_columns);
+  auto right = sorted_child(hash_join_plan.GetRightPlan(), std::move(right_ordering), right_columns);
+
+  if (left == nullptr || right == nullptr) {
+    // Sorting a child costs an external sort if it does not fit in memory, and the hash join spills if its hash table
+    // does not. Compare the bytes both would move through spill files, and keep the hash join on a tie, as hashing is
+    // cheaper than sorting once both run in memory.
+    auto left_plan = hash_join_plan.GetLeftPlan();
+    auto right_plan = hash_join_plan.GetRightPlan();
+    auto left_cardinality = EstimatedOutputCardinality(left_plan);
+    auto right_cardinality = EstimatedOutputCardinality(right_plan);
+    if (!left_cardinality.has_value() || !right_cardinality.has_value()) {
+      return optimized_plan;
+    }
+    auto left_size = static_cast<double>(*left_cardinality) * (left_plan->OutputSchema().GetLength() + sizeof(Tuple));
+    auto right_size =
+        static_cast<double>(*right_cardinality) * (right_plan->OutputSchema().GetLength() + sizeof(Tuple));
+    auto build_size =
+        right_size + static_cast<double>(*right_cardinality) * (right_columns.size() * sizeof(Value) + 4 * sizeof(hash_t));
+    auto memory_budget = static_cast<double>(memory_budget_);
+    auto sort_cost = (left == nullptr ? SortSpillCost(left_size, memory_budget) : 0) +
+                     (right == nullptr ? SortSpillCost(right_size, memory_budget) : 0);
+    if (sort_cost >= HashJoinSpillCost(build_size, left_size, memory_budget)) {
+      return optimized_plan;
+    }
+    if (left == nullptr) {
+      left = SortOnKeys(left_plan, left_columns);
+    }
+    if (right == nullptr) {
+      right = SortOnKeys(right_plan, right_columns);
+    }
+  }
+
+  return std::make_shared<MergeJoinPlanNode>(hash_join_plan.output_schema_, std::move(left), std::move(right),
+                                             Permute(hash_join_plan.LeftJoinKeyExpressions(), *key_order),
+                                             Permute(hash_join_plan.RightJoinKeyExpressions(), *key_order),
+                                             hash_join_plan.GetJoinType());
+}
+
+}  // namespace bustub
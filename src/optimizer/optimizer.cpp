@@ -1,7 +1,14 @@
 #include "optimizer/optimizer.h"
+#include <algorithm>
 #include <optional>
 #include "common/util/string_util.h"
+#include "execution/executors/mock_scan_executor.h"
 #include "execution/plans/abstract_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/limit_plan.h"
+#include "execution/plans/mock_scan_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "execution/plans/topn_plan.h"
 
 namespace bustub {
 
@@ -41,4 +48,41 @@ auto Optimizer::EstimatedCardinality(const std::string &table_name) -> std::opti
   return std::nullopt;
 }
 
+auto Optimizer::EstimatedOutputCardinality(const AbstractPlanNodeRef &plan) -> std::optional<size_t> {
+  switch (plan->GetType()) {
+    case PlanType::SeqScan:
+      return EstimatedCardinality(catalog_.GetTable(dynamic_cast<const SeqScanPlanNode &>(*plan).GetTableOid())->name_);
+    case PlanType::IndexScan: {
+      const auto *index_info = catalog_.GetIndex(dynamic_cast<const IndexScanPlanNode &>(*plan).GetIndexOid());
+      if (index_info == Catalog::NULL_INDEX_INFO) {
+        return std::nullopt;
+      }
+      return EstimatedCardinality(index_info->table_name_);
+    }
+    case PlanType::MockScan: {
+      const auto &mock_scan_plan = dynamic_cast<const MockScanPlanNode &>(*plan);
+      auto cardinality = EstimatedCardinality(mock_scan_plan.GetTable());
+      return cardinality.has_value() ? cardinality : std::make_optional(GetSizeOf(&mock_scan_plan));
+    }
+    case PlanType::Filter:
+    case PlanType::Projection:
+    case PlanType::Sort:
+    case PlanType::Aggregation:
+    case PlanType::StreamingAggregation:
+      return EstimatedOutputCardinality(plan->GetChildAt(0));
+    case PlanType::Limit: {
+      auto cardinality = EstimatedOutputCardinality(plan->GetChildAt(0));
+      auto limit = dynamic_cast<const LimitPlanNode &>(*plan).GetLimit();
+      return cardinality.has_value() ? std::min(*cardinality, limit) : limit;
+    }
+    case PlanType::TopN: {
+      auto cardinality = EstimatedOutputCardinality(plan->GetChildAt(0));
+      auto n = dynamic_cast<const TopNPlanNode &>(*plan).GetN();
+      return cardinality.has_value() ? std::min(*cardinality, n) : n;
+    }
+    default:
+      return std::nullopt;
+  }
+}
+
 }  // namespace bustub
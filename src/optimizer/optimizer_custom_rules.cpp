@@ -11,9 +11,12 @@ auto Optimizer::OptimizeCustom(const AbstractPlanNodeRef &plan) -> AbstractPlanN
   auto p = plan;
   p = OptimizeMergeProjection(p);
   p = OptimizeMergeFilterNLJ(p);
+  p = OptimizePushDownJoinPredicate(p);
   p = OptimizeNLJAsHashJoin(p);
   p = OptimizeOrderByAsIndexScan(p);
+  p = OptimizeHashJoinAsMergeJoin(p);
   p = OptimizeSortLimitAsTopN(p);
+  p = OptimizeAggregationAsStreaming(p);
   return p;
 }
 
@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/plans/streaming_aggregation_plan.h"
+#include "execution/plans/topn_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/** @return the leading ascending column ORDER BYs, as column indexes */
+auto OrderingOfOrderBys(const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys)
+    -> std::vector<uint32_t> {
+  std::vector<uint32_t> ordering;
+  for (const auto &[order_type, expr] : order_bys) {
+    const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+    if (!(order_type == OrderByType::ASC || order_type == OrderByType::DEFAULT) || column_value_expr == nullptr) {
+      break;
+    }
+    ordering.push_back(column_value_expr->GetColIdx());
+  }
+  return ordering;
+}
+
+/** @return the ordering of the child mapped to the output columns that are plain copies of its columns */
+auto MapOrdering(const std::vector<uint32_t> &child_ordering, const std::vector<AbstractExpressionRef> &exprs)
+    -> std::vector<uint32_t> {
+  std::vector<uint32_t> ordering;
+  for (auto child_col : child_ordering) {
+    auto it = std::find_if(exprs.begin(), exprs.end(), [child_col](const AbstractExpressionRef &expr) {
+      const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      return column_value_expr != nullptr && column_value_expr->GetColIdx() == child_col;
+    });
+    if (it == exprs.end()) {
+      break;
+    }
+    ordering.push_back(static_cast<uint32_t>(it - exprs.begin()));
+  }
+  return ordering;
+}
+
+}  // namespace
+
+auto Optimizer::GetOutputOrdering(const AbstractPlanNodeRef &plan) -> std::vector<uint32_t> {
+  switch (plan->GetType()) {
+    case PlanType::Sort:
+      return OrderingOfOrderBys(dynamic_cast<const SortPlanNode &>(*plan).GetOrderBy());
+    case PlanType::TopN:
+      return OrderingOfOrderBys(dynamic_cast<const TopNPlanNode &>(*plan).GetOrderBy());
+    case PlanType::IndexScan: {
+      // Index scans walk the B+ tree, in ascending key order.
+      const auto *index_info = catalog_.GetIndex(dynamic_cast<const IndexScanPlanNode &>(*plan).GetIndexOid());
+      if (index_info == Catalog::NULL_INDEX_INFO) {
+        return {};
+      }
+      return index_info->index_->GetKeyAttrs();
+    }
+    case PlanType::Filter:
+    case PlanType::Limit:
+      return GetOutputOrdering(plan->GetChildAt(0));
+    case PlanType::Projection:
+      return MapOrdering(GetOutputOrdering(plan->GetChildAt(0)),
+                         dynamic_cast<const ProjectionPlanNode &>(*plan).GetExpressions());
+    case PlanType::MergeJoin:
+      // The left columns come first in the output, and the left child is only read forward.
+      return GetOutputOrdering(plan->GetChildAt(0));
+    case PlanType::StreamingAggregation:
+      // The groups come out in the order of the child, with the group by columns first.
+      return MapOrdering(GetOutputOrdering(plan->GetChildAt(0)),
+                         dynamic_cast<const StreamingAggregationPlanNode &>(*plan).GetGroupBys());
+    default:
+      return {};
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,141 @@
+#include <memory>
+#include <vector>
+#include "common/macros.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "optimizer/optimizer.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** Split a predicate into the terms it ANDs together. */
+void SplitConjunction(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *terms) {
+  if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(expr.get());
+      logic_expr != nullptr && logic_expr->logic_type_ == LogicType::And) {
+    SplitConjunction(logic_expr->GetChildAt(0), terms);
+    SplitConjunction(logic_expr->GetChildAt(1), terms);
+    return;
+  }
+  terms->push_back(expr);
+}
+
+/** @return the AND of the terms, or true if there is none */
+auto MakeConjunction(const std::vector<AbstractExpressionRef> &terms) -> AbstractExpressionRef {
+  if (terms.empty()) {
+    return std::make_shared<ConstantValueExpression>(ValueFactory::GetBooleanValue(true));
+  }
+  auto expr = terms[0];
+  for (size_t i = 1; i < terms.size(); i++) {
+    expr = std::make_shared<LogicExpression>(expr, terms[i], LogicType::And);
+  }
+  return expr;
+}
+
+/** @return a bit mask of the join sides an expression reads columns from, bit 0 for the left and bit 1 for the right */
+auto SidesOf(const AbstractExpressionRef &expr) -> uint32_t {
+  if (const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      column_value_expr != nullptr) {
+    return 1U << column_value_expr->GetTupleIdx();
+  }
+  uint32_t sides = 0;
+  for (const auto &child : expr->GetChildren()) {
+    sides |= SidesOf(child);
+  }
+  return sides;
+}
+
+/** @return the join term rewritten to be evaluated on the tuples of one side of the join */
+auto RewriteForSide(const AbstractExpressionRef &expr) -> AbstractExpressionRef {
+  if (const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      column_value_expr != nullptr) {
+    return std::make_shared<ColumnValueExpression>(0, column_value_expr->GetColIdx(),
+                                                   column_value_expr->GetReturnType());
+  }
+  std::vector<AbstractExpressionRef> children;
+  for (const auto &child : expr->GetChildren()) {
+    children.emplace_back(RewriteForSide(child));
+  }
+  return expr->CloneWithChildren(children);
+}
+
+}  // namespace
+
+auto Optimizer::AddPredicate(const AbstractPlanNodeRef &plan, const AbstractExpressionRef &predicate)
+    -> AbstractPlanNodeRef {
+  if (plan->GetType() == PlanType::NestedLoopJoin) {
+    const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*plan);
+    if (nlj_plan.GetJoinType() == JoinType::INNER) {
+      auto join_predicate = RewriteExpressionForJoin(predicate, nlj_plan.GetLeftPlan()->OutputSchema().GetColumnCount(),
+                                                     nlj_plan.GetRightPlan()->OutputSchema().GetColumnCount());
+      if (!IsPredicateTrue(nlj_plan.Predicate())) {
+        join_predicate = std::make_shared<LogicExpression>(nlj_plan.Predicate(), join_predicate, LogicType::And);
+      }
+      return std::make_shared<NestedLoopJoinPlanNode>(nlj_plan.output_schema_, nlj_plan.GetLeftPlan(),
+                                                      nlj_plan.GetRightPlan(), join_predicate, JoinType::INNER);
+    }
+  }
+  if (plan->GetType() == PlanType::Filter) {
+    const auto &filter_plan = dynamic_cast<const FilterPlanNode &>(*plan);
+    return std::make_shared<FilterPlanNode>(
+        filter_plan.output_schema_,
+        std::make_shared<LogicExpression>(filter_plan.GetPredicate(), predicate, LogicType::And),
+        filter_plan.GetChildPlan());
+  }
+  return std::make_shared<FilterPlanNode>(plan->output_schema_, predicate, plan);
+}
+
+auto Optimizer::OptimizePushDownJoinPredicate(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  // Unlike the other rules, this one rewrites the plan top-down, so that the terms pushed into a child join are pushed
+  // further down when the child is rewritten in turn.
+  auto optimized_plan = plan;
+  if (plan->GetType() == PlanType::NestedLoopJoin) {
+    const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*plan);
+    BUSTUB_ENSURE(nlj_plan.children_.size() == 2, "NLJ should have exactly 2 children.");
+    // In a left join, the terms on the left side decide which left tuples are padded with nulls and cannot be pushed.
+    if (nlj_plan.GetJoinType() == JoinType::INNER) {
+      std::vector<AbstractExpressionRef> terms;
+      SplitConjunction(nlj_plan.Predicate(), &terms);
+      std::vector<AbstractExpressionRef> join_terms;
+      std::vector<AbstractExpressionRef> left_terms;
+      std::vector<AbstractExpressionRef> right_terms;
+      for (const auto &term : terms) {
+        switch (SidesOf(term)) {
+          case 1:
+            left_terms.push_back(RewriteForSide(term));
+            break;
+          case 2:
+            right_terms.push_back(RewriteForSide(term));
+            break;
+          default:
+            join_terms.push_back(term);
+        }
+      }
+      if (!left_terms.empty() || !right_terms.empty()) {
+        auto left = nlj_plan.GetLeftPlan();
+        auto right = nlj_plan.GetRightPlan();
+        if (!left_terms.empty()) {
+          left = AddPredicate(left, MakeConjunction(left_terms));
+        }
+        if (!right_terms.empty()) {
+          right = AddPredicate(right, MakeConjunction(right_terms));
+        }
+        optimized_plan = std::make_shared<NestedLoopJoinPlanNode>(nlj_plan.output_schema_, std::move(left),
+                                                                  std::move(right), MakeConjunction(join_terms),
+                                                                  JoinType::INNER);
+      }
+    }
+  }
+
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : optimized_plan->GetChildren()) {
+    children.emplace_back(OptimizePushDownJoinPredicate(child));
+  }
+  return optimized_plan->CloneWithChildren(std::move(children));
+}
+
+}  // namespace bustub
@@ -26,8 +26,14 @@ namespace bustub {
 
 auto Planner::PlanAggCall(const BoundAggCall &agg_call, const std::vector<AbstractPlanNodeRef> &children)
     -> std::tuple<AggregationType, std::vector<AbstractExpressionRef>> {
+  auto func_name = agg_call.func_name_;
   if (agg_call.is_distinct_) {
-    throw NotImplementedException("distinct agg is not implemented yet");
+    // MIN and MAX are the same over distinct values.
+    if (func_name == "count") {
+      func_name = "count_distinct";
+    } else if (func_name != "min" && func_name != "max") {
+      throw NotImplementedException(fmt::format("distinct {} is not implemented yet", func_name));
+    }
   }
 
   std::vector<AbstractExpressionRef> exprs;
@@ -41,7 +47,7 @@ auto Planner::PlanAggCall(const BoundAggCall &agg_call, const std::vector<Abstra
     }
   }
 
-  return GetAggCallFromFactory(agg_call.func_name_, std::move(exprs));
+  return GetAggCallFromFactory(func_name, std::move(exprs));
 }
 
 // TODO(chi): clang-tidy on macOS will suggest changing it to const reference. Looks like a bug.
@@ -104,6 +110,8 @@ auto Planner::PlanSelectAgg(const SelectStatement &statement, AbstractPlanNodeRe
   // Phase-1: plan an aggregation plan node out of all of the information we have.
   std::vector<AbstractExpressionRef> input_exprs;
   std::vector<AggregationType> agg_types;
+  std::vector<Value> agg_args;
+  bool has_agg_args = false;
   auto agg_begin_idx = group_by_exprs.size();  // agg-calls will be after group-bys in the output of agg.
 
   size_t term_idx = 0;
@@ -113,6 +121,20 @@ auto Planner::PlanSelectAgg(const SelectStatement &statement, AbstractPlanNodeRe
     }
     const auto &agg_call = dynamic_cast<const BoundAggCall &>(*item);
     auto [agg_type, exprs] = PlanAggCall(agg_call, {child});
+    if (agg_type == AggregationType::ApproxQuantileAggregate) {
+      // The quantile is a constant argument of the aggregate, not an input.
+      const auto *quantile_expr = dynamic_cast<const ConstantValueExpression *>(exprs[1].get());
+      if (quantile_expr == nullptr || quantile_expr->val_.IsNull() ||
+          quantile_expr->val_.CastAs(TypeId::DECIMAL).GetAs<double>() < 0 ||
+          quantile_expr->val_.CastAs(TypeId::DECIMAL).GetAs<double>() > 1) {
+        throw Exception("the quantile of approx_quantile must be a constant between 0 and 1");
+      }
+      agg_args.push_back(quantile_expr->val_);
+      has_agg_args = true;
+      exprs.pop_back();
+    } else {
+      agg_args.push_back(ValueFactory::GetNullValueByType(TypeId::INTEGER));
+    }
     if (exprs.size() > 1) {
       throw bustub::NotImplementedException("only agg call of zero/one arg is supported");
     }
@@ -125,18 +147,23 @@ auto Planner::PlanSelectAgg(const SelectStatement &statement, AbstractPlanNodeRe
 
     agg_types.push_back(agg_type);
     output_col_names.emplace_back(fmt::format("agg#{}", term_idx));
-    ctx_.expr_in_agg_.emplace_back(
-        std::make_unique<ColumnValueExpression>(0, agg_begin_idx + term_idx, TypeId::INTEGER));
 
     term_idx += 1;
   }
 
   auto agg_output_schema = AggregationPlanNode::InferAggSchema(group_by_exprs, input_exprs, agg_types);
+  for (size_t idx = 0; idx < agg_types.size(); idx++) {
+    ctx_.expr_in_agg_.emplace_back(std::make_unique<ColumnValueExpression>(
+        0, agg_begin_idx + idx, agg_output_schema.GetColumn(agg_begin_idx + idx).GetType()));
+  }
+  if (!has_agg_args) {
+    agg_args.clear();
+  }
 
   // Create the aggregation plan node for the first phase (finally!)
   AbstractPlanNodeRef plan = std::make_shared<AggregationPlanNode>(
       std::make_shared<Schema>(ProjectionPlanNode::RenameSchema(agg_output_schema, output_col_names)), std::move(child),
-      std::move(group_by_exprs), std::move(input_exprs), std::move(agg_types));
+      std::move(group_by_exprs), std::move(input_exprs), std::move(agg_types), std::move(agg_args));
 
   // Phase-2: plan filter / projection to match the original select list
 
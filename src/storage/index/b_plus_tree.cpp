@@ -26,7 +26,47 @@ BPLUSTREE_TYPE::BPlusTree(std::string name, page_id_t header_page_id, BufferPool
  * Helper function to decide whether current b+tree is empty
  */
 INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_TYPE::IsEmpty() const -> bool { return true; }
+auto BPLUSTREE_TYPE::IsEmpty() const -> bool {
+  ReadPageGuard guard = bpm_->FetchPageRead(header_page_id_);
+  return guard.As<BPlusTreeHeaderPage>()->root_page_id_ == INVALID_PAGE_ID;
+}
+
+/*
+ * Helper function to find the child of an internal page whose subtree holds the key: the last slot whose separator is
+ * not greater than the key, slot 0 having no separator
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::ChildIndex(const InternalPage *page, const KeyType &key) const -> int {
+  int lo = 1;
+  int hi = page->GetSize();
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    if (comparator_(page->KeyAt(mid), key) <= 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo - 1;
+}
+
+/*
+ * Helper function to find the first slot of a leaf page whose key is not less than the key
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::LeafLowerBound(const LeafPage *page, const KeyType &key) const -> int {
+  int lo = 0;
+  int hi = page->GetSize();
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    if (comparator_(page->KeyAt(mid), key) < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
@@ -37,10 +77,78 @@ auto BPLUSTREE_TYPE::IsEmpty() const -> bool { return true; }
  */
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *txn) -> bool {
-  // Declaration of context instance.
+  // Latch crabbing: the latch of a page is released as soon as its child is latched.
+  ReadPageGuard guard = bpm_->FetchPageRead(header_page_id_);
+  auto root_page_id = guard.As<BPlusTreeHeaderPage>()->root_page_id_;
+  if (root_page_id == INVALID_PAGE_ID) {
+    return false;
+  }
+  guard = bpm_->FetchPageRead(root_page_id);
+  while (!guard.As<BPlusTreePage>()->IsLeafPage()) {
+    const auto *internal = guard.As<InternalPage>();
+    guard = bpm_->FetchPageRead(internal->ValueAt(ChildIndex(internal, key)));
+  }
+  const auto *leaf = guard.As<LeafPage>();
+  auto idx = LeafLowerBound(leaf, key);
+  if (idx == leaf->GetSize() || comparator_(leaf->KeyAt(idx), key) != 0) {
+    return false;
+  }
+  result->push_back(leaf->ValueAt(idx));
+  return true;
+}
+
+/*
+ * Look up sorted keys along a single root-to-leaf path. path[i] is the i-th page from the root, and the page
+ * path[i + 1] is the child child_idx[i] of path[i]. Keys only grow, so a page on the path contains the next key as
+ * long as the key is below its upper bound: the separator that follows its child slot in its parent, or if it is the
+ * last child, the upper bound of its parent.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::GetValues(const std::vector<KeyType> &keys, std::vector<std::vector<ValueType>> *results,
+                               Transaction *txn) {
+  results->assign(keys.size(), {});
+  if (keys.empty()) {
+    return;
+  }
   Context ctx;
-  (void)ctx;
-  return false;
+  {
+    ReadPageGuard header_guard = bpm_->FetchPageRead(header_page_id_);
+    ctx.root_page_id_ = header_guard.As<BPlusTreeHeaderPage>()->root_page_id_;
+    if (ctx.root_page_id_ == INVALID_PAGE_ID) {
+      return;
+    }
+    ctx.read_set_.emplace_back(bpm_->FetchPageRead(ctx.root_page_id_));
+  }
+  std::vector<int> child_idx;
+
+  for (size_t i = 0; i < keys.size(); i++) {
+    const auto &key = keys[i];
+    // Climb to the lowest page on the path whose subtree contains the key. When the child is the last slot of its
+    // parent, its upper bound is a separator further up, so the climb goes on.
+    while (ctx.read_set_.size() > 1) {
+      auto level = ctx.read_set_.size() - 2;
+      const auto *parent = ctx.read_set_[level].template As<InternalPage>();
+      auto next_slot = child_idx[level] + 1;
+      if (next_slot < parent->GetSize() && comparator_(key, parent->KeyAt(next_slot)) < 0) {
+        break;
+      }
+      ctx.read_set_.pop_back();
+      child_idx.pop_back();
+    }
+
+    // Descend to the leaf of the key.
+    while (!ctx.read_set_.back().template As<BPlusTreePage>()->IsLeafPage()) {
+      const auto *internal = ctx.read_set_.back().template As<InternalPage>();
+      child_idx.push_back(ChildIndex(internal, key));
+      ctx.read_set_.emplace_back(bpm_->FetchPageRead(internal->ValueAt(child_idx.back())));
+    }
+
+    const auto *leaf = ctx.read_set_.back().template As<LeafPage>();
+    auto idx = LeafLowerBound(leaf, key);
+    if (idx < leaf->GetSize() && comparator_(leaf->KeyAt(idx), key) == 0) {
+      (*results)[i].push_back(leaf->ValueAt(idx));
+    }
+  }
 }
 
 /*****************************************************************************
@@ -55,10 +163,130 @@ auto BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result
  */
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *txn) -> bool {
-  // Declaration of context instance.
   Context ctx;
-  (void)ctx;
-  return false;
+  ctx.header_page_ = bpm_->FetchPageWrite(header_page_id_);
+  auto *header = ctx.header_page_->AsMut<BPlusTreeHeaderPage>();
+  if (header->root_page_id_ == INVALID_PAGE_ID) {
+    page_id_t root_page_id;
+    BasicPageGuard root_guard = bpm_->NewPageGuarded(&root_page_id);
+    auto *root = root_guard.AsMut<LeafPage>();
+    root->Init(leaf_max_size_);
+    root->SetAt(0, key, value);
+    root->SetSize(1);
+    header->root_page_id_ = root_page_id;
+    return true;
+  }
+  ctx.root_page_id_ = header->root_page_id_;
+
+  // Latch crabbing: the latches above a page are released once the page cannot split, i.e. when it has room for one
+  // more entry without reaching its max size (leaves) or exceeding it (internal pages).
+  ctx.write_set_.emplace_back(bpm_->FetchPageWrite(ctx.root_page_id_));
+  while (true) {
+    const auto *page = ctx.write_set_.back().template As<BPlusTreePage>();
+    bool safe = page->IsLeafPage() ? page->GetSize() + 1 < leaf_max_size_ : page->GetSize() < internal_max_size_;
+    if (safe) {
+      ctx.header_page_ = std::nullopt;
+      while (ctx.write_set_.size() > 1) {
+        ctx.write_set_.pop_front();
+      }
+    }
+    if (page->IsLeafPage()) {
+      break;
+    }
+    const auto *internal = ctx.write_set_.back().template As<InternalPage>();
+    ctx.write_set_.emplace_back(bpm_->FetchPageWrite(internal->ValueAt(ChildIndex(internal, key))));
+  }
+
+  auto leaf_page_id = ctx.write_set_.back().PageId();
+  auto *leaf = ctx.write_set_.back().template AsMut<LeafPage>();
+  auto idx = LeafLowerBound(leaf, key);
+  if (idx < leaf->GetSize() && comparator_(leaf->KeyAt(idx), key) == 0) {
+    return false;
+  }
+  for (int i = leaf->GetSize(); i > idx; i--) {
+    leaf->SetAt(i, leaf->KeyAt(i - 1), leaf->ValueAt(i - 1));
+  }
+  leaf->SetAt(idx, key, value);
+  leaf->IncreaseSize(1);
+  if (leaf->GetSize() < leaf_max_size_) {
+    return true;
+  }
+
+  // Split the full leaf, moving its upper half to a new right sibling.
+  page_id_t new_page_id;
+  BasicPageGuard new_guard = bpm_->NewPageGuarded(&new_page_id);
+  auto *new_leaf = new_guard.AsMut<LeafPage>();
+  new_leaf->Init(leaf_max_size_);
+  int split = leaf->GetSize() / 2;
+  for (int i = split; i < leaf->GetSize(); i++) {
+    new_leaf->SetAt(i - split, leaf->KeyAt(i), leaf->ValueAt(i));
+  }
+  new_leaf->SetSize(leaf->GetSize() - split);
+  leaf->SetSize(split);
+  new_leaf->SetNextPageId(leaf->GetNextPageId());
+  leaf->SetNextPageId(new_page_id);
+  InsertIntoParent(&ctx, leaf_page_id, new_leaf->KeyAt(0), new_page_id);
+  return true;
+}
+
+/*
+ * Insert the separator of a page that was just split into its parent, which is the page before it in the write set,
+ * splitting the parent in turn if it overflows. The split page is the last page of the write set.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::InsertIntoParent(Context *ctx, page_id_t left_page_id, const KeyType &key,
+                                      page_id_t right_page_id) {
+  ctx->write_set_.pop_back();
+  if (ctx->write_set_.empty()) {
+    // The root was split: grow the tree by one level.
+    page_id_t root_page_id;
+    BasicPageGuard root_guard = bpm_->NewPageGuarded(&root_page_id);
+    auto *root = root_guard.AsMut<InternalPage>();
+    root->Init(internal_max_size_);
+    root->SetValueAt(0, left_page_id);
+    root->SetKeyAt(1, key);
+    root->SetValueAt(1, right_page_id);
+    root->SetSize(2);
+    BUSTUB_ASSERT(ctx->header_page_.has_value(), "the header page must be latched to split the root");
+    ctx->header_page_->AsMut<BPlusTreeHeaderPage>()->root_page_id_ = root_page_id;
+    return;
+  }
+
+  auto parent_page_id = ctx->write_set_.back().PageId();
+  auto *parent = ctx->write_set_.back().template AsMut<InternalPage>();
+  // The entries with the new one, in a buffer since the page may have no room left for it.
+  std::vector<std::pair<KeyType, page_id_t>> entries;
+  entries.reserve(parent->GetSize() + 1);
+  for (int i = 0; i < parent->GetSize(); i++) {
+    entries.emplace_back(parent->KeyAt(i), parent->ValueAt(i));
+  }
+  entries.insert(entries.begin() + parent->ValueIndex(left_page_id) + 1, {key, right_page_id});
+  if (static_cast<int>(entries.size()) <= internal_max_size_) {
+    for (size_t i = 0; i < entries.size(); i++) {
+      parent->SetKeyAt(i, entries[i].first);
+      parent->SetValueAt(i, entries[i].second);
+    }
+    parent->SetSize(entries.size());
+    return;
+  }
+
+  // Split the parent. The first key of the new right page has no use in it and moves up as the separator.
+  page_id_t new_page_id;
+  BasicPageGuard new_guard = bpm_->NewPageGuarded(&new_page_id);
+  auto *new_internal = new_guard.AsMut<InternalPage>();
+  new_internal->Init(internal_max_size_);
+  int split = (entries.size() + 1) / 2;
+  for (int i = 0; i < split; i++) {
+    parent->SetKeyAt(i, entries[i].first);
+    parent->SetValueAt(i, entries[i].second);
+  }
+  parent->SetSize(split);
+  for (size_t i = split; i < entries.size(); i++) {
+    new_internal->SetKeyAt(i - split, entries[i].first);
+    new_internal->SetValueAt(i - split, entries[i].second);
+  }
+  new_internal->SetSize(entries.size() - split);
+  InsertIntoParent(ctx, parent_page_id, entries[split].first, new_page_id);
 }
 
 /*****************************************************************************
@@ -109,7 +337,10 @@ auto BPLUSTREE_TYPE::End() -> INDEXITERATOR_TYPE { return INDEXITERATOR_TYPE();
  * @return Page id of the root of this tree
  */
 INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_TYPE::GetRootPageId() -> page_id_t { return 0; }
+auto BPLUSTREE_TYPE::GetRootPageId() -> page_id_t {
+  ReadPageGuard guard = bpm_->FetchPageRead(header_page_id_);
+  return guard.As<BPlusTreeHeaderPage>()->root_page_id_;
+}
 
 /*****************************************************************************
  * UTILITIES AND DEBUG
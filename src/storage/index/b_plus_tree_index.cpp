@@ -11,6 +11,9 @@
 
 #include "storage/index/b_plus_tree_index.h"
 
+#include <algorithm>
+#include <numeric>
+
 namespace bustub {
 /*
  * Constructor
@@ -51,6 +54,35 @@ void BPLUSTREE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, T
   container_->GetValue(index_key, result, transaction);
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::ScanKeys(const std::vector<Tuple> &keys, std::vector<std::vector<RID>> *results,
+                                   Transaction *transaction) {
+  std::vector<KeyType> index_keys(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromKey(keys[i]);
+  }
+  // Sort the keys, and dedup them: outer tuples often share their join key.
+  std::vector<size_t> order(keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](size_t lhs, size_t rhs) { return comparator_(index_keys[lhs], index_keys[rhs]) < 0; });
+  std::vector<KeyType> sorted_keys;
+  std::vector<size_t> sorted_idx(keys.size());
+  for (auto idx : order) {
+    if (sorted_keys.empty() || comparator_(sorted_keys.back(), index_keys[idx]) != 0) {
+      sorted_keys.push_back(index_keys[idx]);
+    }
+    sorted_idx[idx] = sorted_keys.size() - 1;
+  }
+
+  std::vector<std::vector<RID>> sorted_results;
+  container_->GetValues(sorted_keys, &sorted_results, transaction);
+  results->resize(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    (*results)[i] = sorted_results[sorted_idx[i]];
+  }
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_INDEX_TYPE::GetBeginIterator() -> INDEXITERATOR_TYPE { return container_->Begin(); }
 
@@ -0,0 +1,54 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map_page.cpp
+//
+// Identification: src/storage/page/free_space_map_page.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/free_space_map_page.h"
+
+#include "common/macros.h"
+
+namespace bustub {
+
+void FreeSpaceMapPage::Init() {
+  next_page_id_ = INVALID_PAGE_ID;
+  num_entries_ = 0;
+}
+
+auto FreeSpaceMapPage::AddEntry(page_id_t page_id, size_t free_space) -> uint32_t {
+  BUSTUB_ASSERT(!IsFull(), "free space map page is full");
+  page_ids_[num_entries_] = page_id;
+  levels_[num_entries_] = ToLevel(free_space);
+  return num_entries_++;
+}
+
+auto FreeSpaceMapPage::FindEntry(size_t size, size_t start) const -> std::optional<uint32_t> {
+  if (num_entries_ == 0) {
+    return std::nullopt;
+  }
+  // The smallest level that guarantees `size` bytes, as levels are rounded down.
+  auto min_level = (size + FREE_SPACE_UNIT - 1) / FREE_SPACE_UNIT;
+  if (min_level > UINT8_MAX) {
+    return std::nullopt;
+  }
+  auto first = static_cast<uint32_t>(start % num_entries_);
+  for (uint32_t idx = first; idx < num_entries_; idx++) {
+    if (levels_[idx] >= min_level) {
+      return idx;
+    }
+  }
+  for (uint32_t idx = 0; idx < first; idx++) {
+    if (levels_[idx] >= min_level) {
+      return idx;
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace bustub
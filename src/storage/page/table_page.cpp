@@ -12,10 +12,13 @@
 
 #include "storage/page/table_page.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <optional>
 #include <tuple>
+#include <vector>
+
 #include "common/config.h"
 #include "common/exception.h"
 #include "storage/table/tuple.h"
@@ -26,44 +29,114 @@ void TablePage::Init() {
   next_page_id_ = INVALID_PAGE_ID;
   num_tuples_ = 0;
   num_deleted_tuples_ = 0;
+  tuple_start_ = BUSTUB_PAGE_SIZE;
+  num_free_slots_ = 0;
 }
 
 auto TablePage::GetNextTupleOffset(const TupleMeta &meta, const Tuple &tuple) const -> std::optional<uint16_t> {
-  size_t slot_end_offset;
-  if (num_tuples_ > 0) {
-    auto &[offset, size, meta] = tuple_info_[num_tuples_ - 1];
-    slot_end_offset = offset;
-  } else {
-    slot_end_offset = BUSTUB_PAGE_SIZE;
-  }
-  auto tuple_offset = slot_end_offset - tuple.GetLength();
-  auto offset_size = TABLE_PAGE_HEADER_SIZE + TUPLE_INFO_SIZE * (num_tuples_ + 1);
-  if (tuple_offset < offset_size) {
+  // A new slot takes room from the free space as well, a freed one does not.
+  auto slot_size = num_free_slots_ > 0 ? 0 : TUPLE_INFO_SIZE;
+  if (tuple.GetLength() + slot_size > GetFreeSpace()) {
     return std::nullopt;
   }
-  return tuple_offset;
+  return tuple_start_ - tuple.GetLength();
 }
 
 auto TablePage::InsertTuple(const TupleMeta &meta, const Tuple &tuple) -> std::optional<uint16_t> {
   auto tuple_offset = GetNextTupleOffset(meta, tuple);
+  if (tuple_offset == std::nullopt && Compact() > 0) {
+    tuple_offset = GetNextTupleOffset(meta, tuple);
+  }
   if (tuple_offset == std::nullopt) {
     return std::nullopt;
   }
-  auto tuple_id = num_tuples_;
+  uint16_t tuple_id = num_tuples_;
+  if (num_free_slots_ > 0) {
+    // Reuse the first freed slot.
+    tuple_id = 0;
+    while (std::get<0>(tuple_info_[tuple_id]) != 0) {
+      tuple_id++;
+    }
+    num_free_slots_--;
+    num_deleted_tuples_--;
+  } else {
+    num_tuples_++;
+  }
   tuple_info_[tuple_id] = std::make_tuple(*tuple_offset, tuple.GetLength(), meta);
-  num_tuples_++;
+  if (meta.is_deleted_) {
+    num_deleted_tuples_++;
+  }
+  tuple_start_ = *tuple_offset;
   memcpy(page_start_ + *tuple_offset, tuple.data_.data(), tuple.GetLength());
   return tuple_id;
 }
 
+auto TablePage::GetInsertableSpace() const -> size_t {
+  size_t space = GetFreeSpace();
+  bool has_free_slot = num_free_slots_ > 0;
+  for (uint16_t tuple_id = 0; tuple_id < num_tuples_; tuple_id++) {
+    auto &[offset, size, meta] = tuple_info_[tuple_id];
+    if (offset != 0 && IsReclaimable(meta)) {
+      space += size;
+      has_free_slot = true;
+    }
+  }
+  // Without a slot to reuse, an insert takes room for a new one as well.
+  if (!has_free_slot) {
+    space = space > TUPLE_INFO_SIZE ? space - TUPLE_INFO_SIZE : 0;
+  }
+  return space;
+}
+
+auto TablePage::Compact() -> size_t {
+  // Free the slots of the reclaimable tuples, and collect the others by decreasing offset.
+  std::vector<uint16_t> slots;
+  slots.reserve(num_tuples_);
+  for (uint16_t tuple_id = 0; tuple_id < num_tuples_; tuple_id++) {
+    auto &[offset, size, meta] = tuple_info_[tuple_id];
+    if (offset == 0) {
+      continue;
+    }
+    if (IsReclaimable(meta)) {
+      offset = 0;
+      size = 0;
+      num_free_slots_++;
+    } else {
+      slots.push_back(tuple_id);
+    }
+  }
+  std::sort(slots.begin(), slots.end(),
+            [this](uint16_t a, uint16_t b) { return std::get<0>(tuple_info_[a]) > std::get<0>(tuple_info_[b]); });
+
+  // Slide the tuples towards the end of the page. Every tuple moves to an offset no lower than its own, after the
+  // tuples that were above it have moved, so it never overwrites a tuple that has not moved yet.
+  size_t end = BUSTUB_PAGE_SIZE;
+  for (auto tuple_id : slots) {
+    auto &[offset, size, meta] = tuple_info_[tuple_id];
+    end -= size;
+    if (end != offset) {
+      memmove(page_start_ + end, page_start_ + offset, size);
+      offset = end;
+    }
+  }
+  auto reclaimed = end - tuple_start_;
+  tuple_start_ = end;
+  return reclaimed;
+}
+
 void TablePage::UpdateTupleMeta(const TupleMeta &meta, const RID &rid) {
   auto tuple_id = rid.GetSlotNum();
   if (tuple_id >= num_tuples_) {
     throw bustub::Exception("Tuple ID out of range");
   }
   auto &[offset, size, old_meta] = tuple_info_[tuple_id];
+  if (offset == 0) {
+    throw bustub::Exception("Tuple slot is free");
+  }
   if (!old_meta.is_deleted_ && meta.is_deleted_) {
     num_deleted_tuples_++;
+  } else if (old_meta.is_deleted_ && !meta.is_deleted_) {
+    num_deleted_tuples_--;
   }
   tuple_info_[tuple_id] = std::make_tuple(offset, size, meta);
 }
@@ -74,11 +147,16 @@ auto TablePage::GetTuple(const RID &rid) const -> std::pair<TupleMeta, Tuple> {
     throw bustub::Exception("Tuple ID out of range");
   }
   auto &[offset, size, meta] = tuple_info_[tuple_id];
-  Tuple tuple;
-  tuple.data_.resize(size);
-  memmove(tuple.data_.data(), page_start_ + offset, size);
-  tuple.rid_ = rid;
-  return std::make_pair(meta, std::move(tuple));
+  return std::make_pair(meta, TupleRef(page_start_ + offset, size, rid).ToTuple());
+}
+
+auto TablePage::GetTupleRef(const RID &rid) const -> std::pair<TupleMeta, TupleRef> {
+  auto tuple_id = rid.GetSlotNum();
+  if (tuple_id >= num_tuples_) {
+    throw bustub::Exception("Tuple ID out of range");
+  }
+  auto &[offset, size, meta] = tuple_info_[tuple_id];
+  return std::make_pair(meta, TupleRef(page_start_ + offset, size, rid));
 }
 
 auto TablePage::GetTupleMeta(const RID &rid) const -> TupleMeta {
@@ -101,6 +179,8 @@ void TablePage::UpdateTupleInPlaceUnsafe(const TupleMeta &meta, const Tuple &tup
   }
   if (!old_meta.is_deleted_ && meta.is_deleted_) {
     num_deleted_tuples_++;
+  } else if (old_meta.is_deleted_ && !meta.is_deleted_) {
+    num_deleted_tuples_--;
   }
   tuple_info_[tuple_id] = std::make_tuple(offset, size, meta);
   memcpy(page_start_ + offset, tuple.data_.data(), tuple.GetLength());
@@ -0,0 +1,233 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// data_chunk.cpp
+//
+// Identification: src/storage/table/data_chunk.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "common/exception.h"
+#include "storage/page/table_page.h"
+#include "storage/table/data_chunk.h"
+#include "type/limits.h"
+#include "type/type.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+ColumnVector::ColumnVector(TypeId type, size_t capacity)
+    : type_(type),
+      width_(type == TypeId::VARCHAR ? sizeof(StringEntry) : Type::GetTypeSize(type)),
+      data_((capacity * width_ + sizeof(uint64_t) - 1) / sizeof(uint64_t)),
+      null_mask_((capacity + 63) / 64) {}
+
+void ColumnVector::SetNull(size_t row, bool is_null) {
+  if (is_null) {
+    null_mask_[row / 64] |= (1ULL << (row % 64));
+    has_null_ = true;
+  } else {
+    null_mask_[row / 64] &= ~(1ULL << (row % 64));
+  }
+}
+
+void ColumnVector::MarkNulls(const uint64_t *mask, size_t num_rows) {
+  uint64_t any = 0;
+  for (size_t word = 0; word < (num_rows + 63) / 64; word++) {
+    null_mask_[word] |= mask[word];
+    any |= mask[word];
+  }
+  has_null_ = has_null_ || any != 0;
+}
+
+auto ColumnVector::GetString(size_t row) const -> std::string_view {
+  BUSTUB_ASSERT(type_ == TypeId::VARCHAR, "not a varchar column");
+  const auto &entry = GetData<StringEntry>()[row];
+  auto len = entry.len_;
+  // Strings built from std::string carry their terminating zero byte.
+  if (len > 0 && string_heap_[entry.offset_ + len - 1] == '\0') {
+    len--;
+  }
+  return {string_heap_.data() + entry.offset_, len};
+}
+
+void ColumnVector::SetRawString(size_t row, const char *data, uint32_t len) {
+  auto offset = static_cast<uint32_t>(string_heap_.size());
+  string_heap_.insert(string_heap_.end(), data, data + len);
+  GetData<StringEntry>()[row] = StringEntry{offset, len};
+}
+
+void ColumnVector::SetFromStorage(size_t row, const char *storage) {
+  bool is_null = false;
+  switch (type_) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT: {
+      auto v = *reinterpret_cast<const int8_t *>(storage);
+      GetData<int8_t>()[row] = v;
+      is_null = (v == BUSTUB_INT8_NULL);
+      break;
+    }
+    case TypeId::SMALLINT: {
+      auto v = *reinterpret_cast<const int16_t *>(storage);
+      GetData<int16_t>()[row] = v;
+      is_null = (v == BUSTUB_INT16_NULL);
+      break;
+    }
+    case TypeId::INTEGER: {
+      auto v = *reinterpret_cast<const int32_t *>(storage);
+      GetData<int32_t>()[row] = v;
+      is_null = (v == BUSTUB_INT32_NULL);
+      break;
+    }
+    case TypeId::BIGINT: {
+      auto v = *reinterpret_cast<const int64_t *>(storage);
+      GetData<int64_t>()[row] = v;
+      is_null = (v == BUSTUB_INT64_NULL);
+      break;
+    }
+    case TypeId::DECIMAL: {
+      auto v = *reinterpret_cast<const double *>(storage);
+      GetData<double>()[row] = v;
+      is_null = (v == BUSTUB_DECIMAL_NULL);
+      break;
+    }
+    case TypeId::TIMESTAMP: {
+      auto v = *reinterpret_cast<const uint64_t *>(storage);
+      GetData<uint64_t>()[row] = v;
+      is_null = (v == BUSTUB_TIMESTAMP_NULL);
+      break;
+    }
+    case TypeId::VARCHAR: {
+      auto len = *reinterpret_cast<const uint32_t *>(storage);
+      is_null = (len == BUSTUB_VALUE_NULL);
+      if (is_null) {
+        GetData<StringEntry>()[row] = StringEntry{0, 0};
+      } else {
+        SetRawString(row, storage + sizeof(uint32_t), len);
+      }
+      break;
+    }
+    default:
+      throw Exception(ExceptionType::UNKNOWN_TYPE, "Unsupported column type in data chunk.");
+  }
+  SetNull(row, is_null);
+}
+
+void ColumnVector::SetValue(size_t row, const Value &value) {
+  if (type_ == TypeId::VARCHAR) {
+    if (value.IsNull()) {
+      GetData<StringEntry>()[row] = StringEntry{0, 0};
+    } else {
+      SetRawString(row, value.GetData(), value.GetLength());
+    }
+    SetNull(row, value.IsNull());
+    return;
+  }
+  // Fixed-size values serialize to exactly their width, null sentinels included.
+  value.SerializeTo(reinterpret_cast<char *>(data_.data()) + row * width_);
+  SetNull(row, value.IsNull());
+}
+
+auto ColumnVector::GetValue(size_t row) const -> Value {
+  if (IsNull(row)) {
+    return ValueFactory::GetNullValueByType(type_);
+  }
+  switch (type_) {
+    case TypeId::BOOLEAN:
+      return ValueFactory::GetBooleanValue(static_cast<int8_t>(GetData<int8_t>()[row]));
+    case TypeId::TINYINT:
+      return ValueFactory::GetTinyIntValue(GetData<int8_t>()[row]);
+    case TypeId::SMALLINT:
+      return ValueFactory::GetSmallIntValue(GetData<int16_t>()[row]);
+    case TypeId::INTEGER:
+      return ValueFactory::GetIntegerValue(GetData<int32_t>()[row]);
+    case TypeId::BIGINT:
+      return ValueFactory::GetBigIntValue(GetData<int64_t>()[row]);
+    case TypeId::DECIMAL:
+      return ValueFactory::GetDecimalValue(GetData<double>()[row]);
+    case TypeId::TIMESTAMP:
+      return ValueFactory::GetTimestampValue(static_cast<int64_t>(GetData<uint64_t>()[row]));
+    case TypeId::VARCHAR: {
+      const auto &entry = GetData<StringEntry>()[row];
+      return ValueFactory::GetVarcharValue(string_heap_.data() + entry.offset_, entry.len_, true);
+    }
+    default:
+      throw Exception(ExceptionType::UNKNOWN_TYPE, "Unsupported column type in data chunk.");
+  }
+}
+
+void ColumnVector::Reset() {
+  std::fill(null_mask_.begin(), null_mask_.end(), 0);
+  has_null_ = false;
+  string_heap_.clear();
+}
+
+DataChunk::DataChunk(const Schema *schema, size_t capacity) : schema_(schema), capacity_(capacity) {
+  columns_.reserve(schema_->GetColumnCount());
+  for (const auto &col : schema_->GetColumns()) {
+    columns_.emplace_back(col.GetType(), capacity_);
+  }
+  rids_.resize(capacity_);
+}
+
+void DataChunk::Reset() {
+  for (auto &col : columns_) {
+    col.Reset();
+  }
+  size_ = 0;
+  ClearSelection();
+}
+
+void DataChunk::AppendTupleData(const char *data) {
+  BUSTUB_ASSERT(!IsFull(), "append to a full data chunk");
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    const auto &col = schema_->GetColumn(i);
+    const char *storage = data + col.GetOffset();
+    if (!col.IsInlined()) {
+      // Non-inlined columns store the offset of their payload within the tuple.
+      storage = data + *reinterpret_cast<const uint32_t *>(storage);
+    }
+    columns_[i].SetFromStorage(size_, storage);
+  }
+  rids_[size_] = RID{};
+  size_++;
+}
+
+auto DataChunk::AppendTablePage(const TablePage &page, page_id_t page_id, uint32_t start_slot) -> uint32_t {
+  auto slot = start_slot;
+  while (!IsFull() && slot < page.GetNumTuples()) {
+    RID rid{page_id, slot};
+    auto [meta, tuple] = page.GetTupleRef(rid);
+    if (!meta.is_deleted_) {
+      AppendTupleData(tuple.GetData());
+      rids_[size_ - 1] = rid;
+    }
+    slot++;
+  }
+  return slot;
+}
+
+auto DataChunk::GetTuple(size_t row) const -> Tuple {
+  std::vector<Value> values;
+  values.reserve(columns_.size());
+  for (const auto &col : columns_) {
+    values.emplace_back(col.GetValue(row));
+  }
+  return {std::move(values), schema_};
+}
+
+void DataChunk::SetSelection(std::vector<uint32_t> selection) {
+  BUSTUB_ASSERT(selection.size() <= size_, "selection larger than the chunk");
+  selection_ = std::move(selection);
+  has_selection_ = true;
+}
+
+}  // namespace bustub
@@ -0,0 +1,123 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// spill_file.cpp
+//
+// Identification: src/storage/table/spill_file.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/spill_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "common/exception.h"
+#include "storage/page/tmp_tuple_page.h"
+#include "storage/table/tmp_tuple.h"
+
+namespace bustub {
+
+SpillFile::~SpillFile() {
+  Finish();
+  for (const auto &page : pages_) {
+    bpm_->DeletePage(page.page_id_);
+  }
+}
+
+auto SpillFile::NewPage(uint32_t large_record_size) -> BasicPageGuard {
+  page_id_t page_id = INVALID_PAGE_ID;
+  auto page_guard = bpm_->NewPageGuarded(&page_id);
+  if (page_id == INVALID_PAGE_ID) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "no free frame in the buffer pool to spill to");
+  }
+  pages_.push_back(FilePage{page_id, large_record_size});
+  return page_guard;
+}
+
+void SpillFile::Append(const Tuple &tuple) {
+  if (sizeof(uint32_t) + tuple.GetLength() + TmpTuplePage::SIZE_TMP_TUPLE_PAGE_HEADER > BUSTUB_PAGE_SIZE) {
+    AppendLarge(tuple);
+  } else {
+    TmpTuple location{INVALID_PAGE_ID, 0};
+    if (write_page_id_ == INVALID_PAGE_ID || !write_guard_.AsMut<TmpTuplePage>()->Insert(tuple, &location)) {
+      Finish();
+      write_guard_ = NewPage(0);
+      write_page_id_ = pages_.back().page_id_;
+      auto *tmp_page = write_guard_.AsMut<TmpTuplePage>();
+      tmp_page->Init(write_page_id_, BUSTUB_PAGE_SIZE);
+      tmp_page->Insert(tuple, &location);
+    }
+  }
+  num_tuples_++;
+  data_size_ += tuple.GetLength();
+}
+
+void SpillFile::AppendLarge(const Tuple &tuple) {
+  // The tuples appended after this one go to a new page, so that the file stays in append order.
+  Finish();
+  auto record_size = sizeof(uint32_t) + tuple.GetLength();
+  if (record_size > UINT32_MAX) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "tuple is too large to be spilled");
+  }
+  std::vector<char> record(record_size);
+  tuple.SerializeTo(record.data());
+  for (size_t offset = 0; offset < record_size; offset += BUSTUB_PAGE_SIZE) {
+    auto page_guard = NewPage(offset == 0 ? static_cast<uint32_t>(record_size) : 0);
+    memcpy(page_guard.GetDataMut(), record.data() + offset, std::min<size_t>(BUSTUB_PAGE_SIZE, record_size - offset));
+  }
+}
+
+void SpillFile::Finish() {
+  if (write_page_id_ != INVALID_PAGE_ID) {
+    write_guard_.Drop();
+    write_page_id_ = INVALID_PAGE_ID;
+  }
+}
+
+auto SpillFile::Reader::Next(Tuple *tuple) -> bool {
+  while (buffer_idx_ == buffer_.size()) {
+    if (page_idx_ == file_->pages_.size()) {
+      return false;
+    }
+    const auto &page = file_->pages_[page_idx_];
+    if (page.large_record_size_ > 0) {
+      LoadLargeTuple(page.large_record_size_);
+    } else {
+      LoadPage(page.page_id_);
+      page_idx_++;
+    }
+  }
+  *tuple = std::move(buffer_[buffer_idx_++]);
+  return true;
+}
+
+void SpillFile::Reader::LoadPage(page_id_t page_id) {
+  auto page_guard = file_->bpm_->FetchPageRead(page_id);
+  const auto *tmp_page = page_guard.As<TmpTuplePage>();
+  // Records are stored newest first, walk them and reverse to get the append order back.
+  buffer_.clear();
+  buffer_idx_ = 0;
+  size_t offset = tmp_page->GetFreeSpaceOffset();
+  while (offset < BUSTUB_PAGE_SIZE) {
+    offset = tmp_page->Get(offset, &buffer_.emplace_back());
+  }
+  std::reverse(buffer_.begin(), buffer_.end());
+}
+
+void SpillFile::Reader::LoadLargeTuple(uint32_t record_size) {
+  std::vector<char> record(record_size);
+  for (size_t offset = 0; offset < record_size; offset += BUSTUB_PAGE_SIZE) {
+    auto page_guard = file_->bpm_->FetchPageRead(file_->pages_[page_idx_++].page_id_);
+    memcpy(record.data() + offset, page_guard.GetData(), std::min<size_t>(BUSTUB_PAGE_SIZE, record_size - offset));
+  }
+  buffer_.clear();
+  buffer_idx_ = 0;
+  buffer_.emplace_back().DeserializeFrom(record.data());
+}
+
+}  // namespace bustub
@@ -11,7 +11,11 @@
 //===----------------------------------------------------------------------===//
 
 #include <cassert>
+#include <cstring>
+#include <functional>
 #include <mutex>  // NOLINT
+#include <shared_mutex>
+#include <thread>  // NOLINT
 #include <utility>
 
 #include "common/config.h"
@@ -20,6 +24,7 @@
 #include "common/macros.h"
 #include "concurrency/transaction.h"
 #include "fmt/format.h"
+#include "storage/page/free_space_map_page.h"
 #include "storage/page/page_guard.h"
 #include "storage/page/table_page.h"
 #include "storage/table/table_heap.h"
@@ -30,63 +35,199 @@ TableHeap::TableHeap(BufferPoolManager *bpm) : bpm_(bpm) {
   // Initialize the first table page.
   auto guard = bpm->NewPageGuarded(&first_page_id_);
   last_page_id_ = first_page_id_;
+  for (auto &insert_page_id : insert_page_ids_) {
+    insert_page_id = INVALID_PAGE_ID;
+  }
   auto first_page = guard.AsMut<TablePage>();
   BUSTUB_ASSERT(first_page != nullptr,
                 "Couldn't create a page for the table heap. Have you completed the buffer pool manager project?");
   first_page->Init();
+
+  auto fsm_guard = bpm->NewPageGuarded(&first_fsm_page_id_);
+  last_fsm_page_id_ = first_fsm_page_id_;
+  fsm_guard.AsMut<FreeSpaceMapPage>()->Init();
+  fsm_guard.Drop();
+  AddToFreeSpaceMap(first_page_id_, first_page->GetInsertableSpace());
 }
 
 auto TableHeap::InsertTuple(const TupleMeta &meta, const Tuple &tuple, LockManager *lock_mgr, Transaction *txn,
                             table_oid_t oid) -> std::optional<RID> {
-  std::unique_lock<std::mutex> guard(latch_);
-  auto page_guard = bpm_->FetchPageWrite(last_page_id_);
-  while (true) {
+  auto &insert_page_id = insert_page_ids_[std::hash<std::thread::id>{}(std::this_thread::get_id()) % NUM_INSERT_LANES];
+  WritePageGuard page_guard;
+  std::optional<uint16_t> slot_id;
+
+  // Append to the page of the lane. The page is claimed: its entry in the free space map is only set once it is full.
+  if (auto page_id = insert_page_id.load(); page_id != INVALID_PAGE_ID) {
+    page_guard = bpm_->FetchPageWrite(page_id);
     auto page = page_guard.AsMut<TablePage>();
-    if (page->GetNextTupleOffset(meta, tuple) != std::nullopt) {
-      break;
+    slot_id = page->InsertTuple(meta, tuple);
+    if (!slot_id.has_value()) {
+      UpdateFreeSpace(page_id, page->GetInsertableSpace());
+      page_guard.Drop();
     }
+  }
 
-    // if there's no tuple in the page, and we can't insert the tuple, then this tuple is too large.
-    BUSTUB_ENSURE(page->GetNumTuples() != 0, "tuple is too large, cannot insert");
-
-    page_id_t next_page_id = INVALID_PAGE_ID;
-    auto npg = bpm_->NewPage(&next_page_id);
-    BUSTUB_ENSURE(next_page_id != INVALID_PAGE_ID, "cannot allocate page");
-
-    // Don't do lock crabbing here: TSAN reports, also as last_page_id_ is only updated
-    // later, this page won't be accessed.
-    page->SetNextPageId(next_page_id);
-    page_guard.Drop();
+  // Claim a page the free space map says has room. An entry may be stale: it is corrected, and the search goes on.
+  while (!slot_id.has_value()) {
+    auto page_id = ClaimPageWithSpace(tuple.GetLength());
+    if (!page_id.has_value()) {
+      break;
+    }
+    page_guard = bpm_->FetchPageWrite(*page_id);
+    auto page = page_guard.AsMut<TablePage>();
+    slot_id = page->InsertTuple(meta, tuple);
+    if (slot_id.has_value()) {
+      insert_page_id = *page_id;
+    } else {
+      UpdateFreeSpace(*page_id, page->GetInsertableSpace());
+      page_guard.Drop();
+    }
+  }
 
+  if (!slot_id.has_value()) {
+    // No page has room: claim a new one, and link it to the table. Nobody else can see it until it is linked.
+    page_id_t page_id = INVALID_PAGE_ID;
+    auto npg = bpm_->NewPage(&page_id);
+    BUSTUB_ENSURE(page_id != INVALID_PAGE_ID, "cannot allocate page");
     npg->WLatch();
-    auto next_page_guard = WritePageGuard{bpm_, npg};
-    auto next_page = next_page_guard.AsMut<TablePage>();
-    next_page->Init();
-
-    last_page_id_ = next_page_id;
-    page_guard = std::move(next_page_guard);
+    page_guard = WritePageGuard{bpm_, npg};
+    auto page = page_guard.AsMut<TablePage>();
+    page->Init();
+    slot_id = page->InsertTuple(meta, tuple);
+    BUSTUB_ENSURE(slot_id.has_value(), "tuple is too large, cannot insert");
+    AddToFreeSpaceMap(page_id, 0);
+    LinkPages(page_id, page_id);
+    insert_page_id = page_id;
   }
-  auto last_page_id = last_page_id_;
-
-  auto page = page_guard.AsMut<TablePage>();
-  auto slot_id = *page->InsertTuple(meta, tuple);
-
-  // only allow one insertion at a time, otherwise it will deadlock.
-  guard.unlock();
+  auto page_id = page_guard.PageId();
 
   if (lock_mgr != nullptr) {
-    lock_mgr->LockRow(txn, LockManager::LockMode::EXCLUSIVE, oid, RID{last_page_id, slot_id});
+    lock_mgr->LockRow(txn, LockManager::LockMode::EXCLUSIVE, oid, RID{page_id, *slot_id});
   }
 
   page_guard.Drop();
 
-  return RID(last_page_id, slot_id);
+  return RID(page_id, *slot_id);
+}
+
+auto TableHeap::AppendPages(const std::vector<std::unique_ptr<char[]>> &pages) -> std::vector<page_id_t> {
+  std::vector<page_id_t> page_ids;
+  page_ids.reserve(pages.size());
+  // Write the pages as a chain of their own, holding at most two of them. Each page is entered in the free space map
+  // with the room it has left while it is latched: an insert may claim it before it is linked to the table, which only
+  // delays when scans see that tuple.
+  WritePageGuard prev_guard;
+  for (const auto &image : pages) {
+    page_id_t page_id = INVALID_PAGE_ID;
+    auto npg = bpm_->NewPage(&page_id);
+    BUSTUB_ENSURE(page_id != INVALID_PAGE_ID, "cannot allocate page");
+    npg->WLatch();
+    WritePageGuard guard{bpm_, npg};
+    memcpy(guard.GetDataMut(), image.get(), BUSTUB_PAGE_SIZE);
+    auto page = guard.AsMut<TablePage>();
+    page->SetNextPageId(INVALID_PAGE_ID);
+    AddToFreeSpaceMap(page_id, page->GetInsertableSpace());
+    if (!page_ids.empty()) {
+      prev_guard.AsMut<TablePage>()->SetNextPageId(page_id);
+    }
+    prev_guard = std::move(guard);
+    page_ids.push_back(page_id);
+  }
+  prev_guard.Drop();
+  if (!page_ids.empty()) {
+    LinkPages(page_ids.front(), page_ids.back());
+  }
+  return page_ids;
+}
+
+void TableHeap::LinkPages(page_id_t first_page_id, page_id_t last_page_id) {
+  // Another thread may be appending pages as well: the first one to link its pages wins, and the others then help
+  // move last_page_id_ forward, one page at a time, before trying again after the new last page.
+  while (true) {
+    auto tail_page_id = last_page_id_.load();
+    auto tail_guard = bpm_->FetchPageWrite(tail_page_id);
+    auto tail_page = tail_guard.AsMut<TablePage>();
+    auto next_page_id = tail_page->GetNextPageId();
+    if (next_page_id == INVALID_PAGE_ID) {
+      tail_page->SetNextPageId(first_page_id);
+      tail_guard.Drop();
+      if (last_page_id_.compare_exchange_strong(tail_page_id, last_page_id)) {
+        return;
+      }
+      break;
+    }
+    tail_guard.Drop();
+    last_page_id_.compare_exchange_strong(tail_page_id, next_page_id);
+  }
+  // A helper moved last_page_id_ into the chain before the compare-and-swap: walk it to the end of the table, so that
+  // iterators made after this call see every new page.
+  while (true) {
+    auto tail_page_id = last_page_id_.load();
+    auto tail_guard = bpm_->FetchPageRead(tail_page_id);
+    auto next_page_id = tail_guard.As<TablePage>()->GetNextPageId();
+    tail_guard.Drop();
+    if (next_page_id == INVALID_PAGE_ID) {
+      return;
+    }
+    last_page_id_.compare_exchange_strong(tail_page_id, next_page_id);
+  }
 }
 
 void TableHeap::UpdateTupleMeta(const TupleMeta &meta, RID rid) {
   auto page_guard = bpm_->FetchPageWrite(rid.GetPageId());
   auto page = page_guard.AsMut<TablePage>();
   page->UpdateTupleMeta(meta, rid);
+  if (TablePage::IsReclaimable(meta)) {
+    UpdateFreeSpace(rid.GetPageId(), page->GetInsertableSpace());
+  }
+}
+
+auto TableHeap::ClaimPageWithSpace(size_t size) -> std::optional<page_id_t> {
+  // Threads start looking from different entries of every map page.
+  auto start = std::hash<std::thread::id>{}(std::this_thread::get_id());
+  auto fsm_page_id = first_fsm_page_id_;
+  while (fsm_page_id != INVALID_PAGE_ID) {
+    auto fsm_guard = bpm_->FetchPageWrite(fsm_page_id);
+    auto fsm_page = fsm_guard.AsMut<FreeSpaceMapPage>();
+    if (auto idx = fsm_page->FindEntry(size, start)) {
+      fsm_page->SetFreeSpace(*idx, 0);
+      return fsm_page->GetPageId(*idx);
+    }
+    fsm_page_id = fsm_page->GetNextPageId();
+  }
+  return std::nullopt;
+}
+
+void TableHeap::UpdateFreeSpace(page_id_t page_id, size_t free_space) {
+  std::pair<page_id_t, uint32_t> entry;
+  {
+    std::shared_lock guard(fsm_latch_);
+    entry = fsm_entries_.at(page_id);
+  }
+  // Map pages are latched after table pages, and fsm_latch_ is never held while latching a page.
+  auto fsm_guard = bpm_->FetchPageWrite(entry.first);
+  fsm_guard.AsMut<FreeSpaceMapPage>()->SetFreeSpace(entry.second, free_space);
+}
+
+void TableHeap::AddToFreeSpaceMap(page_id_t page_id, size_t free_space) {
+  std::scoped_lock latch(latch_);
+  auto fsm_guard = bpm_->FetchPageWrite(last_fsm_page_id_);
+  auto fsm_page = fsm_guard.AsMut<FreeSpaceMapPage>();
+  if (fsm_page->IsFull()) {
+    page_id_t next_fsm_page_id = INVALID_PAGE_ID;
+    auto next_fsm_guard = bpm_->NewPageGuarded(&next_fsm_page_id);
+    BUSTUB_ENSURE(next_fsm_page_id != INVALID_PAGE_ID, "cannot allocate page");
+    next_fsm_guard.AsMut<FreeSpaceMapPage>()->Init();
+    fsm_page->SetNextPageId(next_fsm_page_id);
+    fsm_guard.Drop();
+    next_fsm_guard.Drop();
+    last_fsm_page_id_ = next_fsm_page_id;
+    fsm_guard = bpm_->FetchPageWrite(next_fsm_page_id);
+    fsm_page = fsm_guard.AsMut<FreeSpaceMapPage>();
+  }
+  auto idx = fsm_page->AddEntry(page_id, free_space);
+  std::unique_lock guard(fsm_latch_);
+  fsm_entries_[page_id] = {last_fsm_page_id_, idx};
 }
 
 auto TableHeap::GetTuple(RID rid) -> std::pair<TupleMeta, Tuple> {
@@ -104,9 +245,7 @@ auto TableHeap::GetTupleMeta(RID rid) -> TupleMeta {
 }
 
 auto TableHeap::MakeIterator() -> TableIterator {
-  std::unique_lock<std::mutex> guard(latch_);
-  auto last_page_id = last_page_id_;
-  guard.unlock();
+  auto last_page_id = last_page_id_.load();
 
   auto page_guard = bpm_->FetchPageRead(last_page_id);
   auto page = page_guard.As<TablePage>();
@@ -115,6 +254,42 @@ auto TableHeap::MakeIterator() -> TableIterator {
 
 auto TableHeap::MakeEagerIterator() -> TableIterator { return {this, {first_page_id_, 0}, {INVALID_PAGE_ID, 0}}; }
 
+auto TableHeap::MakeMorsels(size_t pages_per_morsel) -> std::vector<TableMorsel> {
+  BUSTUB_ASSERT(pages_per_morsel > 0, "empty morsels");
+  auto last_page_id = last_page_id_.load();
+
+  std::vector<TableMorsel> morsels;
+  auto page_id = first_page_id_;
+  auto morsel_first_page_id = first_page_id_;
+  size_t pages_in_morsel = 0;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page_guard = bpm_->FetchPageRead(page_id);
+    auto page = page_guard.As<TablePage>();
+    auto num_tuples = page->GetNumTuples();
+    auto next_page_id = page->GetNextPageId();
+    page_guard.Drop();
+
+    pages_in_morsel++;
+    if (page_id == last_page_id || pages_in_morsel == pages_per_morsel) {
+      // A morsel ends after the last tuple of its last page.
+      if (page_id != morsel_first_page_id || num_tuples > 0) {
+        morsels.push_back({RID{morsel_first_page_id, 0}, RID{page_id, num_tuples}});
+      }
+      if (page_id == last_page_id) {
+        break;
+      }
+      morsel_first_page_id = next_page_id;
+      pages_in_morsel = 0;
+    }
+    page_id = next_page_id;
+  }
+  return morsels;
+}
+
+auto TableHeap::MakeMorselIterator(const TableMorsel &morsel) -> TableIterator {
+  return {this, morsel.start_rid_, morsel.stop_at_rid_};
+}
+
 void TableHeap::UpdateTupleInPlaceUnsafe(const TupleMeta &meta, const Tuple &tuple, RID rid) {
   auto page_guard = bpm_->FetchPageWrite(rid.GetPageId());
   auto page = page_guard.AsMut<TablePage>();
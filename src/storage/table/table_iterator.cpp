@@ -31,15 +31,40 @@ TableIterator::TableIterator(TableHeap *table_heap, RID rid, RID stop_at_rid)
   }
 }
 
-auto TableIterator::GetTuple() -> std::pair<TupleMeta, Tuple> { return table_heap_->GetTuple(rid_); }
+auto TableIterator::GetTuple() -> std::pair<TupleMeta, Tuple> {
+  ReleasePage();
+  return table_heap_->GetTuple(rid_);
+}
+
+void TableIterator::ReadTupleRefs(size_t max_tuples, std::vector<TupleRef> *tuples) {
+  tuples->clear();
+  // Release the previous page first: it may be the current one, and a latch is not reentrant.
+  ReleasePage();
+  auto page_id = rid_.GetPageId();
+  page_guard_ = table_heap_->bpm_->FetchPageRead(page_id);
+  auto page = page_guard_.As<TablePage>();
+  while (tuples->size() < max_tuples && rid_.GetPageId() == page_id) {
+    auto [meta, tuple] = page->GetTupleRef(rid_);
+    if (!meta.is_deleted_) {
+      tuples->push_back(tuple);
+    }
+    Advance(page);
+  }
+}
 
 auto TableIterator::GetRID() -> RID { return rid_; }
 
 auto TableIterator::IsEnd() -> bool { return rid_.GetPageId() == INVALID_PAGE_ID; }
 
 auto TableIterator::operator++() -> TableIterator & {
+  ReleasePage();
   auto page_guard = table_heap_->bpm_->FetchPageRead(rid_.GetPageId());
-  auto page = page_guard.As<TablePage>();
+  Advance(page_guard.As<TablePage>());
+  page_guard.Drop();
+  return *this;
+}
+
+void TableIterator::Advance(const TablePage *page) {
   auto next_tuple_id = rid_.GetSlotNum() + 1;
 
   if (stop_at_rid_.GetPageId() != INVALID_PAGE_ID) {
@@ -61,10 +86,6 @@ auto TableIterator::operator++() -> TableIterator & {
     // if next page is invalid, RID is set to invalid page; otherwise, it's the first tuple in that page.
     rid_ = RID{next_page_id, 0};
   }
-
-  page_guard.Drop();
-
-  return *this;
 }
 
 }  // namespace bustub
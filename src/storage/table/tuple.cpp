@@ -68,6 +68,11 @@ auto Tuple::GetValue(const Schema *schema, const uint32_t column_idx) const -> V
   return Value::DeserializeFrom(data_ptr, column_type);
 }
 
+auto Tuple::GetValueView(const Schema *schema, const uint32_t column_idx) const -> Value {
+  assert(schema);
+  return Value::DeserializeViewFrom(GetDataPtr(schema, column_idx), schema->GetColumn(column_idx).GetType());
+}
+
 auto Tuple::KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs)
     -> Tuple {
   std::vector<Value> values;
@@ -79,19 +84,11 @@ auto Tuple::KeyFromTuple(const Schema &schema, const Schema &key_schema, const s
 }
 
 auto Tuple::GetDataPtr(const Schema *schema, const uint32_t column_idx) const -> const char * {
-  assert(schema);
-  const auto &col = schema->GetColumn(column_idx);
-  bool is_inlined = col.IsInlined();
-  // For inline type, data is stored where it is.
-  if (is_inlined) {
-    return (data_.data() + col.GetOffset());
-  }
-  // We read the relative offset from the tuple data.
-  int32_t offset = *reinterpret_cast<const int32_t *>(data_.data() + col.GetOffset());
-  // And return the beginning address of the real data for the VARCHAR type.
-  return (data_.data() + offset);
+  return AsRef().GetDataPtr(schema, column_idx);
 }
 
+auto Tuple::AsRef() const -> TupleRef { return {data_.data(), static_cast<uint32_t>(data_.size()), rid_}; }
+
 auto Tuple::ToString(const Schema *schema) const -> std::string {
   std::stringstream os;
 
@@ -107,7 +104,7 @@ auto Tuple::ToString(const Schema *schema) const -> std::string {
     if (IsNull(schema, column_itr)) {
       os << "<NULL>";
     } else {
-      Value val = (GetValue(schema, column_itr));
+      Value val = GetValueView(schema, column_itr);
       os << val.ToString();
     }
   }
@@ -129,4 +126,39 @@ void Tuple::DeserializeFrom(const char *storage) {
   memcpy(this->data_.data(), storage + sizeof(int32_t), size);
 }
 
+auto TupleRef::GetValue(const Schema *schema, const uint32_t column_idx) const -> Value {
+  assert(schema);
+  return Value::DeserializeFrom(GetDataPtr(schema, column_idx), schema->GetColumn(column_idx).GetType());
+}
+
+auto TupleRef::GetValueView(const Schema *schema, const uint32_t column_idx) const -> Value {
+  assert(schema);
+  return Value::DeserializeViewFrom(GetDataPtr(schema, column_idx), schema->GetColumn(column_idx).GetType());
+}
+
+auto TupleRef::ToTuple() const -> Tuple {
+  Tuple tuple;
+  CopyTo(&tuple);
+  return tuple;
+}
+
+void TupleRef::CopyTo(Tuple *tuple) const {
+  tuple->data_.assign(data_, data_ + length_);
+  tuple->rid_ = rid_;
+}
+
+auto TupleRef::GetDataPtr(const Schema *schema, const uint32_t column_idx) const -> const char * {
+  assert(schema);
+  const auto &col = schema->GetColumn(column_idx);
+  bool is_inlined = col.IsInlined();
+  // For inline type, data is stored where it is.
+  if (is_inlined) {
+    return (data_ + col.GetOffset());
+  }
+  // We read the relative offset from the tuple data.
+  int32_t offset = *reinterpret_cast<const int32_t *>(data_ + col.GetOffset());
+  // And return the beginning address of the real data for the VARCHAR type.
+  return (data_ + offset);
+}
+
 }  // namespace bustub
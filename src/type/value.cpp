@@ -18,31 +18,42 @@
 #include "type/value.h"
 
 namespace bustub {
-Value::Value(const Value &other) {
-  type_id_ = other.type_id_;
-  size_ = other.size_;
-  manage_data_ = other.manage_data_;
-  value_ = other.value_;
-  switch (type_id_) {
-    case TypeId::VARCHAR:
-      if (size_.len_ == BUSTUB_VALUE_NULL) {
-        value_.varlen_ = nullptr;
-      } else {
-        if (manage_data_) {
-          value_.varlen_ = new char[size_.len_];
-          memcpy(value_.varlen_, other.value_.varlen_, size_.len_);
-        } else {
-          value_ = other.value_;
-        }
-      }
-      break;
-    default:
-      value_ = other.value_;
+Value::Value(const Value &other)
+    : value_(other.value_), size_(other.size_), manage_data_(other.manage_data_), type_id_(other.type_id_) {
+  if (type_id_ == TypeId::VARCHAR) {
+    if (size_.len_ == BUSTUB_VALUE_NULL) {
+      value_.varlen_ = nullptr;
+    } else {
+      // The copy owns its data, even if `other` borrows it.
+      CopyVarlen(other.GetVarlenData(), size_.len_);
+    }
   }
 }
 
-auto Value::operator=(Value other) -> Value & {
-  Swap(*this, other);
+Value::Value(Value &&other) noexcept
+    : value_(other.value_), size_(other.size_), manage_data_(other.manage_data_), type_id_(other.type_id_) {
+  if (type_id_ != TypeId::VARCHAR || size_.len_ == BUSTUB_VALUE_NULL) {
+    return;
+  }
+  if (!manage_data_) {
+    CopyVarlen(other.value_.const_varlen_, size_.len_);
+  } else if (!IsVarlenInline()) {
+    // Steal the heap data, leaving a null value behind.
+    other.value_.varlen_ = nullptr;
+    other.size_.len_ = BUSTUB_VALUE_NULL;
+    other.manage_data_ = false;
+  }
+}
+
+auto Value::operator=(const Value &other) -> Value & {
+  Value copy(other);
+  Swap(*this, copy);
+  return *this;
+}
+
+auto Value::operator=(Value &&other) noexcept -> Value & {
+  Value moved(std::move(other));
+  Swap(*this, moved);
   return *this;
 }
 
@@ -218,13 +229,9 @@ Value::Value(TypeId type, const char *data, uint32_t len, bool manage_data) : Va
         value_.varlen_ = nullptr;
         size_.len_ = BUSTUB_VALUE_NULL;
       } else {
-        manage_data_ = manage_data;
-        if (manage_data_) {
+        if (manage_data) {
           assert(len < BUSTUB_VARCHAR_MAX_LEN);
-          value_.varlen_ = new char[len];
-          assert(value_.varlen_ != nullptr);
-          size_.len_ = len;
-          memcpy(value_.varlen_, data, len);
+          CopyVarlen(data, len);
         } else {
           // FUCK YOU GCC I do what I want.
           value_.const_varlen_ = data;
@@ -240,13 +247,8 @@ Value::Value(TypeId type, const char *data, uint32_t len, bool manage_data) : Va
 Value::Value(TypeId type, const std::string &data) : Value(type) {
   switch (type) {
     case TypeId::VARCHAR: {
-      manage_data_ = true;
       // TODO(TAs): How to represent a null string here?
-      uint32_t len = static_cast<uint32_t>(data.length()) + 1;
-      value_.varlen_ = new char[len];
-      assert(value_.varlen_ != nullptr);
-      size_.len_ = len;
-      memcpy(value_.varlen_, data.c_str(), len);
+      CopyVarlen(data.c_str(), static_cast<uint32_t>(data.length()) + 1);
       break;
     }
     default:
@@ -258,7 +260,7 @@ Value::Value(TypeId type, const std::string &data) : Value(type) {
 Value::~Value() {
   switch (type_id_) {
     case TypeId::VARCHAR:
-      if (manage_data_) {
+      if (manage_data_ && !IsVarlenInline()) {
         delete[] value_.varlen_;
       }
       break;
@@ -267,6 +269,35 @@ Value::~Value() {
   }
 }
 
+void Value::CopyVarlen(const char *data, uint32_t len) {
+  manage_data_ = true;
+  size_.len_ = len;
+  if (IsVarlenInline()) {
+    memcpy(value_.inline_varlen_, data, len);
+    return;
+  }
+  value_.varlen_ = new char[len];
+  memcpy(value_.varlen_, data, len);
+}
+
+auto Value::DeserializeViewFrom(const char *storage, const TypeId type_id) -> Value {
+  if (type_id != TypeId::VARCHAR) {
+    return DeserializeFrom(storage, type_id);
+  }
+  uint32_t len = *reinterpret_cast<const uint32_t *>(storage);
+  if (len == BUSTUB_VALUE_NULL) {
+    return {type_id, nullptr, len, false};
+  }
+  return {type_id, storage + sizeof(uint32_t), len, false};
+}
+
+auto Value::View() const -> Value {
+  if (type_id_ != TypeId::VARCHAR || IsNull()) {
+    return *this;
+  }
+  return {type_id_, GetVarlenData(), size_.len_, false};
+}
+
 auto Value::CheckComparable(const Value &o) const -> bool {
   switch (GetTypeId()) {
     case TypeId::BOOLEAN:
@@ -292,6 +323,8 @@ auto Value::CheckComparable(const Value &o) const -> bool {
       // Anything can be cast to a string!
       return true;
       break;
+    case TypeId::TIMESTAMP:
+      return (o.GetTypeId() == TypeId::TIMESTAMP || o.GetTypeId() == TypeId::VARCHAR);
     default:
       break;
   }  // END OF SWITCH
@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_executor_test.cpp
+//
+// Identification: test/execution/aggregation_executor_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "execution/executor_context.h"
+#include "execution/executors/aggregation_executor.h"
+#include "execution/executors/mock_scan_executor.h"
+#include "execution/executors/values_executor.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/mock_scan_plan.h"
+#include "execution/plans/values_plan.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(AggregationExecutorTest, SpillLargeGroups) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(16, disk_manager.get());
+  ExecutorContext exec_ctx{nullptr, nullptr, bpm.get(), nullptr, nullptr, false};
+  // Every group spills, and its key alone is larger than a page.
+  exec_ctx.SetMemoryBudget(1);
+
+  auto make_key = [](int group) { return std::string(BUSTUB_PAGE_SIZE + group * 100, static_cast<char>('a' + group)); };
+  const int num_groups = 20;
+  auto input_schema = std::make_shared<Schema>(std::vector<Column>{{"k", TypeId::VARCHAR, 64}, {"v", TypeId::INTEGER}});
+  std::vector<std::vector<AbstractExpressionRef>> rows;
+  for (int i = 0; i < num_groups * 3; i++) {
+    rows.push_back({std::make_shared<ConstantValueExpression>(ValueFactory::GetVarcharValue(make_key(i % num_groups))),
+                    std::make_shared<ConstantValueExpression>(ValueFactory::GetIntegerValue(i))});
+  }
+  auto values_plan = std::make_shared<ValuesPlanNode>(input_schema, std::move(rows));
+  auto output_schema =
+      std::make_shared<Schema>(std::vector<Column>{{"k", TypeId::VARCHAR, 64}, {"sum", TypeId::INTEGER}});
+  AggregationPlanNode plan{output_schema,
+                           values_plan,
+                           {std::make_shared<ColumnValueExpression>(0, 0, TypeId::VARCHAR)},
+                           {std::make_shared<ColumnValueExpression>(0, 1, TypeId::INTEGER)},
+                           {AggregationType::SumAggregate}};
+  AggregationExecutor executor{&exec_ctx, &plan, std::make_unique<ValuesExecutor>(&exec_ctx, values_plan.get())};
+  executor.Init();
+
+  std::map<std::string, int32_t> sums;
+  Tuple tuple;
+  RID rid;
+  while (executor.Next(&tuple, &rid)) {
+    sums[tuple.GetValue(output_schema.get(), 0).ToString()] = tuple.GetValue(output_schema.get(), 1).GetAs<int32_t>();
+  }
+  ASSERT_EQ(num_groups, sums.size());
+  for (int group = 0; group < num_groups; group++) {
+    ASSERT_EQ(group * 3 + num_groups * 3, sums[make_key(group)]);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(AggregationExecutorTest, SpillStatefulAggregates) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(16, disk_manager.get());
+  ExecutorContext exec_ctx{nullptr, nullptr, bpm.get(), nullptr, nullptr, false};
+  exec_ctx.SetMemoryBudget(1);
+
+  // v2 of __mock_agg_input_big is the cursor and v4 is cursor / 1000: 10 groups of 1000 distinct values. Every chunk is
+  // spilled, so the states of a group are serialized, split and merged back several times.
+  auto scan_plan = std::make_shared<MockScanPlanNode>(
+      std::make_shared<Schema>(GetMockTableSchemaOf("__mock_agg_input_big")), "__mock_agg_input_big");
+  auto v2 = std::make_shared<ColumnValueExpression>(0, 1, TypeId::INTEGER);
+  auto v4 = std::make_shared<ColumnValueExpression>(0, 3, TypeId::INTEGER);
+  auto output_schema = std::make_shared<Schema>(
+      std::vector<Column>{{"v4", TypeId::INTEGER}, {"avg", TypeId::DECIMAL}, {"count_distinct", TypeId::INTEGER},
+                          {"approx_count_distinct", TypeId::INTEGER}, {"approx_quantile", TypeId::DECIMAL}});
+  auto null_arg = ValueFactory::GetNullValueByType(TypeId::INTEGER);
+  AggregationPlanNode plan{output_schema,
+                           scan_plan,
+                           {v4},
+                           {v2, v2, v2, v2},
+                           {AggregationType::AvgAggregate, AggregationType::CountDistinctAggregate,
+                            AggregationType::ApproxCountDistinctAggregate, AggregationType::ApproxQuantileAggregate},
+                           {null_arg, null_arg, null_arg, ValueFactory::GetDecimalValue(0.5)}};
+  AggregationExecutor executor{&exec_ctx, &plan, std::make_unique<MockScanExecutor>(&exec_ctx, scan_plan.get())};
+  executor.Init();
+
+  size_t num_groups = 0;
+  Tuple tuple;
+  RID rid;
+  while (executor.Next(&tuple, &rid)) {
+    num_groups++;
+    auto group = tuple.GetValue(output_schema.get(), 0).GetAs<int32_t>();
+    EXPECT_DOUBLE_EQ(group * 1000 + 499.5, tuple.GetValue(output_schema.get(), 1).GetAs<double>());
+    EXPECT_EQ(1000, tuple.GetValue(output_schema.get(), 2).GetAs<int32_t>());
+    EXPECT_NEAR(1000, tuple.GetValue(output_schema.get(), 3).GetAs<int32_t>(), 50);
+    EXPECT_NEAR(group * 1000 + 500, tuple.GetValue(output_schema.get(), 4).GetAs<double>(), 25);
+  }
+  ASSERT_EQ(10, num_groups);
+}
+
+}  // namespace bustub
@@ -0,0 +1,176 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_hash_table_test.cpp
+//
+// Identification: test/execution/aggregation_hash_table_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "execution/executors/aggregation_executor.h"
+#include "execution/expressions/column_value_expression.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(AggregationHashTableTest, SerializedKeys) {
+  std::vector<Value> key{ValueFactory::GetIntegerValue(-3), ValueFactory::GetVarcharValue("group"),
+                         ValueFactory::GetNullValueByType(TypeId::VARCHAR),
+                         ValueFactory::GetNullValueByType(TypeId::BIGINT), ValueFactory::GetBooleanValue(true)};
+  std::string bytes;
+  SerializeAggregateKey(key, &bytes);
+  auto values = DeserializeAggregateKey(bytes.data(), bytes.size());
+  ASSERT_EQ(key.size(), values.size());
+  for (size_t i = 0; i < key.size(); i++) {
+    EXPECT_EQ(key[i].GetTypeId(), values[i].GetTypeId());
+    EXPECT_EQ(key[i].IsNull(), values[i].IsNull());
+    if (!key[i].IsNull()) {
+      EXPECT_EQ(CmpBool::CmpTrue, key[i].CompareEquals(values[i]));
+    }
+  }
+
+  // Nulls of a type group together, and differ from any value.
+  std::string null_key1;
+  std::string null_key2;
+  std::string zero_key;
+  SerializeAggregateKey({ValueFactory::GetNullValueByType(TypeId::INTEGER)}, &null_key1);
+  SerializeAggregateKey({ValueFactory::GetNullValueByType(TypeId::INTEGER)}, &null_key2);
+  SerializeAggregateKey({ValueFactory::GetIntegerValue(0)}, &zero_key);
+  EXPECT_EQ(null_key1, null_key2);
+  EXPECT_NE(null_key1, zero_key);
+
+  // -0.0 and 0.0 are the same group.
+  std::string negative_zero_key;
+  std::string positive_zero_key;
+  SerializeAggregateKey({ValueFactory::GetDecimalValue(-0.0)}, &negative_zero_key);
+  SerializeAggregateKey({ValueFactory::GetDecimalValue(0.0)}, &positive_zero_key);
+  EXPECT_EQ(negative_zero_key, positive_zero_key);
+}
+
+// NOLINTNEXTLINE
+TEST(AggregationHashTableTest, CombineAndMerge) {
+  std::vector<AbstractExpressionRef> agg_exprs(5, std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER));
+  std::vector<AggregationType> agg_types{AggregationType::CountStarAggregate, AggregationType::CountAggregate,
+                                         AggregationType::SumAggregate, AggregationType::MinAggregate,
+                                         AggregationType::MaxAggregate};
+
+  // Aggregate 100000 values over 10000 groups directly, and through two partial tables merged together.
+  const int num_values = 100000;
+  const int num_groups = 10000;
+  SimpleAggregationHashTable table{agg_exprs, agg_types};
+  SimpleAggregationHashTable partials[2] = {{agg_exprs, agg_types}, {agg_exprs, agg_types}};
+  for (int i = 0; i < num_values; i++) {
+    AggregateKey key{{ValueFactory::GetIntegerValue(i % num_groups)}};
+    auto input = i % 7 == 0 ? ValueFactory::GetNullValueByType(TypeId::INTEGER) : ValueFactory::GetIntegerValue(i);
+    AggregateValue value{std::vector<Value>(5, input)};
+    table.InsertCombine(key, value);
+    partials[i % 2].InsertCombine(key, value);
+  }
+  SimpleAggregationHashTable merged{agg_exprs, agg_types};
+  for (auto &partial : partials) {
+    for (const auto &group : partial.GetGroups()) {
+      merged.InsertMerge(std::string{group.key_}, group.hash_, group.value_);
+    }
+  }
+  ASSERT_EQ(num_groups, table.Size());
+  ASSERT_EQ(num_groups, merged.Size());
+  EXPECT_GT(table.GetMemoryUsage(), 0);
+
+  std::map<int, std::vector<Value>> expected;
+  for (auto iter = table.Begin(); iter != table.End(); ++iter) {
+    expected.emplace(iter.Key().group_bys_[0].GetAs<int32_t>(), iter.Val().aggregates_);
+  }
+  ASSERT_EQ(num_groups, expected.size());
+  for (auto iter = merged.Begin(); iter != merged.End(); ++iter) {
+    auto group = iter.Key().group_bys_[0].GetAs<int32_t>();
+    const auto &values = iter.Val().aggregates_;
+    const auto &expected_values = expected.at(group);
+    for (size_t i = 0; i < values.size(); i++) {
+      EXPECT_EQ(CmpBool::CmpTrue, values[i].CompareEquals(expected_values[i])) << "group " << group << " agg " << i;
+    }
+  }
+
+  // Group 0 gets 0, 10000, ..., 90000, of which 0, 70000 are multiples of 7.
+  const auto &group0 = expected.at(0);
+  EXPECT_EQ(10, group0[0].GetAs<int32_t>());
+  EXPECT_EQ(8, group0[1].GetAs<int32_t>());
+  EXPECT_EQ(10000 + 20000 + 30000 + 40000 + 50000 + 60000 + 80000 + 90000, group0[2].GetAs<int32_t>());
+  EXPECT_EQ(10000, group0[3].GetAs<int32_t>());
+  EXPECT_EQ(90000, group0[4].GetAs<int32_t>());
+}
+
+// NOLINTNEXTLINE
+TEST(AggregationHashTableTest, StatefulAggregates) {
+  std::vector<AbstractExpressionRef> agg_exprs(4, std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER));
+  std::vector<AggregationType> agg_types{AggregationType::AvgAggregate, AggregationType::CountDistinctAggregate,
+                                         AggregationType::ApproxCountDistinctAggregate,
+                                         AggregationType::ApproxQuantileAggregate};
+  auto null_arg = ValueFactory::GetNullValueByType(TypeId::INTEGER);
+  std::vector<Value> agg_args{null_arg, null_arg, null_arg, ValueFactory::GetDecimalValue(0.5)};
+
+  // Group g gets the values of [0, 5000) equal to g modulo 10, each 4 times, and a null.
+  const int num_values = 20000;
+  const int num_groups = 10;
+  SimpleAggregationHashTable table{agg_exprs, agg_types, agg_args};
+  SimpleAggregationHashTable partials[2] = {{agg_exprs, agg_types, agg_args}, {agg_exprs, agg_types, agg_args}};
+  for (int i = 0; i < num_values + num_groups; i++) {
+    AggregateKey key{{ValueFactory::GetIntegerValue(i % num_groups)}};
+    auto input =
+        i < num_values ? ValueFactory::GetIntegerValue(i % 5000) : ValueFactory::GetNullValueByType(TypeId::INTEGER);
+    AggregateValue value{std::vector<Value>(4, input)};
+    table.InsertCombine(key, value);
+    partials[i % 2].InsertCombine(key, value);
+  }
+  SimpleAggregationHashTable merged{agg_exprs, agg_types, agg_args};
+  for (auto &partial : partials) {
+    for (const auto &group : partial.GetGroups()) {
+      merged.InsertMerge(std::string{group.key_}, group.hash_, group.value_);
+    }
+  }
+  // The groups are also serialized as when they are spilled, in parts small enough to split the distinct values.
+  SimpleAggregationHashTable spilled{agg_exprs, agg_types, agg_args};
+  for (const auto &group : table.GetGroups()) {
+    std::vector<std::string> parts;
+    table.SerializeAggregateValue(group.value_, 4096, &parts);
+    EXPECT_GT(parts.size(), 1);
+    for (const auto &part : parts) {
+      EXPECT_LE(part.size(), 4096);
+      spilled.InsertMerge(std::string{group.key_}, group.hash_,
+                          spilled.DeserializeAggregateValue(part.data(), part.size()));
+    }
+  }
+  ASSERT_EQ(num_groups, table.Size());
+  ASSERT_EQ(num_groups, merged.Size());
+  ASSERT_EQ(num_groups, spilled.Size());
+
+  for (auto *result : {&table, &merged, &spilled}) {
+    for (auto iter = result->Begin(); iter != result->End(); ++iter) {
+      auto group = iter.Key().group_bys_[0].GetAs<int32_t>();
+      auto values = result->FinalizeAggregateValue(iter.Val());
+      ASSERT_EQ(4, values.size());
+      EXPECT_DOUBLE_EQ(2495 + group, values[0].GetAs<double>());
+      EXPECT_EQ(500, values[1].GetAs<int32_t>());
+      EXPECT_NEAR(500, values[2].GetAs<int32_t>(), 50);
+      EXPECT_NEAR(2495 + group, values[3].GetAs<double>(), 25);
+    }
+  }
+
+  // Over no value, the results are null or zero.
+  auto empty = table.FinalizeAggregateValue(table.GenerateInitialAggregateValue());
+  EXPECT_TRUE(empty[0].IsNull());
+  EXPECT_EQ(0, empty[1].GetAs<int32_t>());
+  EXPECT_EQ(0, empty[2].GetAs<int32_t>());
+  EXPECT_TRUE(empty[3].IsNull());
+}
+
+}  // namespace bustub
@@ -0,0 +1,192 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bulk_loader_test.cpp
+//
+// Identification: test/execution/bulk_loader_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "catalog/catalog.h"
+#include "common/bustub_instance.h"
+#include "concurrency/lock_manager.h"
+#include "concurrency/transaction_manager.h"
+#include "execution/bulk_loader.h"
+#include "execution/task_scheduler.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+const char *const CSV_FILE = "bulk_loader_test.csv";
+
+void WriteFile(const std::string &content) {
+  std::ofstream file(CSV_FILE, std::ios::binary | std::ios::trunc);
+  file << content;
+}
+
+auto ReadTable(TableInfo *table_info) -> std::vector<std::vector<Value>> {
+  std::vector<std::vector<Value>> rows;
+  for (auto iter = table_info->table_->MakeIterator(); !iter.IsEnd(); ++iter) {
+    auto [meta, tuple] = iter.GetTuple();
+    std::vector<Value> row;
+    for (uint32_t i = 0; i < table_info->schema_.GetColumnCount(); i++) {
+      row.push_back(tuple.GetValue(&table_info->schema_, i));
+    }
+    rows.push_back(std::move(row));
+  }
+  return rows;
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(BulkLoaderTest, ParseCsv) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(32, disk_manager.get());
+  LockManager lock_manager;
+  TransactionManager txn_manager{&lock_manager};
+  Catalog catalog{bpm.get(), &lock_manager, nullptr};
+  TaskScheduler scheduler{2};
+  auto *txn = txn_manager.Begin();
+  Schema schema{std::vector<Column>{{"a", TypeId::INTEGER}, {"b", TypeId::VARCHAR, 32}, {"c", TypeId::DECIMAL}}};
+  auto *table_info = catalog.CreateTable(txn, "t", schema);
+
+  // Quoted delimiters, quotes and line breaks, NULLs, CRLF line ends, and a last row without a line break. Chunks of
+  // a few bytes put chunk boundaries everywhere, including within quoted fields.
+  WriteFile(
+      "a|b|c\n"
+      "1|plain|1.5\n"
+      "2|\"with | delimiter\"|-2\r\n"
+      "3|\"with \"\"quotes\"\"\"|0\n"
+      "\n"
+      "4|\"two\nlines\"|\n"
+      "|\"\"|3.25\n"
+      "6|last|6");
+  BulkLoader loader{table_info, {}, &scheduler, CsvFormat{'|', true, ""}, 4};
+  ASSERT_EQ(loader.Load(CSV_FILE, txn), 6);
+
+  auto rows = ReadTable(table_info);
+  ASSERT_EQ(rows.size(), 6);
+  ASSERT_EQ(rows[0][0].GetAs<int32_t>(), 1);
+  ASSERT_EQ(rows[0][1].ToString(), "plain");
+  ASSERT_EQ(rows[0][2].GetAs<double>(), 1.5);
+  ASSERT_EQ(rows[1][1].ToString(), "with | delimiter");
+  ASSERT_EQ(rows[1][2].GetAs<double>(), -2);
+  ASSERT_EQ(rows[2][1].ToString(), "with \"quotes\"");
+  ASSERT_EQ(rows[3][1].ToString(), "two\nlines");
+  ASSERT_TRUE(rows[3][2].IsNull());
+  ASSERT_TRUE(rows[4][0].IsNull());
+  ASSERT_FALSE(rows[4][1].IsNull());
+  ASSERT_EQ(rows[4][1].ToString(), "");
+  ASSERT_EQ(rows[5][1].ToString(), "last");
+  ASSERT_EQ(rows[5][2].GetAs<double>(), 6);
+
+  // Malformed rows are rejected.
+  for (const auto *content : {"1|x\n", "1|x|2|3\n", "one|x|2\n", "1|\"x\"y|2\n", "1|\"x|2\n", "99999999999|x|2\n"}) {
+    WriteFile(content);
+    BulkLoader bad_loader{table_info, {}, &scheduler, CsvFormat{'|', false, ""}};
+    ASSERT_THROW(bad_loader.Load(CSV_FILE, txn), Exception) << content;
+  }
+  ASSERT_EQ(ReadTable(table_info).size(), 6);
+
+  std::remove(CSV_FILE);
+  delete txn;
+}
+
+// NOLINTNEXTLINE
+TEST(BulkLoaderTest, LoadPagesAndIndex) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(32, disk_manager.get());
+  LockManager lock_manager;
+  TransactionManager txn_manager{&lock_manager};
+  Catalog catalog{bpm.get(), &lock_manager, nullptr};
+  TaskScheduler scheduler{3};
+  auto *txn = txn_manager.Begin();
+  Schema schema{std::vector<Column>{{"a", TypeId::INTEGER}, {"b", TypeId::VARCHAR, 32}}};
+  auto *table_info = catalog.CreateTable(txn, "t", schema);
+  auto key_schema = Schema::CopySchema(&schema, {0});
+  auto *index_info = catalog.CreateIndex<IntegerKeyType, IntegerValueType, IntegerComparatorType>(
+      txn, "t_a", "t", schema, key_schema, {0}, TWO_INTEGER_SIZE, IntegerHashFunctionType{});
+  ASSERT_NE(index_info, nullptr);
+
+  // Keys out of order, over many pages, chunks, and rounds.
+  const int num_rows = 5000;
+  std::ostringstream csv;
+  for (int i = 0; i < num_rows; i++) {
+    csv << (i * 7919) % num_rows << ",row " << i << "\n";
+  }
+  WriteFile(csv.str());
+  BulkLoader loader{table_info, catalog.GetTableIndexes("t"), &scheduler, CsvFormat{}, 1024};
+  ASSERT_EQ(loader.Load(CSV_FILE, txn), num_rows);
+
+  // The rows are in file order, and the pages are full but for the last one of every chunk.
+  auto rows = ReadTable(table_info);
+  ASSERT_EQ(rows.size(), num_rows);
+  for (int i = 0; i < num_rows; i++) {
+    ASSERT_EQ(rows[i][0].GetAs<int32_t>(), (i * 7919) % num_rows);
+    ASSERT_EQ(rows[i][1].ToString(), "row " + std::to_string(i));
+  }
+  size_t num_pages = 0;
+  for (auto page_id = table_info->table_->GetFirstPageId(); page_id != INVALID_PAGE_ID;) {
+    auto guard = bpm->FetchPageRead(page_id);
+    page_id = guard.As<TablePage>()->GetNextPageId();
+    num_pages++;
+  }
+  auto csv_size = csv.str().size();
+  ASSERT_LT(num_pages, csv_size * 2 / BUSTUB_PAGE_SIZE + csv_size / 1024);
+
+  // Every key is in the index.
+  for (int key = 0; key < num_rows; key++) {
+    std::vector<RID> rids;
+    index_info->index_->ScanKey(Tuple{{ValueFactory::GetIntegerValue(key)}, &key_schema}, &rids, txn);
+    ASSERT_EQ(rids.size(), 1);
+    auto [meta, tuple] = table_info->table_->GetTuple(rids[0]);
+    ASSERT_EQ(tuple.GetValue(&schema, 0).GetAs<int32_t>(), key);
+  }
+
+  // Inserts after the load go to the table as usual, and scans see them.
+  table_info->table_->InsertTuple({INVALID_TXN_ID, INVALID_TXN_ID, false},
+                                  Tuple{{ValueFactory::GetIntegerValue(-1), ValueFactory::GetVarcharValue("x")}, &schema});
+  ASSERT_EQ(ReadTable(table_info).size(), num_rows + 1);
+
+  std::remove(CSV_FILE);
+  delete txn;
+}
+
+// NOLINTNEXTLINE
+TEST(BulkLoaderTest, CopyStatement) {
+  auto bustub = std::make_unique<BustubInstance>();
+  NoopWriter noop_writer;
+  bustub->ExecuteSql("CREATE TABLE t(a int, b varchar(16));", noop_writer);
+  WriteFile("a;b\n1;one\n2;\n3;three\n");
+  std::stringstream copy_result;
+  SimpleStreamWriter copy_writer(copy_result, true);
+  bustub->ExecuteSql(fmt::format("COPY t FROM '{}' (DELIMITER ';', HEADER, NULL 'null');", CSV_FILE), copy_writer);
+  ASSERT_EQ(copy_result.str(), "3 rows copied\t\n");
+
+  std::stringstream result;
+  SimpleStreamWriter writer(result, true, ",");
+  bustub->ExecuteSql("SELECT * FROM t;", writer);
+  ASSERT_EQ(result.str(), "1,one,\n2,,\n3,three,\n");
+
+  ASSERT_THROW(bustub->ExecuteSql("COPY t TO 'out.csv';", noop_writer), Exception);
+  ASSERT_THROW(bustub->ExecuteSql("COPY t FROM 'missing.csv';", noop_writer), Exception);
+  std::remove(CSV_FILE);
+}
+
+}  // namespace bustub
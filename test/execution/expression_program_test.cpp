@@ -0,0 +1,237 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// expression_program_test.cpp
+//
+// Identification: test/execution/expression_program_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "execution/expression_program.h"
+#include "execution/expressions/arithmetic_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/expressions/string_expression.h"
+#include "gtest/gtest.h"
+#include "type/limits.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** (a INTEGER, b BIGINT, c DECIMAL, s VARCHAR, f BOOLEAN, t TIMESTAMP), with nulls in every column */
+auto MakeSchema() -> Schema {
+  return Schema{std::vector<Column>{{"a", TypeId::INTEGER},
+                                    {"b", TypeId::BIGINT},
+                                    {"c", TypeId::DECIMAL},
+                                    {"s", TypeId::VARCHAR, 16},
+                                    {"f", TypeId::BOOLEAN},
+                                    {"t", TypeId::TIMESTAMP}}};
+}
+
+auto MakeTuples(const Schema &schema, size_t num_tuples) -> std::vector<Tuple> {
+  std::mt19937 rng{42};
+  auto maybe_null = [&](TypeId type, Value value) {
+    return rng() % 8 == 0 ? ValueFactory::GetNullValueByType(type) : value;
+  };
+  std::vector<Tuple> tuples;
+  for (size_t i = 0; i < num_tuples; i++) {
+    auto a = static_cast<int32_t>(rng() % 21) - 10;
+    std::vector<Value> values{
+        maybe_null(TypeId::INTEGER, ValueFactory::GetIntegerValue(a)),
+        maybe_null(TypeId::BIGINT, ValueFactory::GetBigIntValue(static_cast<int64_t>(rng() % 21) - 10)),
+        maybe_null(TypeId::DECIMAL, ValueFactory::GetDecimalValue(static_cast<double>(rng() % 41) / 2 - 10)),
+        maybe_null(TypeId::VARCHAR, ValueFactory::GetVarcharValue(std::string(rng() % 4, static_cast<char>('a' + rng() % 3)))),
+        maybe_null(TypeId::BOOLEAN, ValueFactory::GetBooleanValue(rng() % 2 == 0)),
+        maybe_null(TypeId::TIMESTAMP, ValueFactory::GetTimestampValue(rng() % 5))};
+    tuples.emplace_back(values, &schema);
+  }
+  return tuples;
+}
+
+auto Col(uint32_t col_idx, TypeId type, uint32_t tuple_idx = 0) -> AbstractExpressionRef {
+  return std::make_shared<ColumnValueExpression>(tuple_idx, col_idx, type);
+}
+
+auto Const(const Value &value) -> AbstractExpressionRef { return std::make_shared<ConstantValueExpression>(value); }
+
+auto Cmp(AbstractExpressionRef lhs, AbstractExpressionRef rhs, ComparisonType type) -> AbstractExpressionRef {
+  return std::make_shared<ComparisonExpression>(std::move(lhs), std::move(rhs), type);
+}
+
+auto Logic(AbstractExpressionRef lhs, AbstractExpressionRef rhs, LogicType type) -> AbstractExpressionRef {
+  return std::make_shared<LogicExpression>(std::move(lhs), std::move(rhs), type);
+}
+
+auto Arith(AbstractExpressionRef lhs, AbstractExpressionRef rhs, ArithmeticType type) -> AbstractExpressionRef {
+  return std::make_shared<ArithmeticExpression>(std::move(lhs), std::move(rhs), type);
+}
+
+/** @return whether two values are both null or equal */
+auto SameValue(const Value &lhs, const Value &rhs) -> bool {
+  if (lhs.IsNull() || rhs.IsNull()) {
+    return lhs.IsNull() && rhs.IsNull();
+  }
+  return lhs.GetTypeId() == rhs.GetTypeId() && lhs.CompareEquals(rhs) == CmpBool::CmpTrue;
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(ExpressionProgramTest, MatchesInterpreter) {
+  auto schema = MakeSchema();
+  // More tuples than one evaluation takes, and not a multiple of it.
+  auto tuples = MakeTuples(schema, ExpressionProgram::BATCH_SIZE * 2 + 17);
+
+  std::vector<AbstractExpressionRef> exprs;
+  for (auto type : {ComparisonType::Equal, ComparisonType::NotEqual, ComparisonType::LessThan,
+                    ComparisonType::LessThanOrEqual, ComparisonType::GreaterThan, ComparisonType::GreaterThanOrEqual}) {
+    // Same types, mixed numeric types, constants on either side, strings and booleans.
+    exprs.push_back(Cmp(Col(0, TypeId::INTEGER), Const(ValueFactory::GetIntegerValue(3)), type));
+    exprs.push_back(Cmp(Col(0, TypeId::INTEGER), Col(1, TypeId::BIGINT), type));
+    exprs.push_back(Cmp(Col(2, TypeId::DECIMAL), Col(0, TypeId::INTEGER), type));
+    exprs.push_back(Cmp(Const(ValueFactory::GetBigIntValue(-2)), Col(2, TypeId::DECIMAL), type));
+    exprs.push_back(Cmp(Col(3, TypeId::VARCHAR), Const(ValueFactory::GetVarcharValue("bb")), type));
+    exprs.push_back(Cmp(Col(4, TypeId::BOOLEAN), Const(ValueFactory::GetBooleanValue(true)), type));
+    exprs.push_back(Cmp(Col(4, TypeId::BOOLEAN), Col(4, TypeId::BOOLEAN), type));
+    exprs.push_back(Cmp(Col(5, TypeId::TIMESTAMP), Const(ValueFactory::GetTimestampValue(2)), type));
+    exprs.push_back(Cmp(Const(ValueFactory::GetDecimalValue(1.5)), Col(0, TypeId::INTEGER), type));
+    exprs.push_back(Cmp(Col(0, TypeId::INTEGER), Const(ValueFactory::GetNullValueByType(TypeId::INTEGER)), type));
+  }
+  auto a_pos = Cmp(Col(0, TypeId::INTEGER), Const(ValueFactory::GetIntegerValue(0)), ComparisonType::GreaterThan);
+  auto s_small = Cmp(Col(3, TypeId::VARCHAR), Const(ValueFactory::GetVarcharValue("b")), ComparisonType::LessThan);
+  for (auto type : {LogicType::And, LogicType::Or}) {
+    exprs.push_back(Logic(a_pos, s_small, type));
+    exprs.push_back(Logic(Col(4, TypeId::BOOLEAN), a_pos, type));
+    exprs.push_back(Logic(Const(ValueFactory::GetNullValueByType(TypeId::BOOLEAN)), s_small, type));
+  }
+  for (auto type : {ArithmeticType::Plus, ArithmeticType::Minus}) {
+    exprs.push_back(Arith(Col(0, TypeId::INTEGER), Const(ValueFactory::GetIntegerValue(7)), type));
+    exprs.push_back(Arith(Col(0, TypeId::INTEGER), Col(0, TypeId::INTEGER), type));
+    exprs.push_back(Arith(Col(1, TypeId::BIGINT), Const(ValueFactory::GetBigIntValue(-3)), type));
+    exprs.push_back(Arith(Const(ValueFactory::GetBigIntValue(100)), Col(1, TypeId::BIGINT), type));
+    exprs.push_back(Arith(Col(2, TypeId::DECIMAL), Col(2, TypeId::DECIMAL), type));
+    exprs.push_back(Arith(Const(ValueFactory::GetIntegerValue(BUSTUB_INT32_MAX)), Col(0, TypeId::INTEGER), type));
+  }
+  // Comparisons of computed values.
+  exprs.push_back(Cmp(Arith(Col(1, TypeId::BIGINT), Const(ValueFactory::GetBigIntValue(4)), ArithmeticType::Minus),
+                      Col(2, TypeId::DECIMAL), ComparisonType::GreaterThan));
+  // Columns and constants alone.
+  exprs.push_back(Col(3, TypeId::VARCHAR));
+  exprs.push_back(Col(2, TypeId::DECIMAL));
+  exprs.push_back(Const(ValueFactory::GetIntegerValue(5)));
+
+  auto program = ExpressionProgram::Compile(exprs, schema);
+  ASSERT_TRUE(program.has_value());
+  for (size_t start = 0; start < tuples.size(); start += ExpressionProgram::BATCH_SIZE) {
+    auto count = std::min(ExpressionProgram::BATCH_SIZE, tuples.size() - start);
+    program->Evaluate(&tuples[start], count);
+    for (size_t expr_idx = 0; expr_idx < exprs.size(); expr_idx++) {
+      for (size_t i = 0; i < count; i++) {
+        auto expected = exprs[expr_idx]->Evaluate(&tuples[start + i], schema);
+        auto actual = program->GetValue(expr_idx, i);
+        ASSERT_TRUE(SameValue(expected, actual))
+            << exprs[expr_idx]->ToString() << " on " << tuples[start + i].ToString(&schema) << ": expected "
+            << expected.ToString() << ", got " << actual.ToString();
+      }
+    }
+  }
+
+  // The predicate selects the tuples it is true on.
+  auto predicate = Logic(a_pos, Cmp(Col(1, TypeId::BIGINT), Col(2, TypeId::DECIMAL), ComparisonType::LessThan),
+                         LogicType::Or);
+  auto predicate_program = ExpressionProgram::CompilePredicate(predicate, schema);
+  ASSERT_TRUE(predicate_program.has_value());
+  std::vector<uint32_t> selection;
+  predicate_program->Select(tuples.data(), tuples.size(), nullptr, &selection);
+  std::vector<uint32_t> expected;
+  for (size_t i = 0; i < tuples.size(); i++) {
+    auto value = predicate->Evaluate(&tuples[i], schema);
+    if (!value.IsNull() && value.GetAs<bool>()) {
+      expected.push_back(i);
+    }
+  }
+  ASSERT_EQ(selection, expected);
+}
+
+// NOLINTNEXTLINE
+TEST(ExpressionProgramTest, JoinPredicate) {
+  auto schema = MakeSchema();
+  auto left_tuples = MakeTuples(schema, ExpressionProgram::BATCH_SIZE + 5);
+  auto right_tuples = MakeTuples(schema, 20);
+  // left.a = right.b and left.s >= right.s
+  auto predicate = Logic(Cmp(Col(0, TypeId::INTEGER, 0), Col(1, TypeId::BIGINT, 1), ComparisonType::Equal),
+                         Cmp(Col(3, TypeId::VARCHAR, 0), Col(3, TypeId::VARCHAR, 1), ComparisonType::GreaterThanOrEqual),
+                         LogicType::And);
+  auto program = ExpressionProgram::CompileJoin(predicate, schema, schema);
+  ASSERT_TRUE(program.has_value());
+  std::vector<uint32_t> selection;
+  size_t num_matches = 0;
+  for (const auto &right_tuple : right_tuples) {
+    program->Select(left_tuples.data(), left_tuples.size(), &right_tuple, &selection);
+    std::vector<uint32_t> expected;
+    for (size_t i = 0; i < left_tuples.size(); i++) {
+      auto value = predicate->EvaluateJoin(&left_tuples[i], schema, &right_tuple, schema);
+      if (!value.IsNull() && value.GetAs<bool>()) {
+        expected.push_back(i);
+      }
+    }
+    ASSERT_EQ(selection, expected);
+    num_matches += selection.size();
+  }
+  ASSERT_GT(num_matches, 0);
+}
+
+// NOLINTNEXTLINE
+TEST(ExpressionProgramTest, BigintOverflow) {
+  Schema schema{std::vector<Column>{{"b", TypeId::BIGINT}}};
+  std::vector<Tuple> tuples;
+  for (int64_t b : {int64_t{1}, BUSTUB_INT64_MAX - 1, int64_t{-5}}) {
+    tuples.emplace_back(std::vector<Value>{ValueFactory::GetBigIntValue(b)}, &schema);
+  }
+  tuples.emplace_back(std::vector<Value>{ValueFactory::GetNullValueByType(TypeId::BIGINT)}, &schema);
+  auto plus_one = Arith(Col(0, TypeId::BIGINT), Const(ValueFactory::GetBigIntValue(1)), ArithmeticType::Plus);
+  auto program = ExpressionProgram::Compile({plus_one}, schema);
+  ASSERT_TRUE(program.has_value());
+  program->Evaluate(tuples.data(), tuples.size());
+  ASSERT_EQ(program->GetValue(0, 1).GetAs<int64_t>(), BUSTUB_INT64_MAX);
+  ASSERT_TRUE(program->GetValue(0, 3).IsNull());
+
+  // The overflow fails the evaluation, as it fails Value::Add(). A null operand does not overflow.
+  auto plus_two = Arith(plus_one, Const(ValueFactory::GetBigIntValue(1)), ArithmeticType::Plus);
+  program = ExpressionProgram::Compile({plus_two}, schema);
+  ASSERT_TRUE(program.has_value());
+  ASSERT_THROW(plus_two->Evaluate(&tuples[1], schema), Exception);
+  ASSERT_THROW(program->Evaluate(tuples.data(), tuples.size()), Exception);
+  ASSERT_NO_THROW(program->Evaluate(&tuples[2], 2));
+  ASSERT_EQ(program->GetValue(0, 0).GetAs<int64_t>(), -3);
+  ASSERT_TRUE(program->GetValue(0, 1).IsNull());
+}
+
+// NOLINTNEXTLINE
+TEST(ExpressionProgramTest, Unsupported) {
+  auto schema = MakeSchema();
+  // String functions and comparisons through a cast to VARCHAR are left to the interpreter.
+  auto lower = std::make_shared<StringExpression>(Col(3, TypeId::VARCHAR), StringExpressionType::Lower);
+  ASSERT_FALSE(ExpressionProgram::Compile({Col(0, TypeId::INTEGER), lower}, schema).has_value());
+  ASSERT_FALSE(ExpressionProgram::Compile(
+                   {Cmp(Col(3, TypeId::VARCHAR), Const(ValueFactory::GetIntegerValue(1)), ComparisonType::Equal)},
+                   schema)
+                   .has_value());
+  // A predicate must be a boolean.
+  ASSERT_FALSE(ExpressionProgram::CompilePredicate(Col(0, TypeId::INTEGER), schema).has_value());
+  ASSERT_TRUE(ExpressionProgram::CompilePredicate(Col(4, TypeId::BOOLEAN), schema).has_value());
+}
+
+}  // namespace bustub
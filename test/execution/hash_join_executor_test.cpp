@@ -0,0 +1,190 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hash_join_executor_test.cpp
+//
+// Identification: test/execution/hash_join_executor_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "execution/executor_context.h"
+#include "execution/executors/hash_join_executor.h"
+#include "execution/executors/mock_scan_executor.h"
+#include "execution/executors/values_executor.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/mock_scan_plan.h"
+#include "execution/plans/values_plan.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** Forward everything to a child executor, counting the tuples it produces */
+class CountingExecutor : public AbstractExecutor {
+ public:
+  CountingExecutor(ExecutorContext *exec_ctx, std::unique_ptr<AbstractExecutor> &&child, size_t *count)
+      : AbstractExecutor(exec_ctx), child_(std::move(child)), count_(count) {}
+
+  void Init() override { child_->Init(); }
+
+  auto Next(Tuple *tuple, RID *rid) -> bool override {
+    if (!child_->Next(tuple, rid)) {
+      return false;
+    }
+    (*count_)++;
+    return true;
+  }
+
+  auto PushDownRuntimeFilter(const RuntimeFilterRef &filter) -> bool override {
+    return child_->PushDownRuntimeFilter(filter);
+  }
+
+  auto GetOutputSchema() const -> const Schema & override { return child_->GetOutputSchema(); }
+
+ private:
+  std::unique_ptr<AbstractExecutor> child_;
+  size_t *count_;
+};
+
+auto KeyOf(uint32_t column_idx) -> std::vector<AbstractExpressionRef> {
+  return {std::make_shared<ColumnValueExpression>(0, column_idx, TypeId::INTEGER)};
+}
+
+/** @return a values plan producing one integer column holding the keys */
+auto MakeValuesPlan(const std::vector<int32_t> &keys) -> std::shared_ptr<ValuesPlanNode> {
+  auto schema = std::make_shared<Schema>(std::vector<Column>{{"k", TypeId::INTEGER}});
+  std::vector<std::vector<AbstractExpressionRef>> rows;
+  for (auto key : keys) {
+    rows.push_back({std::make_shared<ConstantValueExpression>(ValueFactory::GetIntegerValue(key))});
+  }
+  return std::make_shared<ValuesPlanNode>(schema, std::move(rows));
+}
+
+/** @return the join of two plans on their first columns */
+auto MakeJoinPlan(const AbstractPlanNodeRef &left, const AbstractPlanNodeRef &right, JoinType join_type)
+    -> std::shared_ptr<HashJoinPlanNode> {
+  std::vector<Column> columns = left->OutputSchema().GetColumns();
+  for (const auto &column : right->OutputSchema().GetColumns()) {
+    columns.push_back(column);
+  }
+  return std::make_shared<HashJoinPlanNode>(std::make_shared<Schema>(columns), left, right, KeyOf(0), KeyOf(0),
+                                            join_type);
+}
+
+/**
+ * Join __mock_table_1, whose colA counts up from 0 to 99, with a set of keys.
+ * @param[out] num_read the number of tuples the mock scan let through to the join
+ * @return the number of output tuples
+ */
+auto RunJoin(ExecutorContext *exec_ctx, const std::vector<int32_t> &keys, JoinType join_type, size_t *num_read)
+    -> size_t {
+  auto scan_plan =
+      std::make_shared<MockScanPlanNode>(std::make_shared<Schema>(GetMockTableSchemaOf("__mock_table_1")),
+                                         "__mock_table_1");
+  auto values_plan = MakeValuesPlan(keys);
+  auto plan = MakeJoinPlan(scan_plan, values_plan, join_type);
+
+  *num_read = 0;
+  auto scan = std::make_unique<MockScanExecutor>(exec_ctx, scan_plan.get());
+  HashJoinExecutor executor{exec_ctx, plan.get(),
+                            std::make_unique<CountingExecutor>(exec_ctx, std::move(scan), num_read),
+                            std::make_unique<ValuesExecutor>(exec_ctx, values_plan.get())};
+  executor.Init();
+  size_t num_output = 0;
+  TupleBatch batch{};
+  while (executor.NextBatch(&batch)) {
+    num_output += batch.Size();
+  }
+  return num_output;
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(HashJoinExecutorTest, JoinKeyFilterDropsProbeTuples) {
+  ExecutorContext exec_ctx{nullptr, nullptr, nullptr, nullptr, nullptr, false};
+  size_t num_read;
+  // Only the probe tuples with a match reach the join.
+  ASSERT_EQ(RunJoin(&exec_ctx, {3, 50, 77, 200, -8}, JoinType::INNER, &num_read), 3);
+  ASSERT_EQ(num_read, 3);
+
+  // An empty build side drops everything.
+  ASSERT_EQ(RunJoin(&exec_ctx, {}, JoinType::INNER, &num_read), 0);
+  ASSERT_EQ(num_read, 0);
+
+  // A left join keeps the probe tuples without a match.
+  ASSERT_EQ(RunJoin(&exec_ctx, {3, 50, 77, 200, -8}, JoinType::LEFT, &num_read), 100);
+  ASSERT_EQ(num_read, 100);
+}
+
+// NOLINTNEXTLINE
+TEST(HashJoinExecutorTest, JoinKeyFilterWithSpilledBuild) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(16, disk_manager.get());
+  ExecutorContext exec_ctx{nullptr, nullptr, bpm.get(), nullptr, nullptr, false};
+  // Every build partition spills, the filter still covers all of them.
+  exec_ctx.SetMemoryBudget(1);
+  std::vector<int32_t> keys;
+  for (int32_t key = 0; key < 100; key += 3) {
+    keys.push_back(key);
+    keys.push_back(key);
+  }
+  size_t num_read;
+  ASSERT_EQ(RunJoin(&exec_ctx, keys, JoinType::INNER, &num_read), 68);
+  ASSERT_EQ(num_read, 34);
+}
+
+// NOLINTNEXTLINE
+TEST(HashJoinExecutorTest, FilterThroughProbeSideJoin) {
+  // join(join(__mock_table_1, [0, 50)), [40, 60)) on colA: the outer join pushes its filter through the inner one.
+  ExecutorContext exec_ctx{nullptr, nullptr, nullptr, nullptr, nullptr, false};
+  std::vector<int32_t> inner_keys;
+  std::vector<int32_t> outer_keys;
+  for (int32_t key = 0; key < 60; key++) {
+    (key < 50 ? inner_keys : outer_keys).push_back(key);
+    if (key >= 40 && key < 50) {
+      outer_keys.push_back(key);
+    }
+  }
+  auto scan_plan =
+      std::make_shared<MockScanPlanNode>(std::make_shared<Schema>(GetMockTableSchemaOf("__mock_table_1")),
+                                         "__mock_table_1");
+  auto inner_values_plan = MakeValuesPlan(inner_keys);
+  auto inner_plan = MakeJoinPlan(scan_plan, inner_values_plan, JoinType::INNER);
+  auto outer_values_plan = MakeValuesPlan(outer_keys);
+  auto outer_plan = MakeJoinPlan(inner_plan, outer_values_plan, JoinType::INNER);
+
+  size_t num_read = 0;
+  auto scan = std::make_unique<CountingExecutor>(
+      &exec_ctx, std::make_unique<MockScanExecutor>(&exec_ctx, scan_plan.get()), &num_read);
+  auto inner = std::make_unique<HashJoinExecutor>(&exec_ctx, inner_plan.get(), std::move(scan),
+                                                  std::make_unique<ValuesExecutor>(&exec_ctx, inner_values_plan.get()));
+  HashJoinExecutor outer{&exec_ctx, outer_plan.get(), std::move(inner),
+                         std::make_unique<ValuesExecutor>(&exec_ctx, outer_values_plan.get())};
+  outer.Init();
+  std::vector<int32_t> output;
+  Tuple tuple;
+  RID rid;
+  while (outer.Next(&tuple, &rid)) {
+    output.push_back(tuple.GetValue(&outer_plan->OutputSchema(), 0).GetAs<int32_t>());
+  }
+  std::sort(output.begin(), output.end());
+  ASSERT_EQ(output, (std::vector<int32_t>{40, 41, 42, 43, 44, 45, 46, 47, 48, 49}));
+  ASSERT_EQ(num_read, 10);
+}
+
+}  // namespace bustub
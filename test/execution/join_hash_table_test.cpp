@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// join_hash_table_test.cpp
+//
+// Identification: test/execution/join_hash_table_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/join_hash_table.h"
+#include "execution/task_scheduler.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(JoinHashTableTest, PartitionedBuild) {
+  Schema schema{std::vector<Column>{{"key", TypeId::INTEGER}, {"payload", TypeId::INTEGER}}};
+  std::vector<AbstractExpressionRef> key_exprs{std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER)};
+
+  // 100000 tuples over 25000 distinct keys, every 1000th key is null.
+  const int num_tuples = 100000;
+  const int num_keys = 25000;
+  std::vector<Tuple> tuples;
+  for (int i = 0; i < num_tuples; i++) {
+    auto key = i % num_keys;
+    tuples.emplace_back(std::vector<Value>{key % 1000 == 999 ? ValueFactory::GetNullValueByType(TypeId::INTEGER)
+                                                             : ValueFactory::GetIntegerValue(key),
+                                           ValueFactory::GetIntegerValue(i)},
+                        &schema);
+  }
+
+  TaskScheduler scheduler{4};
+  PartitionedJoinHashTable parallel_table{key_exprs, &schema};
+  parallel_table.Build(tuples, &scheduler);
+  PartitionedJoinHashTable serial_table{key_exprs, &schema};
+  serial_table.Build(tuples, nullptr);
+
+  EXPECT_GT(parallel_table.GetPartitionCount(), 1);
+  EXPECT_EQ(num_tuples - num_tuples / 1000, parallel_table.Size());
+  EXPECT_EQ(parallel_table.Size(), serial_table.Size());
+
+  for (int key = 0; key < num_keys + 10; key++) {
+    std::vector<Value> probe_key{ValueFactory::GetIntegerValue(key)};
+    auto hash = PartitionedJoinHashTable::HashKey(probe_key);
+    ASSERT_TRUE(hash.has_value());
+    std::vector<const Tuple *> parallel_matches;
+    std::vector<const Tuple *> serial_matches;
+    parallel_table.Probe(probe_key, *hash, &parallel_matches);
+    serial_table.Probe(probe_key, *hash, &serial_matches);
+
+    size_t expected = key >= num_keys || key % 1000 == 999 ? 0 : num_tuples / num_keys;
+    ASSERT_EQ(expected, parallel_matches.size()) << "key " << key;
+    ASSERT_EQ(expected, serial_matches.size()) << "key " << key;
+    // Matches come back in build order.
+    for (size_t i = 0; i < expected; i++) {
+      EXPECT_EQ(key + static_cast<int>(i) * num_keys, parallel_matches[i]->GetValue(&schema, 1).GetAs<int32_t>());
+      EXPECT_EQ(key + static_cast<int>(i) * num_keys, serial_matches[i]->GetValue(&schema, 1).GetAs<int32_t>());
+    }
+  }
+
+  // Null keys match nothing.
+  EXPECT_FALSE(PartitionedJoinHashTable::HashKey({ValueFactory::GetNullValueByType(TypeId::INTEGER)}).has_value());
+}
+
+}  // namespace bustub
@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// loser_tree_test.cpp
+//
+// Identification: test/execution/loser_tree_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <climits>
+#include <random>
+#include <vector>
+
+#include "execution/loser_tree.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(LoserTreeTest, MergeSortedRuns) {
+  std::mt19937 rng(15445);
+  for (size_t num_runs : {1, 2, 3, 7, 16, 33}) {
+    std::vector<std::vector<int>> runs(num_runs);
+    std::vector<int> expected;
+    for (auto &run : runs) {
+      // Some runs are empty.
+      auto size = rng() % 50;
+      for (size_t i = 0; i < size; i++) {
+        run.push_back(static_cast<int>(rng() % 100));
+      }
+      std::sort(run.begin(), run.end());
+      expected.insert(expected.end(), run.begin(), run.end());
+    }
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<size_t> positions(num_runs, 0);
+    auto head = [&](size_t run) { return positions[run] < runs[run].size() ? runs[run][positions[run]] : INT_MAX; };
+    auto less = [&](size_t lhs, size_t rhs) { return head(lhs) < head(rhs) || (head(lhs) == head(rhs) && lhs < rhs); };
+    LoserTree<decltype(less)> tree{num_runs, less};
+
+    std::vector<int> merged;
+    while (positions[tree.Top()] < runs[tree.Top()].size()) {
+      merged.push_back(head(tree.Top()));
+      positions[tree.Top()]++;
+      tree.Replay();
+    }
+    ASSERT_EQ(expected, merged) << num_runs << " runs";
+  }
+}
+
+}  // namespace bustub
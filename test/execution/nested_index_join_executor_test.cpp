@@ -0,0 +1,146 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// nested_index_join_executor_test.cpp
+//
+// Identification: test/execution/nested_index_join_executor_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "catalog/catalog.h"
+#include "concurrency/lock_manager.h"
+#include "concurrency/transaction_manager.h"
+#include "execution/executor_context.h"
+#include "execution/executors/nested_index_join_executor.h"
+#include "execution/executors/values_executor.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/plans/nested_index_join_plan.h"
+#include "execution/plans/values_plan.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** The inner table holds (k, 10 * k) for k in [0, NUM_INNER_ROWS), and is indexed on k. */
+constexpr int NUM_INNER_ROWS = 2000;
+
+/** @return the outer join keys: many batches of them, unsorted, with duplicates, misses and nulls */
+auto MakeOuterKeys() -> std::vector<std::optional<int32_t>> {
+  std::vector<std::optional<int32_t>> keys;
+  for (int i = 0; i < 3000; i++) {
+    if (i % 100 == 7) {
+      keys.emplace_back(std::nullopt);
+    } else {
+      keys.emplace_back(i * 7919 % 2500);
+    }
+  }
+  return keys;
+}
+
+/** Join the outer keys with the inner table, checking every output row against the key it came from. */
+void CheckJoin(ExecutorContext *exec_ctx, const TableInfo *table_info, const IndexInfo *index_info,
+               JoinType join_type) {
+  auto outer_schema = std::make_shared<Schema>(std::vector<Column>{{"a", TypeId::INTEGER}});
+  auto output_schema = std::make_shared<Schema>(
+      std::vector<Column>{{"a", TypeId::INTEGER}, {"k", TypeId::INTEGER}, {"v", TypeId::INTEGER}});
+  auto keys = MakeOuterKeys();
+  std::vector<std::vector<AbstractExpressionRef>> rows;
+  for (const auto &key : keys) {
+    auto value = key.has_value() ? ValueFactory::GetIntegerValue(*key) : ValueFactory::GetNullValueByType(TypeId::INTEGER);
+    rows.push_back({std::make_shared<ConstantValueExpression>(value)});
+  }
+  auto values_plan = std::make_shared<ValuesPlanNode>(outer_schema, std::move(rows));
+  NestedIndexJoinPlanNode plan{output_schema,
+                               values_plan,
+                               std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER),
+                               table_info->oid_,
+                               index_info->index_oid_,
+                               index_info->name_,
+                               table_info->name_,
+                               std::make_shared<Schema>(table_info->schema_),
+                               join_type};
+  NestIndexJoinExecutor executor{exec_ctx, &plan, std::make_unique<ValuesExecutor>(exec_ctx, values_plan.get())};
+  executor.Init();
+
+  // Each outer key matches at most one inner row, so the output follows the order of the outer keys.
+  size_t next_key = 0;
+  // An inner join drops the outer keys without a match.
+  auto skip_unmatched = [&]() {
+    while (next_key < keys.size() && join_type == JoinType::INNER &&
+           (!keys[next_key].has_value() || *keys[next_key] >= NUM_INNER_ROWS)) {
+      next_key++;
+    }
+  };
+  TupleBatch batch{BUSTUB_BATCH_SIZE};
+  while (executor.NextBatch(&batch)) {
+    for (size_t i = 0; i < batch.Size(); i++) {
+      skip_unmatched();
+      ASSERT_LT(next_key, keys.size());
+      const auto &key = keys[next_key++];
+      const auto &tuple = batch.GetTuple(i);
+      auto a = tuple.GetValue(output_schema.get(), 0);
+      auto k = tuple.GetValue(output_schema.get(), 1);
+      auto v = tuple.GetValue(output_schema.get(), 2);
+      if (!key.has_value()) {
+        ASSERT_TRUE(a.IsNull());
+        ASSERT_TRUE(k.IsNull());
+        ASSERT_TRUE(v.IsNull());
+      } else if (*key >= NUM_INNER_ROWS) {
+        ASSERT_EQ(a.GetAs<int32_t>(), *key);
+        ASSERT_TRUE(k.IsNull());
+        ASSERT_TRUE(v.IsNull());
+      } else {
+        ASSERT_EQ(a.GetAs<int32_t>(), *key);
+        ASSERT_EQ(k.GetAs<int32_t>(), *key);
+        ASSERT_EQ(v.GetAs<int32_t>(), *key * 10);
+      }
+    }
+  }
+  skip_unmatched();
+  ASSERT_EQ(next_key, keys.size());
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(NestedIndexJoinExecutorTest, BatchedLookups) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager.get());
+  LockManager lock_manager;
+  TransactionManager txn_manager{&lock_manager};
+  Catalog catalog{bpm.get(), &lock_manager, nullptr};
+  auto *txn = txn_manager.Begin();
+  ExecutorContext exec_ctx{txn, &catalog, bpm.get(), &txn_manager, &lock_manager, false};
+  Schema schema{std::vector<Column>{{"k", TypeId::INTEGER}, {"v", TypeId::INTEGER}}};
+
+  auto *table_info = catalog.CreateTable(txn, "t", schema);
+  for (int i = 0; i < NUM_INNER_ROWS; i++) {
+    Tuple tuple{{ValueFactory::GetIntegerValue(i), ValueFactory::GetIntegerValue(i * 10)}, &schema};
+    table_info->table_->InsertTuple({INVALID_TXN_ID, INVALID_TXN_ID, false}, tuple);
+  }
+  // The index is built from the rows already in the table, and spans many leaves.
+  auto key_schema = Schema::CopySchema(&schema, {0});
+  auto *index_info = catalog.CreateIndex<IntegerKeyType, IntegerValueType, IntegerComparatorType>(
+      txn, "t_k", "t", schema, key_schema, {0}, TWO_INTEGER_SIZE, IntegerHashFunctionType{});
+  ASSERT_NE(index_info, nullptr);
+
+  CheckJoin(&exec_ctx, table_info, index_info, JoinType::INNER);
+  CheckJoin(&exec_ctx, table_info, index_info, JoinType::LEFT);
+  delete txn;
+}
+
+}  // namespace bustub
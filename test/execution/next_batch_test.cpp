@@ -0,0 +1,212 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// next_batch_test.cpp
+//
+// Identification: test/execution/next_batch_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/aggregation_executor.h"
+#include "execution/executors/filter_executor.h"
+#include "execution/executors/hash_join_executor.h"
+#include "execution/executors/mock_scan_executor.h"
+#include "execution/executors/projection_executor.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/mock_scan_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** Produce the integers [0, size) through Next() only, so that its batches go through the default adapter */
+class CountingExecutor : public AbstractExecutor {
+ public:
+  CountingExecutor(ExecutorContext *exec_ctx, const Schema *schema, int32_t size)
+      : AbstractExecutor(exec_ctx), schema_(schema), size_(size) {}
+
+  void Init() override { cursor_ = 0; }
+
+  auto Next(Tuple *tuple, RID *rid) -> bool override {
+    if (cursor_ == size_) {
+      return false;
+    }
+    *tuple = Tuple{{ValueFactory::GetIntegerValue(cursor_++)}, schema_};
+    *rid = RID{};
+    return true;
+  }
+
+  auto GetOutputSchema() const -> const Schema & override { return *schema_; }
+
+ private:
+  const Schema *schema_;
+  int32_t size_;
+  int32_t cursor_{0};
+};
+
+/**
+ * Drain an executor with batches of the given capacity, checking that every batch but the last, empty one has at
+ * least one and at most `capacity` tuples.
+ * @return the first column of the tuples, in order
+ */
+auto DrainBatches(AbstractExecutor *executor, size_t capacity) -> std::vector<int32_t> {
+  std::vector<int32_t> values;
+  TupleBatch batch{capacity};
+  executor->Init();
+  while (executor->NextBatch(&batch)) {
+    EXPECT_FALSE(batch.IsEmpty());
+    EXPECT_LE(batch.Size(), capacity);
+    for (size_t i = 0; i < batch.Size(); i++) {
+      values.push_back(batch.GetTuple(i).GetValue(&executor->GetOutputSchema(), 0).GetAs<int32_t>());
+    }
+  }
+  // The end of the stream is an empty batch, and stays so.
+  EXPECT_TRUE(batch.IsEmpty());
+  EXPECT_FALSE(executor->NextBatch(&batch));
+  EXPECT_TRUE(batch.IsEmpty());
+  return values;
+}
+
+auto Range(int32_t begin, int32_t end) -> std::vector<int32_t> {
+  std::vector<int32_t> values;
+  for (int32_t i = begin; i < end; i++) {
+    values.push_back(i);
+  }
+  return values;
+}
+
+/** __mock_table_1 has 100 rows (colA, colB) = (i, 100 * i) */
+auto MockTable1() -> std::shared_ptr<MockScanPlanNode> {
+  return std::make_shared<MockScanPlanNode>(std::make_shared<Schema>(GetMockTableSchemaOf("__mock_table_1")),
+                                            "__mock_table_1");
+}
+
+/** @return the predicate `colA <comparison> value` */
+auto CompareColA(ComparisonType comparison, int32_t value) -> AbstractExpressionRef {
+  return std::make_shared<ComparisonExpression>(std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER),
+                                                std::make_shared<ConstantValueExpression>(
+                                                    ValueFactory::GetIntegerValue(value)),
+                                                comparison);
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(NextBatchTest, DefaultAdapter) {
+  ExecutorContext exec_ctx{nullptr, nullptr, nullptr, nullptr, nullptr, false};
+  Schema schema{std::vector<Column>{{"a", TypeId::INTEGER}}};
+  // A last partial batch, a last full batch, a single batch and no batch at all.
+  for (int32_t size : {10, 8, 3, 0}) {
+    CountingExecutor executor{&exec_ctx, &schema, size};
+    ASSERT_EQ(DrainBatches(&executor, 4), Range(0, size));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(NextBatchTest, Filter) {
+  ExecutorContext exec_ctx{nullptr, nullptr, nullptr, nullptr, nullptr, false};
+  auto scan_plan = MockTable1();
+  auto run_filter = [&](const AbstractExpressionRef &predicate, size_t capacity) {
+    FilterPlanNode plan{scan_plan->output_schema_, predicate, scan_plan};
+    FilterExecutor executor{&exec_ctx, &plan, std::make_unique<MockScanExecutor>(&exec_ctx, scan_plan.get())};
+    return DrainBatches(&executor, capacity);
+  };
+
+  // The child batches before the last rows are filtered out whole: the filter pulls the next ones instead of
+  // returning an empty batch before the end.
+  ASSERT_EQ(run_filter(CompareColA(ComparisonType::GreaterThanOrEqual, 95), 7), Range(95, 100));
+  ASSERT_EQ(run_filter(CompareColA(ComparisonType::LessThan, 50), 7), Range(0, 50));
+  ASSERT_EQ(run_filter(CompareColA(ComparisonType::LessThan, 0), 7), Range(0, 0));
+  auto expected = Range(0, 100);
+  expected.erase(expected.begin() + 50);
+  ASSERT_EQ(run_filter(CompareColA(ComparisonType::NotEqual, 50), 1), expected);
+}
+
+// NOLINTNEXTLINE
+TEST(NextBatchTest, Projection) {
+  ExecutorContext exec_ctx{nullptr, nullptr, nullptr, nullptr, nullptr, false};
+  auto scan_plan = MockTable1();
+  // Project (colB, colA): the batches of the projection have the capacity of the batches asked for.
+  auto output_schema = std::make_shared<Schema>(std::vector<Column>{{"b", TypeId::INTEGER}, {"a", TypeId::INTEGER}});
+  auto col_b = std::make_shared<ColumnValueExpression>(0, 1, TypeId::INTEGER);
+  auto col_a = std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER);
+  ProjectionPlanNode plan{output_schema, {col_b, col_a}, scan_plan};
+  for (size_t capacity : {1, 7, 100, 1000}) {
+    ProjectionExecutor executor{&exec_ctx, &plan, std::make_unique<MockScanExecutor>(&exec_ctx, scan_plan.get())};
+    std::vector<int32_t> expected;
+    for (int32_t i = 0; i < 100; i++) {
+      expected.push_back(100 * i);
+    }
+    ASSERT_EQ(DrainBatches(&executor, capacity), expected);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(NextBatchTest, HashJoin) {
+  ExecutorContext exec_ctx{nullptr, nullptr, nullptr, nullptr, nullptr, false};
+  auto left_plan = MockTable1();
+  auto right_plan = std::make_shared<MockScanPlanNode>(
+      std::make_shared<Schema>(GetMockTableSchemaOf("__mock_table_123")), "__mock_table_123");
+  auto output_schema = std::make_shared<Schema>(
+      std::vector<Column>{{"colA", TypeId::INTEGER}, {"colB", TypeId::INTEGER}, {"number", TypeId::INTEGER}});
+  // __mock_table_123 has the rows 1, 2 and 3, so that an inner join on colA = number has 3 rows, a left join 100.
+  for (auto join_type : {JoinType::INNER, JoinType::LEFT}) {
+    HashJoinPlanNode plan{output_schema,
+                          left_plan,
+                          right_plan,
+                          {std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER)},
+                          {std::make_shared<ColumnValueExpression>(1, 0, TypeId::INTEGER)},
+                          join_type};
+    for (size_t capacity : {1, 2, 7}) {
+      HashJoinExecutor executor{&exec_ctx, &plan, std::make_unique<MockScanExecutor>(&exec_ctx, left_plan.get()),
+                                std::make_unique<MockScanExecutor>(&exec_ctx, right_plan.get())};
+      ASSERT_EQ(DrainBatches(&executor, capacity), join_type == JoinType::INNER ? Range(1, 4) : Range(0, 100));
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(NextBatchTest, Aggregation) {
+  ExecutorContext exec_ctx{nullptr, nullptr, nullptr, nullptr, nullptr, false};
+  auto scan_plan = MockTable1();
+  auto col_a = std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER);
+  auto output_schema =
+      std::make_shared<Schema>(std::vector<Column>{{"colA", TypeId::INTEGER}, {"count", TypeId::INTEGER}});
+  // One group per row of the input, emitted in batches of the capacity asked for.
+  AggregationPlanNode plan{output_schema, scan_plan, {col_a}, {col_a}, {AggregationType::CountStarAggregate}};
+  for (size_t capacity : {1, 7, 1000}) {
+    AggregationExecutor executor{&exec_ctx, &plan, std::make_unique<MockScanExecutor>(&exec_ctx, scan_plan.get())};
+    auto groups = DrainBatches(&executor, capacity);
+    std::sort(groups.begin(), groups.end());
+    ASSERT_EQ(groups, Range(0, 100));
+  }
+
+  // Without group-bys, an empty input still produces one row.
+  auto count_schema = std::make_shared<Schema>(std::vector<Column>{{"count", TypeId::INTEGER}});
+  FilterPlanNode filter_plan{scan_plan->output_schema_, CompareColA(ComparisonType::LessThan, 0), scan_plan};
+  AggregationPlanNode count_plan{count_schema, scan_plan, {}, {col_a}, {AggregationType::CountStarAggregate}};
+  AggregationExecutor executor{
+      &exec_ctx, &count_plan,
+      std::make_unique<FilterExecutor>(&exec_ctx, &filter_plan,
+                                       std::make_unique<MockScanExecutor>(&exec_ctx, scan_plan.get()))};
+  ASSERT_EQ(DrainBatches(&executor, 7), std::vector<int32_t>{0});
+}
+
+}  // namespace bustub
@@ -0,0 +1,140 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// seq_scan_executor_test.cpp
+//
+// Identification: test/execution/seq_scan_executor_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "catalog/catalog.h"
+#include "concurrency/lock_manager.h"
+#include "concurrency/transaction_manager.h"
+#include "execution/executor_context.h"
+#include "execution/executors/seq_scan_executor.h"
+#include "execution/executors/topn_executor.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/topn_plan.h"
+#include "execution/task_scheduler.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** Scan a table whose rows are (i, -i, ...) for i in [0, num_rows), checking that the rows come in order. */
+void CheckScan(ExecutorContext *exec_ctx, const TableInfo *table_info, int num_rows) {
+  const auto &schema = table_info->schema_;
+  SeqScanPlanNode plan{std::make_shared<Schema>(schema), table_info->oid_, table_info->name_};
+  SeqScanExecutor executor{exec_ctx, &plan};
+  executor.Init();
+  TupleBatch batch{BUSTUB_BATCH_SIZE};
+  int expected = 0;
+  while (executor.NextBatch(&batch)) {
+    for (size_t i = 0; i < batch.Size(); i++) {
+      ASSERT_EQ(batch.GetTuple(i).GetValue(&schema, 0).GetAs<int32_t>(), expected);
+      ASSERT_EQ(batch.GetTuple(i).GetValue(&schema, 1).GetAs<int32_t>(), -expected);
+      expected++;
+    }
+  }
+  ASSERT_EQ(expected, num_rows);
+}
+
+/** Forward everything to a child executor, counting the tuples it produces */
+class CountingExecutor : public AbstractExecutor {
+ public:
+  CountingExecutor(ExecutorContext *exec_ctx, std::unique_ptr<AbstractExecutor> &&child, size_t *count)
+      : AbstractExecutor(exec_ctx), child_(std::move(child)), count_(count) {}
+
+  void Init() override { child_->Init(); }
+
+  auto Next(Tuple *tuple, RID *rid) -> bool override {
+    if (!child_->Next(tuple, rid)) {
+      return false;
+    }
+    (*count_)++;
+    return true;
+  }
+
+  auto PushDownRuntimeFilter(const RuntimeFilterRef &filter) -> bool override {
+    return child_->PushDownRuntimeFilter(filter);
+  }
+
+  auto GetOutputSchema() const -> const Schema & override { return child_->GetOutputSchema(); }
+
+ private:
+  std::unique_ptr<AbstractExecutor> child_;
+  size_t *count_;
+};
+
+/**
+ * Run a top 5 on the first column of a table whose rows are (i, -i, ...) for i in [0, num_rows).
+ * @return the number of tuples the scan let through to the top-n
+ */
+auto RunTopN(ExecutorContext *exec_ctx, const TableInfo *table_info) -> size_t {
+  auto schema = std::make_shared<Schema>(table_info->schema_);
+  auto scan_plan = std::make_shared<SeqScanPlanNode>(schema, table_info->oid_, table_info->name_);
+  OrderBys order_bys{{OrderByType::ASC, std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER)}};
+  TopNPlanNode topn_plan{schema, scan_plan, order_bys, 5};
+  size_t num_read = 0;
+  TopNExecutor topn{exec_ctx, &topn_plan,
+                    std::make_unique<CountingExecutor>(
+                        exec_ctx, std::make_unique<SeqScanExecutor>(exec_ctx, scan_plan.get()), &num_read)};
+  topn.Init();
+  Tuple tuple;
+  RID rid;
+  for (int32_t i = 0; i < 5; i++) {
+    EXPECT_TRUE(topn.Next(&tuple, &rid));
+    EXPECT_EQ(tuple.GetValue(schema.get(), 0).GetAs<int32_t>(), i);
+  }
+  EXPECT_FALSE(topn.Next(&tuple, &rid));
+  return num_read;
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(SeqScanExecutorTest, ParallelScan) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(32, disk_manager.get());
+  LockManager lock_manager;
+  TransactionManager txn_manager{&lock_manager};
+  Catalog catalog{bpm.get(), &lock_manager, nullptr};
+  TaskScheduler scheduler{3};
+  auto *txn = txn_manager.Begin();
+  ExecutorContext exec_ctx{txn, &catalog, bpm.get(), &txn_manager, &lock_manager, false, &scheduler};
+  Schema schema{std::vector<Column>{{"a", TypeId::INTEGER}, {"b", TypeId::INTEGER}, {"c", TypeId::VARCHAR, 128}}};
+
+  // About 30 rows per page, so that the table spans many morsels, and a few more waves of one morsel per slot.
+  const int num_rows = 30 * MORSEL_SIZE_IN_PAGES * 10;
+  auto *table_info = catalog.CreateTable(txn, "t", schema);
+  for (int i = 0; i < num_rows; i++) {
+    Tuple tuple{{ValueFactory::GetIntegerValue(i), ValueFactory::GetIntegerValue(-i),
+                 ValueFactory::GetVarcharValue(std::string(120, 'x'))},
+                &schema};
+    table_info->table_->InsertTuple({INVALID_TXN_ID, INVALID_TXN_ID, false}, tuple);
+  }
+  ASSERT_GT(table_info->table_->MakeMorsels().size(), scheduler.GetSlotCount());
+  CheckScan(&exec_ctx, table_info, num_rows);
+
+  // The boundary of a top-n is checked while the morsels are read: only the first wave passes it whole.
+  ASSERT_LT(RunTopN(&exec_ctx, table_info), num_rows / 2);
+
+  // A serial scan only lets through the batch read before the top-n had its first 5 tuples.
+  ExecutorContext serial_exec_ctx{txn, &catalog, bpm.get(), &txn_manager, &lock_manager, false};
+  ASSERT_LE(RunTopN(&serial_exec_ctx, table_info), BUSTUB_BATCH_SIZE);
+  delete txn;
+}
+
+}  // namespace bustub
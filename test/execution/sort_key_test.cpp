@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key_test.cpp
+//
+// Identification: test/execution/sort_key_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/sort_key.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+auto RandomValue(TypeId type, std::mt19937 *rng) -> Value {
+  if ((*rng)() % 8 == 0) {
+    return ValueFactory::GetNullValueByType(type);
+  }
+  switch (type) {
+    case TypeId::INTEGER:
+      return ValueFactory::GetIntegerValue(static_cast<int32_t>((*rng)() % 21) - 10);
+    case TypeId::BIGINT:
+      return ValueFactory::GetBigIntValue(static_cast<int64_t>((*rng)() % 5) * 3000000000LL - 6000000000LL);
+    case TypeId::DECIMAL:
+      return ValueFactory::GetDecimalValue((static_cast<double>((*rng)() % 11) - 5) / 4);
+    case TypeId::BOOLEAN:
+      return ValueFactory::GetBooleanValue((*rng)() % 2 == 0);
+    default:
+      // Short strings sharing prefixes, and long ones that get truncated.
+      return ValueFactory::GetVarcharValue(std::string((*rng)() % 3, 'a') + std::string((*rng)() % 40, 'b') +
+                                           std::to_string((*rng)() % 3));
+  }
+}
+
+/** Check that normalized keys order like the keys, on random keys of the given column types. */
+void CheckNormalizedOrder(const std::vector<TypeId> &types, bool expect_exact) {
+  std::mt19937 rng(15445);
+  OrderBys order_bys;
+  for (size_t i = 0; i < types.size(); i++) {
+    order_bys.emplace_back(i % 2 == 0 ? OrderByType::ASC : OrderByType::DESC,
+                           std::make_shared<ColumnValueExpression>(0, i, types[i]));
+  }
+  SortKeyComparator comparator{order_bys};
+  SortKeyNormalizer normalizer{order_bys};
+  ASSERT_EQ(expect_exact, normalizer.IsExact());
+
+  for (int i = 0; i < 2000; i++) {
+    std::vector<Value> lhs;
+    std::vector<Value> rhs;
+    for (auto type : types) {
+      lhs.push_back(RandomValue(type, &rng));
+      rhs.push_back(RandomValue(type, &rng));
+    }
+    NormalizedSortKey lhs_normalized;
+    NormalizedSortKey rhs_normalized;
+    normalizer.Normalize(lhs, &lhs_normalized);
+    normalizer.Normalize(rhs, &rhs_normalized);
+
+    auto cmp = comparator.Compare(lhs, rhs);
+    auto normalized_cmp = lhs_normalized.Compare(rhs_normalized);
+    if (normalized_cmp != 0 || normalizer.IsExact()) {
+      ASSERT_EQ(cmp < 0, normalized_cmp < 0);
+      ASSERT_EQ(cmp > 0, normalized_cmp > 0);
+    }
+  }
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(SortKeyTest, NormalizedKeyOrder) {
+  CheckNormalizedOrder({TypeId::INTEGER, TypeId::DECIMAL, TypeId::BOOLEAN}, true);
+  CheckNormalizedOrder({TypeId::BIGINT, TypeId::INTEGER, TypeId::BIGINT, TypeId::INTEGER}, false);
+  CheckNormalizedOrder({TypeId::VARCHAR}, false);
+  CheckNormalizedOrder({TypeId::INTEGER, TypeId::VARCHAR, TypeId::INTEGER}, false);
+}
+
+}  // namespace bustub
@@ -0,0 +1,124 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// task_scheduler_test.cpp
+//
+// Identification: test/execution/task_scheduler_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "execution/task_scheduler.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(TaskSchedulerTest, ParallelFor) {
+  TaskScheduler scheduler{4};
+  ASSERT_EQ(5, scheduler.GetSlotCount());
+
+  const size_t num_tasks = 1000;
+  std::vector<int> visited(num_tasks, 0);
+  // Per-slot partial sums need no synchronization.
+  std::vector<uint64_t> partial_sums(scheduler.GetSlotCount(), 0);
+  scheduler.ParallelFor(num_tasks, [&](size_t task_idx, size_t slot) {
+    ASSERT_LT(slot, scheduler.GetSlotCount());
+    visited[task_idx]++;
+    partial_sums[slot] += task_idx;
+  });
+
+  uint64_t sum = 0;
+  for (auto partial_sum : partial_sums) {
+    sum += partial_sum;
+  }
+  EXPECT_EQ(num_tasks * (num_tasks - 1) / 2, sum);
+  for (auto count : visited) {
+    EXPECT_EQ(1, count);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(TaskSchedulerTest, NestedParallelFor) {
+  TaskScheduler scheduler{3};
+  std::atomic<size_t> count{0};
+  scheduler.ParallelFor(8, [&](size_t, size_t) { scheduler.ParallelFor(16, [&](size_t, size_t) { count++; }); });
+  EXPECT_EQ(8 * 16, count.load());
+
+  // A thread waiting for a nested loop does not start another task of the outer loop, which would share its slot.
+  std::vector<std::atomic<bool>> slot_in_use(scheduler.GetSlotCount());
+  std::atomic<size_t> shared_slots{0};
+  scheduler.ParallelFor(64, [&](size_t, size_t slot) {
+    if (slot_in_use[slot].exchange(true)) {
+      shared_slots++;
+    }
+    scheduler.ParallelFor(16, [&](size_t, size_t) { count++; });
+    slot_in_use[slot] = false;
+  });
+  EXPECT_EQ(0, shared_slots.load());
+
+  // A scheduler without workers runs everything on the calling thread.
+  TaskScheduler inline_scheduler{0};
+  count = 0;
+  inline_scheduler.ParallelFor(10, [&](size_t, size_t slot) {
+    EXPECT_EQ(0, slot);
+    count++;
+  });
+  EXPECT_EQ(10, count.load());
+}
+
+// NOLINTNEXTLINE
+TEST(TaskSchedulerTest, ConcurrentCallers) {
+  TaskScheduler scheduler{2};
+  // Threads outside of the pool share the last slot, so their loops must not overlap on it.
+  std::vector<std::atomic<bool>> slot_in_use(scheduler.GetSlotCount());
+  std::atomic<size_t> shared_slots{0};
+  std::atomic<size_t> count{0};
+  std::vector<std::thread> callers;
+  for (int i = 0; i < 4; i++) {
+    callers.emplace_back([&] {
+      for (int round = 0; round < 20; round++) {
+        scheduler.ParallelFor(32, [&](size_t, size_t slot) {
+          if (slot_in_use[slot].exchange(true)) {
+            shared_slots++;
+          }
+          count++;
+          std::this_thread::yield();
+          slot_in_use[slot] = false;
+        });
+      }
+    });
+  }
+  for (auto &caller : callers) {
+    caller.join();
+  }
+  EXPECT_EQ(0, shared_slots.load());
+  EXPECT_EQ(4 * 20 * 32, count.load());
+}
+
+// NOLINTNEXTLINE
+TEST(TaskSchedulerTest, Exception) {
+  TaskScheduler scheduler{2};
+  std::atomic<size_t> count{0};
+  auto task = [&](size_t task_idx, size_t) {
+    count++;
+    if (task_idx == 42) {
+      throw std::runtime_error("task failed");
+    }
+  };
+  EXPECT_THROW(scheduler.ParallelFor(100, task), std::runtime_error);
+  // The remaining tasks still ran, and the scheduler is still usable.
+  EXPECT_EQ(100, count.load());
+  count = 0;
+  scheduler.ParallelFor(10, [&](size_t, size_t) { count++; });
+  EXPECT_EQ(10, count.load());
+}
+
+}  // namespace bustub
@@ -0,0 +1,180 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// topn_executor_test.cpp
+//
+// Identification: test/execution/topn_executor_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/mock_scan_executor.h"
+#include "execution/executors/topn_check_executor.h"
+#include "execution/executors/topn_executor.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/mock_scan_plan.h"
+#include "execution/plans/topn_plan.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** Forward everything to a child executor, counting the tuples it produces */
+class CountingExecutor : public AbstractExecutor {
+ public:
+  CountingExecutor(ExecutorContext *exec_ctx, std::unique_ptr<AbstractExecutor> &&child, size_t *count)
+      : AbstractExecutor(exec_ctx), child_(std::move(child)), count_(count) {}
+
+  void Init() override { child_->Init(); }
+
+  auto Next(Tuple *tuple, RID *rid) -> bool override {
+    if (!child_->Next(tuple, rid)) {
+      return false;
+    }
+    (*count_)++;
+    return true;
+  }
+
+  auto PushDownRuntimeFilter(const RuntimeFilterRef &filter) -> bool override {
+    return child_->PushDownRuntimeFilter(filter);
+  }
+
+  auto GetOutputSchema() const -> const Schema & override { return child_->GetOutputSchema(); }
+
+ private:
+  std::unique_ptr<AbstractExecutor> child_;
+  size_t *count_;
+};
+
+/**
+ * Run a top-n over a mock table.
+ * @param[out] num_read the number of tuples the mock scan let through to the top-n
+ * @return the values of a column of the output tuples
+ */
+auto RunTopN(const std::string &table, const OrderBys &order_bys, size_t n, uint32_t column_idx, size_t *num_read)
+    -> std::vector<int32_t> {
+  ExecutorContext exec_ctx{nullptr, nullptr, nullptr, nullptr, nullptr, false};
+  auto schema = std::make_shared<Schema>(GetMockTableSchemaOf(table));
+  auto scan_plan = std::make_shared<MockScanPlanNode>(schema, table);
+  TopNPlanNode topn_plan{schema, scan_plan, order_bys, n};
+
+  *num_read = 0;
+  auto scan = std::make_unique<MockScanExecutor>(&exec_ctx, scan_plan.get());
+  TopNExecutor topn{&exec_ctx, &topn_plan, std::make_unique<CountingExecutor>(&exec_ctx, std::move(scan), num_read)};
+  topn.Init();
+  std::vector<int32_t> values;
+  Tuple tuple;
+  RID rid;
+  while (topn.Next(&tuple, &rid)) {
+    values.push_back(tuple.GetValue(schema.get(), column_idx).GetAs<int32_t>());
+  }
+  return values;
+}
+
+auto OrderBy(OrderByType type, uint32_t column_idx) -> OrderBys {
+  return {{type, std::make_shared<ColumnValueExpression>(0, column_idx, TypeId::INTEGER)}};
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(TopNExecutorTest, BoundaryFilterDropsTuples) {
+  // colA of __mock_table_1 counts up from 0: once the heap holds 0..4, no later tuple can get in.
+  size_t num_read;
+  ASSERT_EQ(RunTopN("__mock_table_1", OrderBy(OrderByType::ASC, 0), 5, 0, &num_read),
+            (std::vector<int32_t>{0, 1, 2, 3, 4}));
+  ASSERT_EQ(num_read, 5);
+
+  // In descending order, every tuple beats the boundary.
+  ASSERT_EQ(RunTopN("__mock_table_1", OrderBy(OrderByType::DESC, 0), 3, 0, &num_read),
+            (std::vector<int32_t>{99, 98, 97}));
+  ASSERT_EQ(num_read, 100);
+}
+
+// NOLINTNEXTLINE
+TEST(TopNExecutorTest, CheckExecutorForwardsFilter) {
+  // The executor factory puts a TopNCheckExecutor between the top-n and its child when the check is enabled.
+  ExecutorContext exec_ctx{nullptr, nullptr, nullptr, nullptr, nullptr, false};
+  auto schema = std::make_shared<Schema>(GetMockTableSchemaOf("__mock_table_1"));
+  auto scan_plan = std::make_shared<MockScanPlanNode>(schema, "__mock_table_1");
+  TopNPlanNode topn_plan{schema, scan_plan, OrderBy(OrderByType::ASC, 0), 5};
+  size_t num_read = 0;
+  auto scan = std::make_unique<CountingExecutor>(
+      &exec_ctx, std::make_unique<MockScanExecutor>(&exec_ctx, scan_plan.get()), &num_read);
+  TopNExecutor topn{&exec_ctx, &topn_plan, nullptr};
+  topn.SetChildExecutor(std::make_unique<TopNCheckExecutor>(&exec_ctx, &topn_plan, std::move(scan), &topn));
+  topn.Init();
+  Tuple tuple;
+  RID rid;
+  for (int32_t i = 0; i < 5; i++) {
+    ASSERT_TRUE(topn.Next(&tuple, &rid));
+    ASSERT_EQ(tuple.GetValue(schema.get(), 0).GetAs<int32_t>(), i);
+  }
+  ASSERT_FALSE(topn.Next(&tuple, &rid));
+  ASSERT_EQ(num_read, 5);
+}
+
+// NOLINTNEXTLINE
+TEST(TopNExecutorTest, Ties) {
+  // v4 of __mock_agg_input_small is cursor / 100 and v2 is the cursor: the top 150 on v4 are the first 100 tuples with
+  // v4 = 0 and the first 50 with v4 = 1, in input order. The tuples tying with the boundary are dropped.
+  size_t num_read;
+  auto values = RunTopN("__mock_agg_input_small", OrderBy(OrderByType::DEFAULT, 3), 150, 1, &num_read);
+  ASSERT_EQ(values.size(), 150);
+  for (int32_t i = 0; i < 150; i++) {
+    ASSERT_EQ(values[i], i);
+  }
+  ASSERT_EQ(num_read, 150);
+
+  // Ties are kept in input order in descending order as well.
+  values = RunTopN("__mock_agg_input_small", OrderBy(OrderByType::DESC, 3), 120, 1, &num_read);
+  ASSERT_EQ(values.size(), 120);
+  for (int32_t i = 0; i < 120; i++) {
+    ASSERT_EQ(values[i], i < 100 ? 900 + i : 800 + i - 100);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(TopNExecutorTest, SmallInputAndZeroN) {
+  // __mock_table_123 holds 1, 2 and 3.
+  size_t num_read;
+  ASSERT_EQ(RunTopN("__mock_table_123", OrderBy(OrderByType::DESC, 0), 10, 0, &num_read),
+            (std::vector<int32_t>{3, 2, 1}));
+  ASSERT_EQ(num_read, 3);
+
+  // A top 0 produces nothing, without reading its child.
+  ASSERT_TRUE(RunTopN("__mock_table_123", OrderBy(OrderByType::ASC, 0), 0, 0, &num_read).empty());
+  ASSERT_EQ(num_read, 0);
+}
+
+// NOLINTNEXTLINE
+TEST(TopNExecutorTest, BoundaryFilter) {
+  Schema schema{std::vector<Column>{{"a", TypeId::INTEGER}}};
+  auto order_bys = OrderBy(OrderByType::DESC, 0);
+  TopNBoundaryFilter filter{order_bys};
+  auto check = [&](int32_t value) {
+    return filter.Check(Tuple{{ValueFactory::GetIntegerValue(value)}, &schema}, schema);
+  };
+  // Everything passes until the heap is full.
+  ASSERT_TRUE(check(-100));
+
+  std::vector<Value> key{ValueFactory::GetIntegerValue(10)};
+  NormalizedSortKey normalized_key;
+  SortKeyNormalizer{order_bys}.Normalize(key, &normalized_key);
+  filter.SetBoundary(normalized_key, key);
+  ASSERT_TRUE(check(11));
+  ASSERT_FALSE(check(10));
+  ASSERT_FALSE(check(9));
+}
+
+}  // namespace bustub
@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// vector_kernels_test.cpp
+//
+// Identification: test/execution/vector_kernels_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "execution/vector_kernels.h"
+#include "gtest/gtest.h"
+#include "type/limits.h"
+
+namespace bustub {
+
+namespace {
+
+auto BitAt(const std::vector<uint64_t> &bitmap, size_t row) -> bool {
+  return ((bitmap[row / BITMAP_WORD_BITS] >> (row % BITMAP_WORD_BITS)) & 1) != 0;
+}
+
+/** Check a comparison kernel against the operator, row by row, with any operand scalar. */
+template <class T, class Op, bool LHS_SCALAR, bool RHS_SCALAR>
+void CheckCompare(const std::vector<T> &lhs, const std::vector<T> &rhs) {
+  Op op;
+  auto num_rows = lhs.size();
+  // Poison the bitmap: the bits past the last row must be cleared too.
+  std::vector<uint64_t> bitmap(BitmapWordCount(num_rows), ~static_cast<uint64_t>(0));
+  CompareKernel<T, Op, LHS_SCALAR, RHS_SCALAR>(lhs.data(), rhs.data(), num_rows, bitmap.data());
+  for (size_t i = 0; i < num_rows; i++) {
+    ASSERT_EQ(BitAt(bitmap, i), op(lhs[LHS_SCALAR ? 0 : i], rhs[RHS_SCALAR ? 0 : i])) << "row " << i;
+  }
+  ASSERT_EQ(bitmap.back() & ~BitmapLastWordMask(num_rows), 0);
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(VectorKernelsTest, CompareMatchesOperators) {
+  std::mt19937 rng{7};
+  // Sizes around the word boundaries.
+  for (size_t num_rows : {1, 2, 63, 64, 65, 128, 200}) {
+    std::vector<int32_t> a(num_rows);
+    std::vector<int32_t> b(num_rows);
+    std::vector<double> c(num_rows);
+    std::vector<double> d(num_rows);
+    std::vector<uint64_t> e(num_rows);
+    std::vector<uint64_t> f(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+      a[i] = static_cast<int32_t>(rng() % 7) - 3;
+      b[i] = static_cast<int32_t>(rng() % 7) - 3;
+      c[i] = static_cast<double>(a[i]) / 2;
+      d[i] = static_cast<double>(b[i]) / 2;
+      e[i] = rng() % 5;
+      f[i] = rng() % 5;
+    }
+    CheckCompare<int32_t, std::less<>, false, false>(a, b);
+    CheckCompare<int32_t, std::greater_equal<>, false, true>(a, b);
+    CheckCompare<int32_t, std::equal_to<>, true, false>(a, b);
+    CheckCompare<int32_t, std::not_equal_to<>, true, true>(a, b);
+    CheckCompare<double, std::less_equal<>, false, false>(c, d);
+    CheckCompare<double, std::greater<>, false, true>(c, d);
+    CheckCompare<uint64_t, std::less<>, false, true>(e, f);
+    CheckCompare<uint64_t, std::equal_to<>, false, false>(e, f);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(VectorKernelsTest, ArithmeticOverflow) {
+  constexpr int64_t max = std::numeric_limits<int64_t>::max();
+  constexpr int64_t min = std::numeric_limits<int64_t>::min();
+  std::vector<int64_t> lhs{1, max, -5, min + 1, 0};
+  std::vector<int64_t> rhs{2};
+  std::vector<int64_t> out(lhs.size());
+  std::vector<uint64_t> overflows(1);
+
+  ArithmeticKernel<int64_t, PlusOp, false, true>(lhs.data(), rhs.data(), lhs.size(), out.data());
+  ASSERT_EQ(out, (std::vector<int64_t>{3, min + 1, -3, min + 3, 2}));
+  OverflowKernel<int64_t, PlusOp, false, true>(lhs.data(), rhs.data(), out.data(), lhs.size(), overflows.data());
+  ASSERT_EQ(overflows[0], 0b00010);
+
+  ArithmeticKernel<int64_t, MinusOp, false, true>(lhs.data(), rhs.data(), lhs.size(), out.data());
+  OverflowKernel<int64_t, MinusOp, false, true>(lhs.data(), rhs.data(), out.data(), lhs.size(), overflows.data());
+  ASSERT_EQ(overflows[0], 0b01000);
+  ASSERT_EQ(out[2], -7);
+
+  // A scalar on the left side.
+  ArithmeticKernel<int64_t, MinusOp, true, false>(rhs.data(), lhs.data(), lhs.size(), out.data());
+  OverflowKernel<int64_t, MinusOp, true, false>(rhs.data(), lhs.data(), out.data(), lhs.size(), overflows.data());
+  ASSERT_EQ(out[0], 1);
+  ASSERT_EQ(out[2], 7);
+  ASSERT_EQ(overflows[0], 0b01000);
+}
+
+// NOLINTNEXTLINE
+TEST(VectorKernelsTest, EqualsBitmap) {
+  std::vector<int32_t> values(100, 1);
+  values[0] = BUSTUB_INT32_NULL;
+  values[64] = BUSTUB_INT32_NULL;
+  values[99] = BUSTUB_INT32_NULL;
+  std::vector<uint64_t> nulls(BitmapWordCount(values.size()));
+  EqualsBitmap(values.data(), BUSTUB_INT32_NULL, values.size(), nulls.data());
+  ASSERT_EQ(nulls[0], 1);
+  ASSERT_EQ(nulls[1], (static_cast<uint64_t>(1) << 35) | 1);
+  EqualsBitmap(values.data(), 2, values.size(), nulls.data());
+  ASSERT_EQ(nulls, (std::vector<uint64_t>{0, 0}));
+}
+
+}  // namespace bustub
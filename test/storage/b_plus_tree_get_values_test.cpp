@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_get_values_test.cpp
+//
+// Identification: test/storage/b_plus_tree_get_values_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/index/b_plus_tree.h"
+#include "test_util.h"  // NOLINT
+
+namespace bustub {
+
+using bustub::DiskManagerUnlimitedMemory;
+
+namespace {
+
+using Tree = BPlusTree<GenericKey<8>, RID, GenericComparator<8>>;
+
+/** Look up the keys with GetValues() in a tree holding the even keys in [2, max_key], and check the results. */
+void CheckGetValues(Tree *tree, const std::vector<int64_t> &keys, int64_t max_key) {
+  std::vector<GenericKey<8>> index_keys(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromInteger(keys[i]);
+  }
+  std::vector<std::vector<RID>> results;
+  tree->GetValues(index_keys, &results);
+  ASSERT_EQ(results.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    std::vector<RID> expected;
+    if (keys[i] >= 2 && keys[i] <= max_key && keys[i] % 2 == 0) {
+      expected.emplace_back(static_cast<int32_t>(keys[i] >> 32), static_cast<int32_t>(keys[i] & 0xFFFFFFFF));
+    }
+    ASSERT_EQ(results[i], expected) << "key " << keys[i];
+  }
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeTests, GetValuesTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(50, disk_manager.get());
+  page_id_t page_id;
+  auto *header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+  // Small pages, so that the tree is several levels deep and a batch crosses many subtrees.
+  Tree tree("foo_pk", page_id, bpm.get(), comparator, 3, 3);
+
+  // An empty tree has no values for any key.
+  CheckGetValues(&tree, {1, 2, 3}, 0);
+
+  // The even keys in [2, 1000], inserted in random order.
+  std::vector<int64_t> keys;
+  for (int64_t key = 2; key <= 1000; key += 2) {
+    keys.push_back(key);
+  }
+  std::shuffle(keys.begin(), keys.end(), std::default_random_engine{});
+  GenericKey<8> index_key;
+  RID rid;
+  for (auto key : keys) {
+    rid.Set(static_cast<int32_t>(key >> 32), static_cast<int32_t>(key & 0xFFFFFFFF));
+    index_key.SetFromInteger(key);
+    ASSERT_TRUE(tree.Insert(index_key, rid));
+  }
+
+  // Every key from below the first to past the last, half of which are missing.
+  std::vector<int64_t> dense;
+  for (int64_t key = -5; key <= 1010; key++) {
+    dense.push_back(key);
+  }
+  CheckGetValues(&tree, dense, 1000);
+
+  // Sparse keys, each in a different subtree than the one before, with duplicates and keys past the end.
+  CheckGetValues(&tree, {2, 2, 3, 64, 65, 66, 128, 500, 500, 501, 502, 998, 1000, 1000, 1002, 5000}, 1000);
+
+  // The last key of each leaf followed by a key in the next one climbs past the last child slots.
+  std::vector<int64_t> sparse;
+  for (int64_t key = 1000; key >= 2; key -= 37) {
+    sparse.push_back(key);
+  }
+  std::sort(sparse.begin(), sparse.end());
+  CheckGetValues(&tree, sparse, 1000);
+
+  // A single key.
+  CheckGetValues(&tree, {424}, 1000);
+}
+
+}  // namespace bustub
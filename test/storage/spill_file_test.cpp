@@ -0,0 +1,88 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// spill_file_test.cpp
+//
+// Identification: test/storage/spill_file_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/table/spill_file.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(SpillFileTest, AppendAndRead) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  // Far fewer frames than pages in the file: only the pages being written and read are pinned.
+  auto bpm = std::make_unique<BufferPoolManager>(4, disk_manager.get());
+  Schema schema{std::vector<Column>{{"a", TypeId::INTEGER}, {"b", TypeId::VARCHAR, 64}}};
+
+  const int num_tuples = 10000;
+  {
+    SpillFile file{bpm.get()};
+    for (int i = 0; i < num_tuples; i++) {
+      file.Append(Tuple{{ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::to_string(i))}, &schema});
+    }
+    file.Finish();
+    ASSERT_EQ(num_tuples, file.Size());
+    ASSERT_GT(file.GetPageCount(), 4);
+
+    // Two readers can scan the file at the same time, in append order.
+    auto reader = file.MakeReader();
+    auto other_reader = file.MakeReader();
+    Tuple tuple;
+    for (int i = 0; i < num_tuples; i++) {
+      ASSERT_TRUE(reader.Next(&tuple));
+      ASSERT_EQ(i, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+      ASSERT_EQ(std::to_string(i), tuple.GetValue(&schema, 1).ToString());
+      ASSERT_TRUE(other_reader.Next(&tuple));
+    }
+    ASSERT_FALSE(reader.Next(&tuple));
+  }
+
+  // The pages of the file were deleted, all the frames are free again.
+  page_id_t page_id;
+  for (int i = 0; i < 4; i++) {
+    ASSERT_NE(nullptr, bpm->NewPage(&page_id));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(SpillFileTest, LargeTuples) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(4, disk_manager.get());
+  Schema schema{std::vector<Column>{{"a", TypeId::INTEGER}, {"b", TypeId::VARCHAR, 64}}};
+
+  // Tuples larger than a page, some spanning several pages, between small ones.
+  auto make_string = [](int i) { return std::string(i % 3 == 0 ? i * 1000 : i, static_cast<char>('a' + i % 26)); };
+  const int num_tuples = 30;
+  SpillFile file{bpm.get()};
+  for (int i = 0; i < num_tuples; i++) {
+    file.Append(Tuple{{ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(make_string(i))}, &schema});
+  }
+  file.Finish();
+  ASSERT_EQ(num_tuples, file.Size());
+
+  auto reader = file.MakeReader();
+  Tuple tuple;
+  for (int i = 0; i < num_tuples; i++) {
+    ASSERT_TRUE(reader.Next(&tuple));
+    ASSERT_EQ(i, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+    ASSERT_EQ(make_string(i), tuple.GetValue(&schema, 1).ToString());
+  }
+  ASSERT_FALSE(reader.Next(&tuple));
+}
+
+}  // namespace bustub
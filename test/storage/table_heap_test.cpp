@@ -0,0 +1,270 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_heap_test.cpp
+//
+// Identification: test/storage/table_heap_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/page/free_space_map_page.h"
+#include "storage/table/table_heap.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, Morsels) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(16, disk_manager.get());
+  TableHeap table{bpm.get()};
+  Schema schema{std::vector<Column>{{"a", TypeId::INTEGER}, {"b", TypeId::VARCHAR, 128}}};
+  const TupleMeta live_meta{INVALID_TXN_ID, INVALID_TXN_ID, false};
+  // Scan the morsels one after the other, returning how many tuples each of them has.
+  auto scan = [&](size_t pages_per_morsel) {
+    std::vector<int> counts;
+    int expected = 0;
+    for (const auto &morsel : table.MakeMorsels(pages_per_morsel)) {
+      counts.push_back(0);
+      for (auto iter = table.MakeMorselIterator(morsel); !iter.IsEnd(); ++iter) {
+        EXPECT_EQ(iter.GetTuple().second.GetValue(&schema, 0).GetAs<int32_t>(), expected++);
+        counts.back()++;
+      }
+    }
+    return counts;
+  };
+
+  // An empty table has no morsel.
+  ASSERT_TRUE(scan(2).empty());
+
+  // About 30 tuples per page.
+  const int num_tuples = 300;
+  for (int i = 0; i < num_tuples; i++) {
+    table.InsertTuple(live_meta,
+                      Tuple{{ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::string(100, 'x'))},
+                            &schema});
+  }
+  std::set<page_id_t> page_ids;
+  for (auto iter = table.MakeIterator(); !iter.IsEnd(); ++iter) {
+    page_ids.insert(iter.GetRID().GetPageId());
+  }
+  const auto num_pages = page_ids.size();
+  ASSERT_GT(num_pages, 5);
+
+  // The morsels cover the table in order, each of them but the last one with as many pages as asked for.
+  for (size_t pages_per_morsel : {static_cast<size_t>(1), static_cast<size_t>(3), num_pages, num_pages + 1}) {
+    auto counts = scan(pages_per_morsel);
+    ASSERT_EQ(counts.size(), (num_pages + pages_per_morsel - 1) / pages_per_morsel);
+    int total = 0;
+    for (auto count : counts) {
+      ASSERT_GT(count, 0);
+      total += count;
+    }
+    ASSERT_EQ(total, num_tuples);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, TupleRefs) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(16, disk_manager.get());
+  TableHeap table{bpm.get()};
+  Schema schema{std::vector<Column>{{"a", TypeId::INTEGER}, {"b", TypeId::VARCHAR, 128}}};
+  const TupleMeta live_meta{INVALID_TXN_ID, INVALID_TXN_ID, false};
+  const int num_tuples = 300;
+  std::vector<RID> rids;
+  for (int i = 0; i < num_tuples; i++) {
+    rids.push_back(*table.InsertTuple(
+        live_meta,
+        Tuple{{ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::string(100, 'a' + i % 26))},
+              &schema}));
+  }
+  for (int i = 0; i < num_tuples; i += 3) {
+    table.UpdateTupleMeta({INVALID_TXN_ID, INVALID_TXN_ID, true}, rids[i]);
+  }
+
+  // Read the live tuples in place, a few at a time: every read stays within a page, which it keeps pinned.
+  auto iter = table.MakeIterator();
+  std::vector<TupleRef> tuples;
+  int expected = 0;
+  while (!iter.IsEnd()) {
+    iter.ReadTupleRefs(7, &tuples);
+    ASSERT_LE(tuples.size(), 7);
+    if (tuples.empty()) {
+      continue;
+    }
+    auto page_id = tuples[0].GetRid().GetPageId();
+    auto *page = bpm->FetchPage(page_id);
+    ASSERT_EQ(page->GetPinCount(), 2);
+    for (const auto &tuple : tuples) {
+      if (expected % 3 == 0) {
+        expected++;
+      }
+      ASSERT_EQ(tuple.GetRid().GetPageId(), page_id);
+      ASSERT_EQ(tuple.GetValueView(&schema, 0).GetAs<int32_t>(), expected);
+      auto copy = tuple.ToTuple();
+      ASSERT_EQ(copy.GetRid(), tuple.GetRid());
+      ASSERT_EQ(copy.GetValue(&schema, 1).ToString(), std::string(100, 'a' + expected % 26));
+      expected++;
+    }
+    iter.ReleasePage();
+    ASSERT_EQ(page->GetPinCount(), 1);
+    bpm->UnpinPage(page_id, false);
+  }
+  ASSERT_EQ(expected, num_tuples);
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, ReclaimDeletedSpace) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(16, disk_manager.get());
+  TableHeap table{bpm.get()};
+  Schema schema{std::vector<Column>{{"a", TypeId::INTEGER}, {"b", TypeId::VARCHAR, 128}}};
+  const TupleMeta live_meta{INVALID_TXN_ID, INVALID_TXN_ID, false};
+  auto make_tuple = [&](int i) {
+    return Tuple{{ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::string(100, 'a' + i % 26))},
+                 &schema};
+  };
+  auto count_pages = [&]() {
+    std::set<page_id_t> page_ids;
+    for (auto iter = table.MakeIterator(); !iter.IsEnd(); ++iter) {
+      page_ids.insert(iter.GetRID().GetPageId());
+    }
+    return page_ids.size();
+  };
+
+  const int num_tuples = 300;
+  std::vector<RID> rids;
+  for (int i = 0; i < num_tuples; i++) {
+    rids.push_back(*table.InsertTuple(live_meta, make_tuple(i)));
+  }
+  const auto num_pages = count_pages();
+
+  // Delete every other tuple, but leave the deletion of tuple 1 pending: its space must not be reclaimed.
+  for (int i = 1; i < num_tuples; i += 2) {
+    table.UpdateTupleMeta({INVALID_TXN_ID, i == 1 ? 5 : INVALID_TXN_ID, true}, rids[i]);
+  }
+
+  // The new tuples fill the space of the deleted ones, reusing most of their slots, without any new page.
+  int num_reused = 0;
+  for (int i = num_tuples; i < num_tuples + num_tuples / 2 - 1; i++) {
+    auto rid = *table.InsertTuple(live_meta, make_tuple(i));
+    ASSERT_FALSE(rid == rids[1]);
+    num_reused += std::find(rids.begin(), rids.end(), rid) != rids.end() ? 1 : 0;
+    ASSERT_EQ(table.GetTuple(rid).second.GetValue(&schema, 0).GetAs<int32_t>(), i);
+  }
+  ASSERT_EQ(count_pages(), num_pages);
+  ASSERT_GT(num_reused, num_tuples / 4);
+
+  // The tuples left in place keep their RIDs through the compactions.
+  for (int i = 0; i < num_tuples; i += 2) {
+    auto [meta, tuple] = table.GetTuple(rids[i]);
+    ASSERT_FALSE(meta.is_deleted_);
+    ASSERT_EQ(tuple.GetValue(&schema, 0).GetAs<int32_t>(), i);
+    ASSERT_EQ(tuple.GetValue(&schema, 1).ToString(), std::string(100, 'a' + i % 26));
+  }
+  auto [pending_meta, pending_tuple] = table.GetTuple(rids[1]);
+  ASSERT_TRUE(pending_meta.is_deleted_);
+  ASSERT_EQ(pending_tuple.GetValue(&schema, 0).GetAs<int32_t>(), 1);
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, FreeSpaceMapPage) {
+  std::vector<char> data(BUSTUB_PAGE_SIZE);
+  auto *page = reinterpret_cast<FreeSpaceMapPage *>(data.data());
+  page->Init();
+  ASSERT_EQ(page->FindEntry(1, 0), std::nullopt);
+  for (page_id_t page_id = 0; page_id < 4; page_id++) {
+    ASSERT_EQ(page->AddEntry(page_id + 10, 100), page_id);
+  }
+  // Free space is rounded down to a fill level.
+  ASSERT_EQ(page->GetFreeSpace(0), 100 / FreeSpaceMapPage::FREE_SPACE_UNIT * FreeSpaceMapPage::FREE_SPACE_UNIT);
+  ASSERT_EQ(page->FindEntry(page->GetFreeSpace(0) + 1, 0), std::nullopt);
+  page->SetFreeSpace(1, 1000);
+  page->SetFreeSpace(3, 2000);
+  ASSERT_EQ(page->FindEntry(500, 0), 1);
+  ASSERT_EQ(page->FindEntry(500, 2), 3);
+  // The search wraps around from its start.
+  ASSERT_EQ(page->FindEntry(1500, 5), 3);
+  ASSERT_EQ(page->FindEntry(500, 4), 1);
+  ASSERT_EQ(page->GetPageId(3), 13);
+  ASSERT_EQ(page->FindEntry(BUSTUB_PAGE_SIZE * 2, 0), std::nullopt);
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, ConcurrentInserts) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager.get());
+  TableHeap table{bpm.get()};
+  Schema schema{std::vector<Column>{{"a", TypeId::INTEGER}, {"b", TypeId::VARCHAR, 128}}};
+  const TupleMeta live_meta{INVALID_TXN_ID, INVALID_TXN_ID, false};
+  const int num_threads = 4;
+  const int tuples_per_thread = 500;
+  auto insert = [&](int begin, int end) {
+    for (int i = begin; i < end; i++) {
+      table.InsertTuple(live_meta, Tuple{{ValueFactory::GetIntegerValue(i),
+                                          ValueFactory::GetVarcharValue(std::string(20 + i % 80, 'x'))},
+                                         &schema});
+    }
+  };
+  auto scan = [&]() {
+    std::vector<int> values;
+    std::set<page_id_t> page_ids;
+    for (auto iter = table.MakeIterator(); !iter.IsEnd(); ++iter) {
+      auto [meta, tuple] = iter.GetTuple();
+      if (!meta.is_deleted_) {
+        values.push_back(tuple.GetValue(&schema, 0).GetAs<int32_t>());
+        page_ids.insert(iter.GetRID().GetPageId());
+      }
+    }
+    std::sort(values.begin(), values.end());
+    return std::make_pair(values, page_ids.size());
+  };
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back(insert, t * tuples_per_thread, (t + 1) * tuples_per_thread);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto [values, num_pages] = scan();
+  ASSERT_EQ(values.size(), num_threads * tuples_per_thread);
+  for (int i = 0; i < num_threads * tuples_per_thread; i++) {
+    ASSERT_EQ(values[i], i);
+  }
+
+  // Delete half of the tuples: concurrent inserts of as many tuples find room in the existing pages.
+  int i = 0;
+  for (auto iter = table.MakeIterator(); !iter.IsEnd(); ++iter) {
+    if (i++ % 2 == 0) {
+      table.UpdateTupleMeta({INVALID_TXN_ID, INVALID_TXN_ID, true}, iter.GetRID());
+    }
+  }
+  threads.clear();
+  const int base = num_threads * tuples_per_thread;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back(insert, base + t * tuples_per_thread / 4, base + (t + 1) * tuples_per_thread / 4);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto [new_values, new_num_pages] = scan();
+  ASSERT_EQ(new_values.size(), num_threads * tuples_per_thread / 2 + num_threads * tuples_per_thread / 4);
+  ASSERT_EQ(new_num_pages, num_pages);
+}
+
+}  // namespace bustub
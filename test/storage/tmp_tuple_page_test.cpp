@@ -13,22 +13,24 @@
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "storage/page/page.h"
 #include "storage/page/tmp_tuple_page.h"
 #include "type/value_factory.h"
 
 namespace bustub {
 
 // NOLINTNEXTLINE
-TEST(TmpTuplePageTest, DISABLED_BasicTest) {
+TEST(TmpTuplePageTest, BasicTest) {
   // There are many ways to do this assignment, and this is only one of them.
   // If you don't like the TmpTuplePage idea, please feel free to delete this test case entirely.
   // You will get full credit as long as you are correctly using a linear probe hash table.
 
-  TmpTuplePage page{};
+  Page frame;
+  auto *page = reinterpret_cast<TmpTuplePage *>(frame.GetData());
   page_id_t page_id = 15445;
-  page.Init(page_id, BUSTUB_PAGE_SIZE);
+  page->Init(page_id, BUSTUB_PAGE_SIZE);
 
-  char *data = page.GetData();
+  char *data = frame.GetData();
   ASSERT_EQ(*reinterpret_cast<page_id_t *>(data), page_id);
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + sizeof(page_id_t) + sizeof(lsn_t)), BUSTUB_PAGE_SIZE);
 
@@ -41,11 +43,27 @@ TEST(TmpTuplePageTest, DISABLED_BasicTest) {
 
   Tuple tuple(values, &schema);
   TmpTuple tmp_tuple(INVALID_PAGE_ID, 0);
-  page.Insert(tuple, &tmp_tuple);
+  page->Insert(tuple, &tmp_tuple);
 
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + sizeof(page_id_t) + sizeof(lsn_t)), BUSTUB_PAGE_SIZE - 8);
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + BUSTUB_PAGE_SIZE - 8), 4);
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + BUSTUB_PAGE_SIZE - 4), 123);
+  ASSERT_EQ(page_id, tmp_tuple.GetPageId());
+  ASSERT_EQ(BUSTUB_PAGE_SIZE - 8, tmp_tuple.GetOffset());
+
+  // Fill the page, then read the records back from the free space offset, newest first.
+  int num_tuples = 1;
+  while (page->Insert(Tuple{{ValueFactory::GetIntegerValue(num_tuples)}, &schema}, &tmp_tuple)) {
+    num_tuples++;
+  }
+  ASSERT_EQ((BUSTUB_PAGE_SIZE - TmpTuplePage::SIZE_TMP_TUPLE_PAGE_HEADER) / 8, num_tuples);
+  size_t offset = page->GetFreeSpaceOffset();
+  for (int i = num_tuples - 1; i >= 0; i--) {
+    Tuple read_tuple;
+    offset = page->Get(offset, &read_tuple);
+    ASSERT_EQ(i == 0 ? 123 : i, read_tuple.GetValue(&schema, 0).GetAs<int32_t>());
+  }
+  ASSERT_EQ(BUSTUB_PAGE_SIZE, offset);
 }
 
 }  // namespace bustub
@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// data_chunk_test.cpp
+//
+// Identification: test/table/data_chunk_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/page/page.h"
+#include "storage/page/table_page.h"
+#include "storage/table/data_chunk.h"
+#include "storage/table/tuple.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(DataChunkTest, DecodeTuples) {
+  Schema schema{std::vector<Column>{{"a", TypeId::INTEGER},
+                                    {"b", TypeId::VARCHAR, 32},
+                                    {"c", TypeId::BIGINT},
+                                    {"d", TypeId::DECIMAL},
+                                    {"e", TypeId::BOOLEAN}}};
+  DataChunk chunk{&schema, 16};
+
+  for (int i = 0; i < 10; i++) {
+    std::vector<Value> values{
+        i % 3 == 0 ? ValueFactory::GetNullValueByType(TypeId::INTEGER) : ValueFactory::GetIntegerValue(i),
+        ValueFactory::GetVarcharValue("row-" + std::to_string(i)), ValueFactory::GetBigIntValue(i * 1000000000LL),
+        ValueFactory::GetDecimalValue(i / 2.0), ValueFactory::GetBooleanValue(i % 2 == 0)};
+    chunk.AppendTuple(Tuple{values, &schema});
+  }
+  ASSERT_EQ(10, chunk.Size());
+
+  const auto *ints = chunk.GetColumn(0).GetData<int32_t>();
+  const auto *bigints = chunk.GetColumn(2).GetData<int64_t>();
+  const auto *decimals = chunk.GetColumn(3).GetData<double>();
+  const auto *bools = chunk.GetColumn(4).GetData<int8_t>();
+  EXPECT_TRUE(chunk.GetColumn(0).HasNull());
+  EXPECT_FALSE(chunk.GetColumn(2).HasNull());
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(i % 3 == 0, chunk.GetColumn(0).IsNull(i));
+    if (i % 3 != 0) {
+      EXPECT_EQ(i, ints[i]);
+    }
+    EXPECT_EQ("row-" + std::to_string(i), chunk.GetColumn(1).GetString(i));
+    EXPECT_EQ(i * 1000000000LL, bigints[i]);
+    EXPECT_DOUBLE_EQ(i / 2.0, decimals[i]);
+    EXPECT_EQ(i % 2 == 0, bools[i] != 0);
+  }
+
+  // Rows materialize back into identical tuples.
+  auto tuple = chunk.GetTuple(4);
+  EXPECT_EQ(4, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+  EXPECT_EQ("row-4", tuple.GetValue(&schema, 1).ToString());
+  EXPECT_TRUE(chunk.GetTuple(3).GetValue(&schema, 0).IsNull());
+
+  chunk.SetSelection({1, 4, 7});
+  ASSERT_EQ(3, chunk.GetSelectedCount());
+  EXPECT_EQ(7, chunk.GetSelectedRow(2));
+  chunk.ClearSelection();
+  EXPECT_EQ(10, chunk.GetSelectedCount());
+
+  chunk.Reset();
+  EXPECT_EQ(0, chunk.Size());
+  EXPECT_FALSE(chunk.GetColumn(0).HasNull());
+}
+
+// NOLINTNEXTLINE
+TEST(DataChunkTest, LoadTablePage) {
+  Schema schema{std::vector<Column>{{"a", TypeId::INTEGER}, {"b", TypeId::VARCHAR, 16}}};
+  Page raw_page;
+  auto *page = reinterpret_cast<TablePage *>(raw_page.GetData());
+  page->Init();
+
+  for (int i = 0; i < 20; i++) {
+    std::vector<Value> values{ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::to_string(i))};
+    ASSERT_TRUE(page->InsertTuple(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, false}, Tuple{values, &schema}));
+  }
+  // Deleted tuples are skipped.
+  page->UpdateTupleMeta(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, true}, RID{0, 5});
+
+  DataChunk chunk{&schema, 8};
+  auto slot = chunk.AppendTablePage(*page, 0, 0);
+  EXPECT_EQ(9, slot);
+  ASSERT_EQ(8, chunk.Size());
+  EXPECT_EQ(6, chunk.GetColumn(0).GetData<int32_t>()[5]);
+  EXPECT_EQ((RID{0, 6}), chunk.GetRID(5));
+
+  chunk.Reset();
+  slot = chunk.AppendTablePage(*page, 0, slot);
+  EXPECT_EQ(17, slot);
+  chunk.Reset();
+  slot = chunk.AppendTablePage(*page, 0, slot);
+  EXPECT_EQ(20, slot);
+  ASSERT_EQ(3, chunk.Size());
+  EXPECT_EQ("19", chunk.GetColumn(1).GetString(2));
+}
+
+}  // namespace bustub
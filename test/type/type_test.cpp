@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
@@ -95,4 +96,53 @@ TEST(TypeTests, TemplateTest) {
   BPlusTreePage<Value, Value> node;
   node.GetInfo(val1, val2);
 }
+
+// NOLINTNEXTLINE
+TEST(TypeTests, VarcharStorageTest) {
+  const std::string short_str = "short";
+  const std::string long_str(100, 'x');
+  for (const auto &str : {short_str, long_str}) {
+    Value owned(TypeId::VARCHAR, str);
+    EXPECT_EQ(owned.ToString(), str);
+    // A short string is stored inside the value.
+    bool is_inline = owned.GetData() >= reinterpret_cast<const char *>(&owned) &&
+                     owned.GetData() < reinterpret_cast<const char *>(&owned + 1);
+    EXPECT_EQ(is_inline, str.size() < Value::INLINE_VARLEN_SIZE);
+
+    // Values round-trip through storage, and a view borrows the storage bytes.
+    std::vector<char> storage(sizeof(uint32_t) + owned.GetLength());
+    owned.SerializeTo(storage.data());
+    Value view = Value::DeserializeViewFrom(storage.data(), TypeId::VARCHAR);
+    EXPECT_EQ(view.GetData(), storage.data() + sizeof(uint32_t));
+    EXPECT_EQ(view.CompareEquals(owned), CmpBool::CmpTrue);
+    Value deserialized = Value::DeserializeFrom(storage.data(), TypeId::VARCHAR);
+    EXPECT_EQ(deserialized.CompareEquals(owned), CmpBool::CmpTrue);
+
+    // Copies and moves of a view own their data, and survive the storage.
+    Value copy = view;
+    std::vector<Value> values;
+    values.push_back(view);
+    values.emplace_back(Value::DeserializeViewFrom(storage.data(), TypeId::VARCHAR));
+    Value assigned;
+    assigned = owned.View();
+    std::fill(storage.begin(), storage.end(), '\0');
+    storage.clear();
+    storage.shrink_to_fit();
+    for (const auto &value : {copy, values[0], values[1], assigned}) {
+      EXPECT_EQ(value.ToString(), str);
+    }
+
+    // A move steals or copies the data, the moved-from value stays valid.
+    Value moved = std::move(copy);
+    EXPECT_EQ(moved.ToString(), str);
+    copy = moved;
+    EXPECT_EQ(copy.CompareEquals(moved), CmpBool::CmpTrue);
+  }
+
+  uint32_t null_len = BUSTUB_VALUE_NULL;
+  Value null_view = Value::DeserializeViewFrom(reinterpret_cast<const char *>(&null_len), TypeId::VARCHAR);
+  EXPECT_TRUE(null_view.IsNull());
+  Value null_copy = null_view;
+  EXPECT_TRUE(null_copy.IsNull());
+}
 }  // namespace bustub
@@ -105,6 +105,26 @@ auto ProcessExtraOptions(const std::string &sql, bustub::BustubInstance &instanc
           return false;
         }
         check_options->check_options_set_.emplace(bustub::CheckOption::ENABLE_TOPN_CHECK);
+      } else if (opt == "ensure:streaming_agg") {
+        if (!bustub::StringUtil::Contains(result.str(), "StreamingAgg")) {
+          fmt::print("StreamingAgg not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:no_streaming_agg") {
+        if (bustub::StringUtil::Contains(result.str(), "StreamingAgg")) {
+          fmt::print("StreamingAgg should not appear\n");
+          return false;
+        }
+      } else if (opt == "ensure:merge_join") {
+        if (!bustub::StringUtil::Contains(result.str(), "MergeJoin")) {
+          fmt::print("MergeJoin not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:no_merge_join") {
+        if (bustub::StringUtil::Contains(result.str(), "MergeJoin")) {
+          fmt::print("MergeJoin should not appear\n");
+          return false;
+        }
       } else if (opt == "ensure:index_join") {
         if (!bustub::StringUtil::Contains(result.str(), "NestedIndexJoin")) {
           fmt::print("NestedIndexJoin not found\n");